@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "ActionSequencer.h"
+
+bool ActionSequencer::Remember(Seat& seat, uint64_t key)
+{
+	if (!seat.seenKeys.insert(key).second) return false;
+	seat.keyOrder.push_back(key);
+	if (seat.keyOrder.size() > KEY_HISTORY)
+	{
+		seat.seenKeys.erase(seat.keyOrder.front());
+		seat.keyOrder.pop_front();
+	}
+	return true;
+}
+
+ActionSequencer::Verdict ActionSequencer::Submit(const AdminCommand& cmd)
+{
+	const bool scoreOp = cmd.kind == AdminOpKind::ScoreDelta || cmd.kind == AdminOpKind::ScoreSet;
+	if (scoreOp && cmd.team > 1) return Verdict::Invalid;
+	Seat& seat = seats_[cmd.seat];
+	if (!Remember(seat, cmd.key)) return Verdict::Duplicate;
+	if (scoreOp)
+	{
+		// Anything this seat issued before its own absolute set for that team has been overwritten.
+		std::optional<uint32_t>& lastSet = seat.lastSetSeq[cmd.team];
+		if (lastSet && cmd.seq <= *lastSet) return Verdict::Stale;
+		if (cmd.kind == AdminOpKind::ScoreSet) lastSet = cmd.seq;
+	}
+	batch_.push_back(cmd);
+	return Verdict::Accepted;
+}
+
+ResolvedActions ActionSequencer::Resolve()
+{
+	ResolvedActions out;
+	if (batch_.empty()) return out;
+
+	for (int team = 0; team < 2; ++team)
+	{
+		// The last set to arrive wins; deltas that arrived before it are overwritten.
+		size_t from = 0;
+		for (size_t i = 0; i < batch_.size(); ++i)
+		{
+			const AdminCommand& c = batch_[i];
+			if (c.kind == AdminOpKind::ScoreSet && c.team == team)
+			{
+				out.setScore[team] = c.value;
+				from = i + 1;
+			}
+		}
+		for (size_t i = from; i < batch_.size(); ++i)
+		{
+			const AdminCommand& c = batch_[i];
+			if (c.kind == AdminOpKind::ScoreDelta && c.team == team)
+				out.scoreDelta[team] += c.value;
+		}
+	}
+
+	for (const AdminCommand& c : batch_)
+	{
+		if (c.kind == AdminOpKind::PauseToggle) out.pauseToggle = true;
+		if (c.kind == AdminOpKind::ResetKickoff) out.resetKickoff = true;
+	}
+
+	batch_.clear();
+	return out;
+}
+
+void ActionSequencer::Reset()
+{
+	batch_.clear();
+	seats_.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum class AdminOpKind : uint8_t
+{
+	ScoreDelta,
+	ScoreSet,
+	PauseToggle,
+	ResetKickoff,
+};
+
+struct AdminCommand
+{
+	uint8_t seat = 0;
+	uint32_t seq = 0;
+	uint64_t key = 0;
+	AdminOpKind kind = AdminOpKind::ScoreDelta;
+	uint8_t team = 0;
+	int32_t value = 0;
+};
+
+// Net effect of one tick's worth of sequenced commands.
+struct ResolvedActions
+{
+	std::optional<int> setScore[2];
+	int scoreDelta[2] = { 0, 0 };
+	bool pauseToggle = false;
+	bool resetKickoff = false;
+
+	bool Empty() const
+	{
+		return !setScore[0] && !setScore[1] && scoreDelta[0] == 0 && scoreDelta[1] == 0 && !pauseToggle && !resetKickoff;
+	}
+};
+
+// Orders commands from several admin seats. Retries are dropped by
+// idempotency key, remembered per seat. Seats' seq counters are independent,
+// so they are only compared within a seat: a score command is stale once the
+// same seat has sent an absolute set for that team with an equal or higher
+// seq. Across seats, arrival order decides. Commands that arrive in the same
+// tick are resolved together: the absolute score set that arrived last wins
+// (last writer wins), deltas that arrived after it are summed (commutative),
+// and repeated pause/reset requests collapse into one.
+class ActionSequencer
+{
+public:
+	enum class Verdict
+	{
+		Accepted,
+		Duplicate,
+		Stale,
+		Invalid,
+	};
+
+	Verdict Submit(const AdminCommand& cmd);
+	ResolvedActions Resolve();
+	void Reset();
+
+private:
+	struct Seat
+	{
+		std::unordered_set<uint64_t> seenKeys;
+		std::deque<uint64_t> keyOrder;
+		std::optional<uint32_t> lastSetSeq[2];	// Highest accepted absolute set per team
+	};
+
+	bool Remember(Seat& seat, uint64_t key);
+
+	static constexpr size_t KEY_HISTORY = 4096;	// Per seat
+
+	std::vector<AdminCommand> batch_;	// Arrival order
+	std::unordered_map<uint8_t, Seat> seats_;
+};
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include "ConfigWatcher.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+ConfigWatcher::~ConfigWatcher()
+{
+	Stop();
+}
+
+bool ConfigWatcher::Start(const std::filesystem::path& file, std::chrono::milliseconds debounce)
+{
+	Stop();
+	file_ = file;
+	debounce_ = debounce;
+	stamp_ = StatFile();
+	pending_ = false;
+	lastPoll_ = Clock::now();
+	mode_ = Mode::Poll;
+
+	// Watch the directory rather than the file so atomic replace-by-rename is seen.
+	const std::filesystem::path dir = file_.parent_path();
+#ifdef _WIN32
+	HANDLE h = FindFirstChangeNotificationW(dir.wstring().c_str(), FALSE,
+		FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+	if (h != INVALID_HANDLE_VALUE)
+	{
+		change_ = h;
+		mode_ = Mode::Win32;
+	}
+#else
+	fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd_ >= 0 && inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE) >= 0)
+	{
+		mode_ = Mode::Inotify;
+	}
+	else if (fd_ >= 0)
+	{
+		close(fd_);
+		fd_ = -1;
+	}
+#endif
+	running_ = true;
+	return true;
+}
+
+void ConfigWatcher::Stop()
+{
+#ifdef _WIN32
+	if (change_)
+	{
+		FindCloseChangeNotification(static_cast<HANDLE>(change_));
+		change_ = nullptr;
+	}
+#else
+	if (fd_ >= 0)
+	{
+		close(fd_);
+		fd_ = -1;
+	}
+#endif
+	running_ = false;
+	pending_ = false;
+}
+
+const char* ConfigWatcher::Backend() const
+{
+	switch (mode_)
+	{
+	case Mode::Inotify: return "inotify";
+	case Mode::Win32: return "win32";
+	default: return "poll";
+	}
+}
+
+ConfigWatcher::Stamp ConfigWatcher::StatFile() const
+{
+	Stamp s;
+	std::error_code ec;
+	s.mtime = std::filesystem::last_write_time(file_, ec);
+	if (ec) return s;
+	s.size = std::filesystem::file_size(file_, ec);
+	s.exists = !ec;
+	return s;
+}
+
+bool ConfigWatcher::Signalled(Clock::time_point now)
+{
+	switch (mode_)
+	{
+#ifdef _WIN32
+	case Mode::Win32:
+	{
+		HANDLE h = static_cast<HANDLE>(change_);
+		if (WaitForSingleObject(h, 0) != WAIT_OBJECT_0) return false;
+		FindNextChangeNotification(h);
+		// Directory-level only; the stamp comparison filters out sibling files.
+		return true;
+	}
+#else
+	case Mode::Inotify:
+	{
+		alignas(inotify_event) char buf[4096];
+		const std::string name = file_.filename().string();
+		bool hit = false;
+		for (;;)
+		{
+			const ssize_t n = read(fd_, buf, sizeof(buf));
+			if (n <= 0) break;
+			for (ssize_t off = 0; off < n;)
+			{
+				const inotify_event* ev = reinterpret_cast<const inotify_event*>(buf + off);
+				if (ev->len > 0 && name == ev->name) hit = true;
+				off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+			}
+		}
+		return hit;
+	}
+#endif
+	default:
+		if (now - lastPoll_ < POLL_INTERVAL) return false;
+		lastPoll_ = now;
+		return true;
+	}
+}
+
+bool ConfigWatcher::Poll(Clock::time_point now)
+{
+	if (!running_) return false;
+	if (Signalled(now))
+	{
+		const Stamp s = StatFile();
+		if (s != stamp_)
+		{
+			stamp_ = s;
+			pending_ = true;
+			lastChange_ = now;
+		}
+	}
+	if (!pending_ || now - lastChange_ < debounce_) return false;
+
+	// Quiet long enough, but a writer may still be going without waking us (poll mode).
+	const Stamp s = StatFile();
+	if (s != stamp_)
+	{
+		stamp_ = s;
+		lastChange_ = now;
+		return false;
+	}
+	pending_ = false;
+	return true;
+}
+
+static std::string_view TrimView(std::string_view s)
+{
+	while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1);
+	while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+	return s;
+}
+
+// Splits on sep outside double quotes.
+static std::vector<std::string_view> SplitUnquoted(std::string_view s, char sep)
+{
+	std::vector<std::string_view> parts;
+	bool quoted = false;
+	size_t start = 0;
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		if (s[i] == '"') quoted = !quoted;
+		else if (s[i] == sep && !quoted)
+		{
+			parts.push_back(s.substr(start, i - start));
+			start = i + 1;
+		}
+	}
+	parts.push_back(s.substr(start));
+	return parts;
+}
+
+static std::vector<std::string> Tokenize(std::string_view s)
+{
+	std::vector<std::string> tokens;
+	size_t i = 0;
+	while (i < s.size())
+	{
+		while (i < s.size() && (s[i] == ' ' || s[i] == '\t')) ++i;
+		if (i >= s.size()) break;
+		if (s[i] == '"')
+		{
+			const size_t close = s.find('"', i + 1);
+			const size_t end = close == std::string_view::npos ? s.size() : close;
+			tokens.emplace_back(s.substr(i + 1, end - i - 1));
+			i = end + 1;
+		}
+		else
+		{
+			const size_t end = std::min(s.find_first_of(" \t", i), s.size());
+			tokens.emplace_back(s.substr(i, end - i));
+			i = end;
+		}
+	}
+	return tokens;
+}
+
+static void ParseCommands(std::string_view text, CfgSettings& out, int depth)
+{
+	for (std::string_view part : SplitUnquoted(text, ';'))
+	{
+		const std::vector<std::string> t = Tokenize(TrimView(part));
+		if (t.empty()) continue;
+		if (t[0] == "alias")
+		{
+			if (t.size() >= 3 && depth < 4) ParseCommands(t[2], out, depth + 1);
+		}
+		else if (t[0] == "bind")
+		{
+			if (t.size() >= 3) out.binds[t[2]] = t[1];
+		}
+		else if (t.size() == 2 && t[0] != "unbind" && t[0] != "exec")
+		{
+			out.cvars[t[0]] = t[1];
+		}
+	}
+}
+
+void ParseCfgLine(std::string_view line, CfgSettings& out)
+{
+	bool quoted = false;
+	for (size_t i = 0; i + 1 < line.size(); ++i)
+	{
+		if (line[i] == '"') quoted = !quoted;
+		else if (!quoted && line[i] == '/' && line[i + 1] == '/')
+		{
+			line = line.substr(0, i);
+			break;
+		}
+	}
+	ParseCommands(line, out, 0);
+}
+
+void CfgDelta::Reset(std::string_view text)
+{
+	lines_.clear();
+	Update(text);
+}
+
+std::vector<std::string> CfgDelta::Update(std::string_view text)
+{
+	std::unordered_set<std::string> next;
+	std::vector<std::string> changed;
+	while (!text.empty())
+	{
+		const size_t nl = text.find('\n');
+		const std::string_view line = TrimView(text.substr(0, nl));
+		text.remove_prefix(nl == std::string_view::npos ? text.size() : nl + 1);
+		if (line.empty()) continue;
+		auto [it, inserted] = next.emplace(line);
+		if (inserted && !lines_.count(*it)) changed.push_back(*it);
+	}
+	lines_ = std::move(next);
+	return changed;
+}
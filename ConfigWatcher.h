@@ -0,0 +1,88 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Watches one file for external edits without a thread: Poll() is called
+// from the game tick and costs a non-blocking read (inotify), a zero-timeout
+// wait (Windows change notification) or, when neither is available, a stat
+// every POLL_INTERVAL. A change is reported once the file has been quiet for
+// the debounce period, so editors and scripts that write in several steps
+// trigger a single reload.
+class ConfigWatcher
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::chrono::milliseconds DEFAULT_DEBOUNCE{ 250 };
+	static constexpr std::chrono::milliseconds POLL_INTERVAL{ 500 };
+
+	~ConfigWatcher();
+
+	bool Start(const std::filesystem::path& file, std::chrono::milliseconds debounce = DEFAULT_DEBOUNCE);
+	void Stop();
+	bool IsRunning() const { return running_; }
+	// "inotify", "win32" or "poll".
+	const char* Backend() const;
+
+	// True once per settled change.
+	bool Poll(Clock::time_point now);
+
+private:
+	struct Stamp
+	{
+		bool exists = false;
+		std::filesystem::file_time_type mtime{};
+		uintmax_t size = 0;
+		bool operator==(const Stamp& o) const { return exists == o.exists && mtime == o.mtime && size == o.size; }
+		bool operator!=(const Stamp& o) const { return !(*this == o); }
+	};
+
+	enum class Mode : uint8_t { Poll, Inotify, Win32 };
+
+	Stamp StatFile() const;
+	bool Signalled(Clock::time_point now);
+
+	std::filesystem::path file_;
+	std::chrono::milliseconds debounce_ = DEFAULT_DEBOUNCE;
+	bool running_ = false;
+	Mode mode_ = Mode::Poll;
+	Stamp stamp_;
+	bool pending_ = false;
+	Clock::time_point lastChange_{};
+	Clock::time_point lastPoll_{};
+#ifdef _WIN32
+	void* change_ = nullptr;
+#else
+	int fd_ = -1;
+#endif
+};
+
+// Binds and cvar assignments found in cfg lines. Later lines win.
+struct CfgSettings
+{
+	std::unordered_map<std::string, std::string> binds; // command -> key
+	std::unordered_map<std::string, std::string> cvars; // name -> value
+};
+
+// Parses one console line: ';'-separated commands, "quoted" arguments, '//'
+// comments, with alias bodies expanded in place (not executed).
+void ParseCfgLine(std::string_view line, CfgSettings& out);
+
+// Remembers the lines of the last seen version of a cfg so a reload only has
+// to parse lines that were added or edited.
+class CfgDelta
+{
+public:
+	void Reset(std::string_view text);
+	// Lines of text that were not in the previous version; text becomes the new baseline.
+	std::vector<std::string> Update(std::string_view text);
+
+private:
+	std::unordered_set<std::string> lines_;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Wire format of the local control socket (loopback TCP). Simple commands are
+// a single opcode byte; clients may stream any number of them back to back.
+//
+// Op_Sequenced is for multi-seat setups and is followed by SEQUENCED_PAYLOAD
+// bytes, little endian:
+//   u8 seat, u32 seq, u64 idempotency key, u8 SeqKind, u8 team, i16 value
+// Retries must reuse the key (keys are per seat). seq orders one seat's
+// commands only: once a seat's absolute score set is accepted, its commands
+// for that team with a lower or equal seq are stale. Between seats, the
+// command that reaches the plugin last wins.
+//
+// Op_QueryStats is answered with STATS_REPLY bytes, little endian:
+//   u64 received, u64 dropped (queue full), u64 invalid
+// counted over all clients since the socket started, this query's batch included.
+// Replies are not queued: one that finds the client's socket buffer full is
+// dropped, and a client whose buffer takes only part of a reply is disconnected.
+namespace ControlProtocol
+{
+	constexpr uint16_t DEFAULT_PORT = 43210;
+
+	enum Op : uint8_t
+	{
+		Op_BluePlus = 0x01,
+		Op_BlueMinus = 0x02,
+		Op_OrangePlus = 0x03,
+		Op_OrangeMinus = 0x04,
+		Op_PauseToggle = 0x05,
+		Op_ResetKickoff = 0x06,
+		Op_SimpleCount,
+
+		Op_Sequenced = 0x10,
+		Op_QueryStats = 0x20,
+	};
+
+	enum SeqKind : uint8_t
+	{
+		Seq_ScoreDelta = 0x01,
+		Seq_ScoreSet = 0x02,
+		Seq_PauseToggle = 0x03,
+		Seq_ResetKickoff = 0x04,
+	};
+
+	constexpr size_t SEQUENCED_PAYLOAD = 1 + 4 + 8 + 1 + 1 + 2;
+	constexpr size_t STATS_REPLY = 8 * 3;
+}
+
+// State stream pushed to subscribers of the broadcast socket. Every frame is
+//   u16 length (bytes that follow), u8 field mask, u64 timestamp (steady clock, ns)
+// followed by the fields named in the mask, in bit order, little endian:
+//   blue i16, orange i16, seconds remaining i16, flags u8,
+//   action serial u32 + action text (u8 length, bytes).
+// Keyframes carry every field; other frames only what changed.
+namespace StreamProtocol
+{
+	constexpr uint16_t DEFAULT_PORT = 43211;
+
+	enum Field : uint8_t
+	{
+		Field_Blue = 1 << 0,
+		Field_Orange = 1 << 1,
+		Field_Clock = 1 << 2,
+		Field_Flags = 1 << 3,
+		Field_Action = 1 << 4,
+		Field_All = 0x1F,
+		Field_Keyframe = 1 << 7,
+	};
+
+	enum Flag : uint8_t
+	{
+		Flag_InGame = 1 << 0,
+		Flag_Paused = 1 << 1,
+		Flag_Overtime = 1 << 2,
+	};
+
+	constexpr size_t MAX_ACTION_TEXT = 63;
+	constexpr size_t MAX_FRAME = 2 + 1 + 8 + 2 + 2 + 2 + 1 + 4 + 1 + MAX_ACTION_TEXT;
+}
@@ -0,0 +1,195 @@
+#include "pch.h"
+#include "ControlServer.h"
+#include "LocalSocket.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	struct Client
+	{
+		socket_t sock;
+		// Bytes of a sequenced frame split across recv() calls.
+		uint8_t partial[1 + ControlProtocol::SEQUENCED_PAYLOAD];
+		size_t partialLen = 0;
+	};
+
+	ControlCommand DecodeSequenced(const uint8_t* frame)
+	{
+		ControlCommand cmd;
+		const uint8_t* p = frame + 1;
+		cmd.op = ControlProtocol::Op_Sequenced;
+		cmd.seat = *p++;
+		std::memcpy(&cmd.seq, p, sizeof(cmd.seq)); p += sizeof(cmd.seq);
+		std::memcpy(&cmd.key, p, sizeof(cmd.key)); p += sizeof(cmd.key);
+		cmd.kind = *p++;
+		cmd.team = *p++;
+		std::memcpy(&cmd.value, p, sizeof(cmd.value));
+		return cmd;
+	}
+}
+
+ControlServer::~ControlServer()
+{
+	Stop();
+}
+
+bool ControlServer::Start(uint16_t port)
+{
+	Stop();
+	if (!LocalSocket::NetStartup()) return false;
+	socket_t s = LocalSocket::ListenLoopback(port);
+	if (s == INVALID_SOCKET)
+	{
+		LocalSocket::NetCleanup();
+		return false;
+	}
+
+	listen_ = static_cast<uintptr_t>(s);
+	running_ = true;
+	thread_ = std::thread([this]() { Run(); });
+	return true;
+}
+
+void ControlServer::Stop()
+{
+	if (!thread_.joinable()) return;
+	running_ = false;
+	thread_.join();
+	LocalSocket::Close(static_cast<socket_t>(listen_));
+	listen_ = ~uintptr_t(0);
+	LocalSocket::NetCleanup();
+}
+
+ControlStats ControlServer::Stats() const
+{
+	ControlStats st;
+	st.received = received_.load(std::memory_order_relaxed);
+	st.dropped = dropped_.load(std::memory_order_relaxed);
+	st.invalid = invalid_.load(std::memory_order_relaxed);
+	st.maxEnqueueNs = maxEnqueueNs_.load(std::memory_order_relaxed);
+	return st;
+}
+
+void ControlServer::Run()
+{
+	const socket_t listenSock = static_cast<socket_t>(listen_);
+	std::vector<Client> clients;
+	uint8_t buf[4096];
+
+	while (running_.load(std::memory_order_relaxed))
+	{
+		fd_set readable;
+		FD_ZERO(&readable);
+		FD_SET(listenSock, &readable);
+		socket_t maxFd = listenSock;
+		for (const Client& c : clients)
+		{
+			FD_SET(c.sock, &readable);
+			if (c.sock > maxFd) maxFd = c.sock;
+		}
+
+		// Short timeout so Stop() is noticed without needing to wake the socket.
+		timeval tv{ 0, 100 * 1000 };
+		if (select(static_cast<int>(maxFd + 1), &readable, nullptr, nullptr, &tv) <= 0) continue;
+
+		if (FD_ISSET(listenSock, &readable))
+		{
+			socket_t c = accept(listenSock, nullptr, nullptr);
+			if (c != INVALID_SOCKET)
+			{
+				if (clients.size() >= MAX_CLIENTS)
+				{
+					LocalSocket::Close(c);
+				}
+				else
+				{
+					// Non-blocking so a client that never reads its stats replies cannot stall this loop.
+					LocalSocket::SetNonBlocking(c);
+					LocalSocket::SetNoDelay(c);
+					clients.push_back(Client{ c, {}, 0 });
+				}
+			}
+		}
+
+		for (size_t i = 0; i < clients.size();)
+		{
+			Client& client = clients[i];
+			if (!FD_ISSET(client.sock, &readable)) { ++i; continue; }
+			const int n = recv(client.sock, reinterpret_cast<char*>(buf), sizeof(buf), 0);
+			if (n < 0 && LocalSocket::WouldBlock()) { ++i; continue; }
+			if (n <= 0)
+			{
+				LocalSocket::Close(client.sock);
+				clients[i] = clients.back();
+				clients.pop_back();
+				continue;
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			uint64_t accepted = 0, dropped = 0, invalid = 0;
+			auto push = [&](const ControlCommand& cmd) {
+				if (queue_.Push(cmd)) ++accepted;
+				else ++dropped;
+			};
+			// Counters are published per batch; a stats query publishes what came before it.
+			auto flush = [&]() {
+				received_.fetch_add(accepted, std::memory_order_relaxed);
+				if (dropped) dropped_.fetch_add(dropped, std::memory_order_relaxed);
+				if (invalid) invalid_.fetch_add(invalid, std::memory_order_relaxed);
+				accepted = dropped = invalid = 0;
+			};
+			bool torn = false;
+			for (int b = 0; b < n && !torn; ++b)
+			{
+				if (client.partialLen > 0)
+				{
+					client.partial[client.partialLen++] = buf[b];
+					if (client.partialLen == sizeof(client.partial))
+					{
+						push(DecodeSequenced(client.partial));
+						client.partialLen = 0;
+					}
+					continue;
+				}
+				if (buf[b] == ControlProtocol::Op_Sequenced)
+				{
+					client.partial[client.partialLen++] = buf[b];
+					continue;
+				}
+				if (buf[b] == ControlProtocol::Op_QueryStats)
+				{
+					flush();
+					const ControlStats st = Stats();
+					const uint64_t fields[3] = { st.received, st.dropped, st.invalid };
+					char reply[ControlProtocol::STATS_REPLY];
+					std::memcpy(reply, fields, sizeof(reply));
+					const int sent = send(client.sock, reply, static_cast<int>(sizeof(reply)), 0);
+					// A full socket buffer drops the reply. A partial one would leave the client mid-reply, so it is disconnected.
+					if (sent < 0 && LocalSocket::WouldBlock()) continue;
+					torn = sent != static_cast<int>(sizeof(reply));
+					continue;
+				}
+				if (buf[b] == 0 || buf[b] >= ControlProtocol::Op_SimpleCount) { ++invalid; continue; }
+				ControlCommand cmd;
+				cmd.op = buf[b];
+				push(cmd);
+			}
+			const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+			flush();
+			if (ns > maxEnqueueNs_.load(std::memory_order_relaxed)) maxEnqueueNs_.store(ns, std::memory_order_relaxed);
+			if (torn)
+			{
+				LocalSocket::Close(client.sock);
+				clients[i] = clients.back();
+				clients.pop_back();
+				continue;
+			}
+			++i;
+		}
+	}
+
+	for (const Client& c : clients) LocalSocket::Close(c.sock);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "ControlProtocol.h"
+#include "SpscQueue.h"
+
+struct ControlCommand
+{
+	uint8_t op = 0;
+	// Only set for ControlProtocol::Op_Sequenced.
+	uint8_t seat = 0;
+	uint8_t kind = 0;
+	uint8_t team = 0;
+	int16_t value = 0;
+	uint32_t seq = 0;
+	uint64_t key = 0;
+};
+
+struct ControlStats
+{
+	uint64_t received = 0;
+	uint64_t dropped = 0;
+	uint64_t invalid = 0;
+	uint64_t maxEnqueueNs = 0;
+};
+
+// Loopback TCP listener for external controllers (stream decks, referee
+// tablets). An IO thread decodes ControlProtocol opcodes and hands them to
+// the game thread through a lock-free SPSC queue, drained once per tick.
+class ControlServer
+{
+public:
+	~ControlServer();
+
+	bool Start(uint16_t port);
+	void Stop();
+	bool IsRunning() const { return thread_.joinable(); }
+
+	template <typename Fn>
+	size_t Drain(Fn&& fn)
+	{
+		size_t n = 0;
+		ControlCommand cmd;
+		while (n < QUEUE_CAPACITY && queue_.Pop(cmd))
+		{
+			fn(cmd);
+			++n;
+		}
+		return n;
+	}
+
+	ControlStats Stats() const;
+	uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+	static constexpr size_t QUEUE_CAPACITY = 4096;
+	static constexpr size_t MAX_CLIENTS = 16;
+
+	void Run();
+
+	std::thread thread_;
+	std::atomic<bool> running_{ false };
+	uintptr_t listen_ = ~uintptr_t(0);
+	SpscQueue<ControlCommand, QUEUE_CAPACITY> queue_;
+	std::atomic<uint64_t> received_{ 0 };
+	std::atomic<uint64_t> dropped_{ 0 };
+	std::atomic<uint64_t> invalid_{ 0 };
+	std::atomic<uint64_t> maxEnqueueNs_{ 0 };
+};
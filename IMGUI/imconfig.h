@@ -42,6 +42,30 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 
+//---- ID hashing backend for ImHashStr()/ImHashData() (see imgui_hash.h). Default is slicing-by-8 CRC32, bit-identical to upstream.
+// Keep the default when drawing into BakkesMod's shared context: other backends change every ID and .ini key.
+//#define IMGUI_HASH_CRC32C                                 // CRC32C, SSE4.2 instruction with runtime check and table fallback
+//#define IMGUI_HASH_WORDS                                  // 8 bytes per step multiply/xor hash
+
+//---- Back ImGuiStorage (WindowsById, tree node state, ...) with an open-addressing hash index instead of a sorted array.
+// Changes the ImGuiStorage layout, so like the hash backends above it is only for contexts the plugin owns.
+//#define IMGUI_STORAGE_OPEN_ADDRESSING
+
+//---- AddPolyline()/AddConvexPolyFilled() compute anti-aliased fringes with SSE2/AVX/NEON (see imgui_draw_simd.h). Output is bit-identical to
+// the scalar code, so this is on by default, shared context included. Define to fall back to plain float math.
+//#define IMGUI_DISABLE_DRAW_SIMD
+
+//---- Bytes of per-call scratch (normals and fringe points) AddPolyline()/AddConvexPolyFilled() may take from the stack; larger shapes use the heap.
+//#define IM_DRAWLIST_TEMP_STACK_MAX  (16 * 1024)
+
+//---- PathArcTo() (AddCircle() etc. with other than 12 segments) reuses unit-circle tables of recent arcs instead of calling cosf/sinf per point.
+// Bit-identical and kept outside the shared context; define to always compute the angles.
+//#define IMGUI_DISABLE_ARC_CACHE
+
+//---- Font atlas builds with many glyphs rasterize them on worker threads (see ImFontAtlasBuildSetThreadCount()). Packing stays on the calling
+// thread, so the texture is identical for any thread count. Define to always rasterize on the calling thread and not include <thread>.
+//#define IMGUI_DISABLE_FONT_BUILD_THREADS
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -1692,11 +1692,24 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // [Internal] Linear-probing index over Data, 8-byte slots (8 per cache line), at most half full.
+    // Data is then kept in insertion order instead of sorted, and only sorted by BuildSortByKey().
+    // This changes the struct layout: never enable it for a context shared with code built without it.
+    struct ImGuiStorageSlot { ImGuiID key; int index; };
+    ImVector<ImGuiStorageSlot>      Slots;              // Power-of-two size, index < 0 = empty
+    int                             SlotsIndexed = 0;   // Data.Size when Slots was last brought up to date
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    //   (O(1) expected with IMGUI_STORAGE_OPEN_ADDRESSING)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    void                Clear() { Data.clear(); Slots.clear(); SlotsIndexed = 0; }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1979,7 +1992,7 @@ struct ImDrawList
     inline    void  PathLineToMergeDuplicate(const ImVec2& pos)                 { if (_Path.Size == 0 || memcmp(&_Path.Data[_Path.Size-1], &pos, 8) != 0) _Path.push_back(pos); }
     inline    void  PathFillConvex(ImU32 col)                                   { AddConvexPolyFilled(_Path.Data, _Path.Size, col); _Path.Size = 0; }  // Note: Anti-aliased filling requires points to be in clockwise order.
     inline    void  PathStroke(ImU32 col, bool closed, float thickness = 1.0f)  { AddPolyline(_Path.Data, _Path.Size, col, closed, thickness); _Path.Size = 0; }
-    IMGUI_API void  PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments = 10);
+    IMGUI_API void  PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments = 10);                                 // num_segments <= 0: automatic, from radius and style.CircleSegmentMaxError
     IMGUI_API void  PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12);                                            // Use precomputed angles for a 12 steps circle
     IMGUI_API void  PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments = 0);
     IMGUI_API void  PathRect(const ImVec2& rect_min, const ImVec2& rect_max, float rounding = 0.0f, ImDrawCornerFlags rounding_corners = ImDrawCornerFlags_All);
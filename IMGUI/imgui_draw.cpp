@@ -17,6 +17,8 @@ Index of this file:
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
+// [SECTION] ImFontGlyphCache
+// [SECTION] ImTextLayoutCache
 // [SECTION] Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -34,8 +36,15 @@ Index of this file:
 #define IMGUI_DEFINE_MATH_OPERATORS
 #endif
 #include "imgui_internal.h"
+#include "imgui_glyph_cache.h"
+#include "imgui_text_cache.h"
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#include <stdlib.h>     // malloc, free (font build scratch memory)
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+#include <atomic>
+#include <thread>
+#endif
 #if !defined(alloca)
 #if defined(__GLIBC__) || defined(__sun) || defined(__CYGWIN__) || defined(__APPLE__) || defined(__SWITCH__)
 #include <alloca.h>     // alloca (glibc uses <alloca.h>. Note that Cygwin may have _WIN32 defined, so the order matters here)
@@ -49,6 +58,11 @@ Index of this file:
 #endif
 #endif
 
+// Tessellation scratch above this size comes from the heap, so a polygon with many points cannot overflow the stack (see imconfig.h).
+#ifndef IM_DRAWLIST_TEMP_STACK_MAX
+#define IM_DRAWLIST_TEMP_STACK_MAX  (16 * 1024)
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127) // condition expression is constant
@@ -132,10 +146,49 @@ namespace IMGUI_STB_NAMESPACE
 #endif
 #endif
 
+// Scratch memory for stb_truetype while rasterizing on worker threads (see ImFontAtlasBuildSetThreadCount()). It is passed as the font's
+// userdata, so STBTT_malloc() only falls back to IM_ALLOC() on the calling thread: allocators set with SetAllocatorFunctions() need not be
+// thread-safe. Blocks are bump-allocated and released all at once by ImFontBuildScratchReset().
+struct ImFontBuildScratch
+{
+    unsigned char*  Data;
+    size_t          Size;
+    size_t          Used;
+    size_t          Requested;          // Total asked for since the last reset; Data grows to this so the next round fits
+    void*           Overflow;           // Singly linked list of blocks that did not fit in Data
+};
+
+static void* ImFontBuildScratchAlloc(size_t size, void* user_data)
+{
+    if (user_data == NULL)
+        return IM_ALLOC(size);
+    ImFontBuildScratch* scratch = (ImFontBuildScratch*)user_data;
+    size = (size + 15) & ~(size_t)15;
+    scratch->Requested += size;
+    if (scratch->Used + size <= scratch->Size)
+    {
+        void* p = scratch->Data + scratch->Used;
+        scratch->Used += size;
+        return p;
+    }
+    unsigned char* block = (unsigned char*)malloc(16 + size);
+    if (block == NULL)
+        return NULL;
+    *(void**)block = scratch->Overflow;
+    scratch->Overflow = block;
+    return block + 16;
+}
+
+static void ImFontBuildScratchFree(void* ptr, void* user_data)
+{
+    if (user_data == NULL)
+        IM_FREE(ptr);
+}
+
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#define STBTT_malloc(x,u)   ImFontBuildScratchAlloc(x,u)
+#define STBTT_free(x,u)     ImFontBuildScratchFree(x,u)
 #define STBTT_assert(x)     IM_ASSERT(x)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -621,6 +674,10 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } }
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; }
 
+// The anti-aliased paths compute normals and fringe points several points at a time (imgui_draw_simd.h), with the
+// same operations as the macros above, into one temporary array per fringe row instead of interleaved points.
+#include "imgui_draw_simd.h"
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
@@ -645,115 +702,62 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const int vtx_count = thick_line ? points_count*4 : points_count*3;
         PrimReserve(idx_count, vtx_count);
 
-        // Temporary buffer
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2)); //-V630
-        ImVec2* temp_points = temp_normals + points_count;
+        // Temporary buffer: normals, then one row of fringe points per vertex column
+        const size_t temp_size = (size_t)points_count * (thick_line ? 5 : 3) * sizeof(ImVec2);
+        ImVec2* temp_heap = temp_size > IM_DRAWLIST_TEMP_STACK_MAX ? (ImVec2*)IM_ALLOC(temp_size) : NULL;
+        ImVec2* temp_normals = temp_heap ? temp_heap : (ImVec2*)alloca(temp_size); //-V630
+        ImVec2* temp_rows[4] = { temp_normals + points_count, temp_normals + points_count*2, temp_normals + points_count*3, temp_normals + points_count*4 };
 
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1+1) == points_count ? 0 : i1+1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
-        if (!closed)
-            temp_normals[points_count-1] = temp_normals[points_count-2];
+        ImDrawSimd::PolyNormals<ImDrawSimd::SimdOps>(points, points_count, closed, temp_normals);
 
         if (!thick_line)
         {
+            const float scale[2] = { AA_SIZE, -AA_SIZE };
+            ImDrawSimd::PolyFringe<ImDrawSimd::SimdOps, 2>(points, points_count, closed, temp_normals, scale, temp_rows);
             if (!closed)
             {
-                temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
-                temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
+                temp_rows[0][0] = points[0] + temp_normals[0] * AA_SIZE;
+                temp_rows[1][0] = points[0] - temp_normals[0] * AA_SIZE;
             }
 
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx;
             for (int i1 = 0; i1 < count; i1++)
             {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
                 unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y)
-                dm_x *= AA_SIZE;
-                dm_y *= AA_SIZE;
-
-                // Add temporary vertexes
-                ImVec2* out_vtx = &temp_points[i2*2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                // Add indexes
                 _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
                 _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
                 _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
                 _IdxWritePtr += 12;
-
                 idx1 = idx2;
             }
 
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-                _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
-                _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+                _VtxWritePtr[0].pos = points[i];       _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr[1].pos = temp_rows[0][i]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+                _VtxWritePtr[2].pos = temp_rows[1][i]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
                 _VtxWritePtr += 3;
             }
         }
         else
         {
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+            const float scale[4] = { half_inner_thickness + AA_SIZE, half_inner_thickness, -half_inner_thickness, -(half_inner_thickness + AA_SIZE) };
+            ImDrawSimd::PolyFringe<ImDrawSimd::SimdOps, 4>(points, points_count, closed, temp_normals, scale, temp_rows);
             if (!closed)
             {
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+0] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
-                temp_points[(points_count-1)*4+1] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+2] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness);
-                temp_points[(points_count-1)*4+3] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
+                temp_rows[0][0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
+                temp_rows[1][0] = points[0] + temp_normals[0] * (half_inner_thickness);
+                temp_rows[2][0] = points[0] - temp_normals[0] * (half_inner_thickness);
+                temp_rows[3][0] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
             }
 
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx;
             for (int i1 = 0; i1 < count; i1++)
             {
-                const int i2 = (i1+1) == points_count ? 0 : i1+1;
                 unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+4;
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertexes
-                ImVec2* out_vtx = &temp_points[i2*4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
@@ -761,21 +765,22 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
                 _IdxWritePtr += 18;
-
                 idx1 = idx2;
             }
 
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i*4+0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i*4+1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i*4+2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i*4+3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
+                _VtxWritePtr[0].pos = temp_rows[0][i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
+                _VtxWritePtr[1].pos = temp_rows[1][i]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos = temp_rows[2][i]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos = temp_rows[3][i]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
                 _VtxWritePtr += 4;
             }
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        if (temp_heap)
+            IM_FREE(temp_heap);
     }
     else
     {
@@ -836,41 +841,33 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+        // Compute normals, then inner and outer fringe points
+        const size_t temp_size = (size_t)points_count * 3 * sizeof(ImVec2);
+        ImVec2* temp_heap = temp_size > IM_DRAWLIST_TEMP_STACK_MAX ? (ImVec2*)IM_ALLOC(temp_size) : NULL;
+        ImVec2* temp_normals = temp_heap ? temp_heap : (ImVec2*)alloca(temp_size); //-V630
+        ImVec2* temp_rows[2] = { temp_normals + points_count, temp_normals + points_count*2 };
+        const float scale[2] = { -(AA_SIZE * 0.5f), AA_SIZE * 0.5f };
+        ImDrawSimd::PolyNormals<ImDrawSimd::SimdOps>(points, points_count, true, temp_normals);
+        ImDrawSimd::PolyFringe<ImDrawSimd::SimdOps, 2>(points, points_count, true, temp_normals, scale, temp_rows);
+
+        // Add vertices
+        for (int i = 0; i < points_count; i++)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            _VtxWritePtr[0].pos = temp_rows[0][i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = temp_rows[1][i]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr += 2;
         }
 
+        // Add indexes for fringes
         for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
             _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
             _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
             _IdxWritePtr += 6;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        if (temp_heap)
+            IM_FREE(temp_heap);
     }
     else
     {
@@ -907,6 +904,67 @@ void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_
     }
 }
 
+// Segment count for a full circle of this radius within _Data->CircleSegmentMaxError, as used by AddCircle() etc.
+static int CalcCircleAutoSegmentCount(const ImDrawListSharedData* data, float radius)
+{
+    const int radius_idx = (int)radius - 1;
+    if (radius_idx >= 0 && radius_idx < IM_ARRAYSIZE(data->CircleSegmentCounts))
+        return data->CircleSegmentCounts[radius_idx]; // Use cached value
+    return IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(ImMax(radius, 1.0f), data->CircleSegmentMaxError);
+}
+
+#ifndef IMGUI_DISABLE_ARC_CACHE
+// Unit vectors of recently drawn arcs, keyed by (a_min, a_max, num_segments). Every circle with a given segment
+// count shares one entry whatever its radius, so PathArcTo() costs a multiply-add per point instead of
+// ImCos()+ImSin(). Angles use the same expression as the uncached loop, so points are bit-identical.
+// This lives here rather than in ImDrawListSharedData: that struct is part of ImGuiContext, and the plugin draws
+// into a context created by BakkesMod's ImGui, so its layout must not change. Like GImGui, it assumes one thread
+// draws at a time. Tables are packed into a fixed pool; when it fills up the whole cache starts over.
+struct ImDrawArcCache
+{
+    enum { SLOTS = 64, POOL_SIZE = 8192, MAX_POINTS = 1025 };
+    struct Slot { ImU32 AMin, AMax; int Segments, Offset; };
+    Slot    Slots[SLOTS];                   // Segments == 0: empty
+    ImVec2  Pool[POOL_SIZE];
+    int     PoolUsed;
+};
+static ImDrawArcCache GImDrawArcCache;
+
+static const ImVec2* ArcCacheGet(float a_min, float a_max, int num_segments)
+{
+    ImDrawArcCache& c = GImDrawArcCache;
+    const int points_count = num_segments + 1;
+    if (points_count > ImDrawArcCache::MAX_POINTS)
+        return NULL;
+    ImU32 a_min_bits, a_max_bits;
+    memcpy(&a_min_bits, &a_min, sizeof(ImU32));
+    memcpy(&a_max_bits, &a_max, sizeof(ImU32));
+    const ImU32 h = (a_min_bits * 0x9E3779B1u) ^ (a_max_bits * 0x85EBCA77u) ^ ((ImU32)num_segments * 0xC2B2AE3Du);
+    ImDrawArcCache::Slot& slot = c.Slots[(h ^ (h >> 15)) % ImDrawArcCache::SLOTS];
+    if (slot.Segments == num_segments && slot.AMin == a_min_bits && slot.AMax == a_max_bits)
+        return &c.Pool[slot.Offset];
+
+    if (c.PoolUsed + points_count > ImDrawArcCache::POOL_SIZE)
+    {
+        memset(c.Slots, 0, sizeof(c.Slots));
+        c.PoolUsed = 0;
+    }
+    ImVec2* table = &c.Pool[c.PoolUsed];
+    for (int i = 0; i <= num_segments; i++)
+    {
+        const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
+        table[i] = ImVec2(ImCos(a), ImSin(a));
+    }
+    slot.AMin = a_min_bits;
+    slot.AMax = a_max_bits;
+    slot.Segments = num_segments;
+    slot.Offset = c.PoolUsed;
+    c.PoolUsed += points_count;
+    return table;
+}
+#endif
+
+// num_segments <= 0: pick the count from radius and CircleSegmentMaxError, proportionally to the arc's span.
 void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
     if (radius == 0.0f)
@@ -914,9 +972,22 @@ void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, floa
         _Path.push_back(center);
         return;
     }
+    if (num_segments <= 0)
+        num_segments = ImMax((int)ImCeil(CalcCircleAutoSegmentCount(_Data, radius) * ImFabs(a_max - a_min) / (IM_PI * 2.0f)), 1);
 
     // Note that we are adding a point at both a_min and a_max.
     // If you are trying to draw a full closed circle you don't want the overlapping points!
+#ifndef IMGUI_DISABLE_ARC_CACHE
+    if (const ImVec2* unit = ArcCacheGet(a_min, a_max, num_segments))
+    {
+        const int path_size = _Path.Size;
+        _Path.resize(path_size + num_segments + 1);
+        ImVec2* out = _Path.Data + path_size;
+        for (int i = 0; i <= num_segments; i++)
+            out[i] = ImVec2(center.x + unit[i].x * radius, center.y + unit[i].y * radius);
+        return;
+    }
+#endif
     _Path.reserve(_Path.Size + (num_segments + 1));
     for (int i = 0; i <= num_segments; i++)
     {
@@ -1110,11 +1181,7 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if (num_segments <= 0)
     {
         // Automatic segment count
-        const int radius_idx = (int)radius - 1;
-        if (radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
-            num_segments = _Data->CircleSegmentCounts[radius_idx]; // Use cached value
-        else
-            num_segments = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+        num_segments = CalcCircleAutoSegmentCount(_Data, radius);
     }
     else
     {
@@ -1140,11 +1207,7 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if (num_segments <= 0)
     {
         // Automatic segment count
-        const int radius_idx = (int)radius - 1;
-        if (radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
-            num_segments = _Data->CircleSegmentCounts[radius_idx]; // Use cached value
-        else
-            num_segments = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+        num_segments = CalcCircleAutoSegmentCount(_Data, radius);
     }
     else
     {
@@ -1939,6 +2002,132 @@ static void UnpackBoolVectorToFlatIndexList(const ImBoolVector* in, ImVector<int
                     out->push_back((int)((it - it_begin) << 5) + bit_n);
 }
 
+// Rasterize glyphs [glyph_begin, glyph_begin + glyph_count) of one source font into the rectangles step 6 packed them in.
+static void ImFontAtlasBuildRenderGlyphs(ImFontAtlas* atlas, const ImFontConfig& cfg, const ImFontBuildSrcData& src_tmp, const stbtt_fontinfo* font_info, stbtt_pack_context* spc, int glyph_begin, int glyph_count)
+{
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += glyph_begin;
+    pack_range.chardata_for_range += glyph_begin;
+    pack_range.num_chars = glyph_count;
+    stbtt_PackFontRangesRenderIntoRects(spc, font_info, &pack_range, 1, src_tmp.Rects + glyph_begin);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = &src_tmp.Rects[glyph_begin];
+        for (int glyph_i = 0; glyph_i < glyph_count; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
+// Worker threads for step 8 of ImFontAtlasBuildWithStbTruetype(). 0 = automatic (one per hardware thread, up to 8), 1 = calling thread only.
+#define IM_FONT_BUILD_THREADS_MAX   16
+static int GImFontBuildThreadCount = 0;
+
+void    ImFontAtlasBuildSetThreadCount(int count)
+{
+    GImFontBuildThreadCount = ImClamp(count, 0, IM_FONT_BUILD_THREADS_MAX);
+}
+
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+
+static void ImFontBuildScratchReset(ImFontBuildScratch* scratch, bool release)
+{
+    while (void* block = scratch->Overflow)
+    {
+        scratch->Overflow = *(void**)block;
+        free(block);
+    }
+    if (release || scratch->Requested > scratch->Size)
+    {
+        free(scratch->Data);
+        scratch->Size = release ? 0 : scratch->Requested;
+        scratch->Data = release ? NULL : (unsigned char*)malloc(scratch->Size);
+        if (scratch->Data == NULL)
+            scratch->Size = 0;
+    }
+    scratch->Used = scratch->Requested = 0;
+}
+
+// Packing (step 6) stays on the calling thread, so glyph positions do not depend on the thread count. Rasterization writes every glyph
+// into its own rectangle of TexPixelsAlpha8 and only reads the font data, so jobs of consecutive glyphs can run on any thread.
+static const int FONT_BUILD_GLYPHS_PER_JOB = 32;
+static const int FONT_BUILD_GLYPHS_MIN_THREADED = 256;    // Below this (e.g. the default Latin range) starting threads costs more than it saves
+
+struct ImFontBuildRenderJob
+{
+    int                 SrcIndex;
+    int                 GlyphBegin;
+    int                 GlyphCount;
+};
+
+struct ImFontBuildRenderState
+{
+    ImFontAtlas*                    Atlas;
+    ImVector<ImFontBuildSrcData>*   SrcTmpArray;
+    const stbtt_pack_context*       PackContext;
+    ImVector<ImFontBuildRenderJob>  Jobs;
+    std::atomic<int>                NextJob;
+};
+
+static void ImFontAtlasBuildRenderWorker(ImFontBuildRenderState* state)
+{
+    ImFontBuildScratch scratch = {};
+    stbtt_pack_context spc = *state->PackContext;   // stbtt_PackFontRangesRenderIntoRects() writes the oversampling fields
+    for (int job_n = state->NextJob.fetch_add(1); job_n < state->Jobs.Size; job_n = state->NextJob.fetch_add(1))
+    {
+        const ImFontBuildRenderJob& job = state->Jobs[job_n];
+        const ImFontBuildSrcData& src_tmp = (*state->SrcTmpArray)[job.SrcIndex];
+        stbtt_fontinfo font_info = src_tmp.FontInfo;
+        font_info.userdata = &scratch;
+        ImFontAtlasBuildRenderGlyphs(state->Atlas, state->Atlas->ConfigData[job.SrcIndex], src_tmp, &font_info, &spc, job.GlyphBegin, job.GlyphCount);
+        ImFontBuildScratchReset(&scratch, false);
+    }
+    ImFontBuildScratchReset(&scratch, true);
+}
+
+// Returns false if the glyphs are better rendered on the calling thread.
+static bool ImFontAtlasBuildRenderThreaded(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array, const stbtt_pack_context* spc, int total_glyphs_count)
+{
+    int threads_count = GImFontBuildThreadCount;
+    if (threads_count == 0)
+        threads_count = ImClamp((int)std::thread::hardware_concurrency(), 1, 8);
+    if (threads_count <= 1 || total_glyphs_count < FONT_BUILD_GLYPHS_MIN_THREADED)
+        return false;
+
+    ImFontBuildRenderState state;
+    state.Atlas = atlas;
+    state.SrcTmpArray = &src_tmp_array;
+    state.PackContext = spc;
+    state.NextJob = 0;
+    state.Jobs.reserve(total_glyphs_count / FONT_BUILD_GLYPHS_PER_JOB + src_tmp_array.Size);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += FONT_BUILD_GLYPHS_PER_JOB)
+        {
+            ImFontBuildRenderJob job = { src_i, glyph_i, ImMin(FONT_BUILD_GLYPHS_PER_JOB, src_tmp_array[src_i].GlyphsCount - glyph_i) };
+            state.Jobs.push_back(job);
+        }
+    threads_count = ImMin(threads_count, state.Jobs.Size);
+
+    // The calling thread takes jobs too. If a thread cannot be started, the ones we have finish the work.
+    std::thread threads[IM_FONT_BUILD_THREADS_MAX - 1];
+    int threads_started = 0;
+    for (; threads_started < threads_count - 1; threads_started++)
+    {
+        try { threads[threads_started] = std::thread(ImFontAtlasBuildRenderWorker, &state); }
+        catch (...) { break; }
+    }
+    ImFontAtlasBuildRenderWorker(&state);
+    for (int thread_n = 0; thread_n < threads_started; thread_n++)
+        threads[thread_n].join();
+    return true;
+}
+
+#endif // #ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2122,25 +2311,18 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+#ifndef IMGUI_DISABLE_FONT_BUILD_THREADS
+    const bool rendered = ImFontAtlasBuildRenderThreaded(atlas, src_tmp_array, &spc, total_glyphs_count);
+#else
+    const bool rendered = false;
+#endif
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
-        {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
-        }
+        if (!rendered)
+            ImFontAtlasBuildRenderGlyphs(atlas, atlas->ConfigData[src_i], src_tmp, &src_tmp.FontInfo, &spc, 0, src_tmp.GlyphsCount);
         src_tmp.Rects = NULL;
     }
 
@@ -2580,6 +2762,9 @@ void ImFontGlyphRangesBuilder::BuildRanges(ImVector<ImWchar>* out_ranges)
 // [SECTION] ImFont
 //-----------------------------------------------------------------------------
 
+// Bumped whenever glyph tables change, so ImTextLayoutCache drops layouts built from the old tables
+static unsigned int GImFontGeneration = 0;
+
 ImFont::ImFont()
 {
     FontSize = 0.0f;
@@ -2614,10 +2799,12 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    GImFontGeneration++;
 }
 
 void ImFont::BuildLookupTable()
 {
+    GImFontGeneration++;
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
@@ -2666,6 +2853,7 @@ void ImFont::GrowIndex(int new_size)
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
     if (new_size <= IndexLookup.Size)
         return;
+    GImFontGeneration++;
     IndexAdvanceX.resize(new_size, -1.0f);
     IndexLookup.resize(new_size, (ImWchar)-1);
 }
@@ -2674,6 +2862,7 @@ void ImFont::GrowIndex(int new_size)
 // Not to be mistaken with texture coordinates, which are held by u0/v0/u1/v1 in normalized format (0.0..1.0 on each texture axis).
 void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    GImFontGeneration++;
     Glyphs.resize(Glyphs.Size + 1);
     ImFontGlyph& glyph = Glyphs.back();
     glyph.Codepoint = (ImWchar)codepoint;
@@ -2710,13 +2899,21 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
 }
 
+static int GImFontGlyphCachesCount = 0;
+static const ImFontGlyph* ImFontGlyphCacheFindGlyph(const ImFont* font, ImWchar c);
+
+struct ImTextLayoutCacheData;
+static ImTextLayoutCacheData* GImTextLayoutCache = NULL;    // NULL unless ImTextLayoutCacheSetEnabled(true)
+static bool ImTextLayoutCacheCalcTextSize(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVec2* out_size);
+static bool ImTextLayoutCacheRenderText(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip);
+
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
     if (c >= IndexLookup.Size)
         return FallbackGlyph;
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
-        return FallbackGlyph;
+        return (GImFontGlyphCachesCount > 0) ? ImFontGlyphCacheFindGlyph(this, c) : FallbackGlyph;
     return &Glyphs.Data[i];
 }
 
@@ -2834,6 +3031,10 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    ImVec2 cached_size;
+    if (GImTextLayoutCache != NULL && max_width == FLT_MAX && ImTextLayoutCacheCalcTextSize(this, size, wrap_width, text_begin, text_end, remaining, &cached_size))
+        return cached_size;
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -2955,6 +3156,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // The cache replays whole runs, so it does not handle the fast-forward below
+    if (GImTextLayoutCache != NULL && (word_wrap_enabled || !(y + line_height < clip_rect.y)))
+        if (ImTextLayoutCacheRenderText(this, draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip))
+            return;
+
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y && !word_wrap_enabled)
@@ -3126,6 +3332,978 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->_VtxCurrentIdx = vtx_current_idx;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImFontGlyphCache
+//-----------------------------------------------------------------------------
+// Lazy glyphs have their advance in IndexAdvanceX and (ImWchar)-1 in IndexLookup, so ImFont::FindGlyph() calls
+// ImFontGlyphCacheFindGlyph() for them. Resident glyphs live in ImFont::Glyphs slots past the ones Build() created.
+// IndexLookup points at a resident glyph only for the rest of the frame in which it was found: NewFrame() resets
+// those entries, so the first use in each frame goes through the cache again and refreshes the page's LRU stamp
+// while later uses in the frame cost nothing extra.
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_GLYPH_CACHE_MAX             8       // Caches attached at the same time
+#define IM_FONT_GLYPH_CACHE_MAX_PAGES       16
+#define IM_FONT_GLYPH_CACHE_NO_SLOT         ((ImWchar)-1)
+
+struct ImFontGlyphCacheSource
+{
+    ImFontConfig*       Config;
+    stbtt_fontinfo      FontInfo;
+    float               Scale;
+};
+
+struct ImFontGlyphCachePage
+{
+    stbrp_context       Packer;
+    ImVector<stbrp_node> Nodes;
+    ImVector<ImWchar>   Codepoints;         // Resident glyphs packed in this page
+    int                 Y, Height;
+    int                 LastUsedFrame;
+};
+
+struct ImFontGlyphCacheData
+{
+    ImFontAtlas*        Atlas;
+    ImFont*             Font;
+    unsigned char*      AtlasPixels;        // TexPixelsAlpha8 and TexHeight when attached. A rebuild of the atlas changes them.
+    int                 AtlasHeight;
+    ImVector<ImFontGlyphCacheSource> Sources;
+    ImVector<ImFontGlyphCachePage>   Pages;
+    ImBoolVector        Lazy;               // 1 bit per codepoint
+    ImVector<ImWchar>   Slot;               // Codepoint -> index in Font->Glyphs, or IM_FONT_GLYPH_CACHE_NO_SLOT
+    ImVector<ImU8>      SlotPage;           // (Index in Font->Glyphs - FirstSlot) -> page
+    ImVector<ImWchar>   FreeSlots;
+    ImVector<ImWchar>   Touched;            // Codepoints whose IndexLookup entry NewFrame() resets
+    int                 FirstSlot;
+    int                 MaxGlyphs;
+    int                 CurrentPage;
+    int                 Frame;
+    int                 DirtyX0, DirtyY0, DirtyX1, DirtyY1;
+    ImFontGlyphCacheStats Stats;
+};
+
+static ImFontGlyphCacheData* GImFontGlyphCaches[IM_FONT_GLYPH_CACHE_MAX] = {};
+
+static bool ImFontGlyphCacheIsValid(const ImFontGlyphCacheData* cache)
+{
+    return cache->Atlas->TexPixelsAlpha8 == cache->AtlasPixels && cache->Atlas->TexHeight == cache->AtlasHeight && cache->Font->IndexLookup.Size == cache->Slot.Size;
+}
+
+// Same arithmetic as steps 4 and 9 of ImFontAtlasBuildWithStbTruetype() and ImFont::AddGlyph(), so lazy glyphs match eager ones.
+static float ImFontGlyphCacheCalcAdvance(const ImFont* font, const ImFontGlyphCacheSource& src, int glyph_index, float* out_off_x)
+{
+    const ImFontConfig& cfg = *src.Config;
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(&src.FontInfo, glyph_index, &advance, &lsb);
+    const float char_advance_x_org = src.Scale * advance;
+    const float char_advance_x_mod = ImClamp(char_advance_x_org, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
+    float char_off_x = cfg.GlyphOffset.x;
+    if (char_advance_x_org != char_advance_x_mod)
+        char_off_x += cfg.PixelSnapH ? ImFloor((char_advance_x_mod - char_advance_x_org) * 0.5f) : (char_advance_x_mod - char_advance_x_org) * 0.5f;
+    if (out_off_x)
+        *out_off_x = char_off_x;
+    float advance_x = char_advance_x_mod + font->ConfigData->GlyphExtraSpacing.x;
+    if (font->ConfigData->PixelSnapH)
+        advance_x = IM_ROUND(advance_x);
+    return advance_x;
+}
+
+static const ImFontGlyphCacheSource* ImFontGlyphCacheFindSource(const ImFontGlyphCacheData* cache, ImWchar c, int* out_glyph_index)
+{
+    for (int src_i = 0; src_i < cache->Sources.Size; src_i++)
+        if (int glyph_index = stbtt_FindGlyphIndex(&cache->Sources[src_i].FontInfo, c))
+        {
+            *out_glyph_index = glyph_index;
+            return &cache->Sources[src_i];
+        }
+    return NULL;
+}
+
+static void ImFontGlyphCacheEvictPage(ImFontGlyphCacheData* cache, int page_n)
+{
+    ImFontGlyphCachePage& page = cache->Pages[page_n];
+    ImFont* font = cache->Font;
+    for (int n = 0; n < page.Codepoints.Size; n++)
+    {
+        const ImWchar c = page.Codepoints[n];
+        const ImWchar slot = cache->Slot[c];
+        font->IndexLookup[c] = (ImWchar)-1;
+        font->Glyphs[slot].Codepoint = 0;
+        cache->Slot[c] = IM_FONT_GLYPH_CACHE_NO_SLOT;
+        cache->FreeSlots.push_back(slot);
+    }
+    cache->Stats.GlyphsEvicted += page.Codepoints.Size;
+    cache->Stats.GlyphsResident -= page.Codepoints.Size;
+    cache->Stats.PagesEvicted++;
+    page.Codepoints.resize(0);
+    stbrp_init_target(&page.Packer, cache->Atlas->TexWidth, page.Height, page.Nodes.Data, page.Nodes.Size);
+
+    // Clear the CPU copy so padding around new glyphs is empty again. The GPU copy is only refreshed where new glyphs
+    // go (see the dirty rectangle in ImFontGlyphCacheLoad()), which covers every texel they can sample.
+    ImFontAtlas* atlas = cache->Atlas;
+    memset(atlas->TexPixelsAlpha8 + (size_t)page.Y * atlas->TexWidth, 0, (size_t)page.Height * atlas->TexWidth);
+    if (atlas->TexPixelsRGBA32)
+        for (unsigned int* p = atlas->TexPixelsRGBA32 + (size_t)page.Y * atlas->TexWidth, *p_end = p + (size_t)page.Height * atlas->TexWidth; p < p_end; p++)
+            *p = IM_COL32(255, 255, 255, 0);
+}
+
+// Finds a slot and room for a w*h rectangle, evicting least recently used pages if needed. Returns the page or -1.
+static int ImFontGlyphCacheAllocate(ImFontGlyphCacheData* cache, stbrp_rect* r)
+{
+    for (int attempt = 0; attempt <= cache->Pages.Size; attempt++)
+    {
+        if (cache->FreeSlots.Size > 0 || cache->Font->Glyphs.Size < cache->FirstSlot + cache->MaxGlyphs)
+            for (int n = 0; n < cache->Pages.Size; n++)
+            {
+                const int page_n = (cache->CurrentPage + n) % cache->Pages.Size;
+                stbrp_pack_rects(&cache->Pages[page_n].Packer, r, 1);
+                if (r->was_packed)
+                {
+                    cache->CurrentPage = page_n;
+                    return page_n;
+                }
+            }
+
+        // Full: evict the least recently used page, unless every page has a glyph that was used this frame.
+        int victim = -1;
+        for (int page_n = 0; page_n < cache->Pages.Size; page_n++)
+            if (cache->Pages[page_n].LastUsedFrame < cache->Frame && (victim == -1 || cache->Pages[page_n].LastUsedFrame < cache->Pages[victim].LastUsedFrame))
+                victim = page_n;
+        if (victim == -1)
+            return -1;
+        ImFontGlyphCacheEvictPage(cache, victim);
+        cache->Pages[victim].LastUsedFrame = cache->Frame - 1;
+        cache->CurrentPage = victim;
+    }
+    return -1;
+}
+
+static const ImFontGlyph* ImFontGlyphCacheLoad(ImFontGlyphCacheData* cache, ImWchar c)
+{
+    ImFont* font = cache->Font;
+    ImFontAtlas* atlas = cache->Atlas;
+    int glyph_index = 0;
+    const ImFontGlyphCacheSource* src = ImFontGlyphCacheFindSource(cache, c, &glyph_index);
+    if (src == NULL)
+        return font->FallbackGlyph;
+    const ImFontConfig& cfg = *src->Config;
+
+    // Rectangle size as in step 4 of ImFontAtlasBuildWithStbTruetype()
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&src->FontInfo, glyph_index, src->Scale * cfg.OversampleH, src->Scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    stbrp_rect r;
+    memset(&r, 0, sizeof(r));
+    r.w = (stbrp_coord)(x1 - x0 + atlas->TexGlyphPadding + cfg.OversampleH - 1);
+    r.h = (stbrp_coord)(y1 - y0 + atlas->TexGlyphPadding + cfg.OversampleV - 1);
+    const int page_n = ImFontGlyphCacheAllocate(cache, &r);
+    if (page_n < 0)
+    {
+        cache->Stats.GlyphsDeferred++;
+        return font->FallbackGlyph;
+    }
+    ImFontGlyphCachePage& page = cache->Pages[page_n];
+    r.y = (stbrp_coord)(r.y + page.Y);
+    const int rect_x = r.x, rect_y = r.y, rect_w = r.w, rect_h = r.h;
+
+    // Rasterize exactly as step 8 does, into this one rectangle
+    stbtt_pack_context spc;
+    memset(&spc, 0, sizeof(spc));
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = atlas->TexGlyphPadding;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    int codepoint = (int)c;
+    stbtt_packedchar pc;
+    stbtt_pack_range pack_range;
+    memset(&pack_range, 0, sizeof(pack_range));
+    pack_range.font_size = cfg.SizePixels;
+    pack_range.array_of_unicode_codepoints = &codepoint;
+    pack_range.num_chars = 1;
+    pack_range.chardata_for_range = &pc;
+    pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+    pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src->FontInfo, &pack_range, 1, &r);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r.x, r.y, r.w, r.h, atlas->TexWidth * 1);
+    }
+
+    // One texel beyond the rectangle (clamped to the page) is included so stale texels around it are refreshed too.
+    const int dx1 = ImMin(rect_x + rect_w + 1, atlas->TexWidth);
+    const int dy1 = ImMin(rect_y + rect_h + 1, page.Y + page.Height);
+    if (atlas->TexPixelsRGBA32)
+        for (int y = rect_y; y < dy1; y++)
+        {
+            const unsigned char* src_row = atlas->TexPixelsAlpha8 + (size_t)y * atlas->TexWidth;
+            unsigned int* dst_row = atlas->TexPixelsRGBA32 + (size_t)y * atlas->TexWidth;
+            for (int x = rect_x; x < dx1; x++)
+                dst_row[x] = IM_COL32(255, 255, 255, (unsigned int)src_row[x]);
+        }
+    if (cache->DirtyX1 <= cache->DirtyX0)
+    {
+        cache->DirtyX0 = rect_x; cache->DirtyY0 = rect_y;
+        cache->DirtyX1 = dx1; cache->DirtyY1 = dy1;
+    }
+    else
+    {
+        cache->DirtyX0 = ImMin(cache->DirtyX0, rect_x); cache->DirtyY0 = ImMin(cache->DirtyY0, rect_y);
+        cache->DirtyX1 = ImMax(cache->DirtyX1, dx1); cache->DirtyY1 = ImMax(cache->DirtyY1, dy1);
+    }
+
+    // Register glyph (step 9 and ImFont::AddGlyph())
+    int slot;
+    if (cache->FreeSlots.Size > 0)
+    {
+        slot = cache->FreeSlots.back();
+        cache->FreeSlots.pop_back();
+    }
+    else
+    {
+        slot = font->Glyphs.Size;
+        font->Glyphs.resize(font->Glyphs.Size + 1);
+    }
+    float char_off_x;
+    const float advance_x = ImFontGlyphCacheCalcAdvance(font, *src, glyph_index, &char_off_x);
+    const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+    stbtt_aligned_quad q;
+    float dummy_x = 0.0f, dummy_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &dummy_x, &dummy_y, &q, 0);
+    ImFontGlyph& glyph = font->Glyphs[slot];
+    glyph.Codepoint = c;
+    glyph.AdvanceX = advance_x;
+    glyph.X0 = q.x0 + char_off_x;
+    glyph.Y0 = q.y0 + font_off_y;
+    glyph.X1 = q.x1 + char_off_x;
+    glyph.Y1 = q.y1 + font_off_y;
+    glyph.U0 = q.s0;
+    glyph.V0 = q.t0;
+    glyph.U1 = q.s1;
+    glyph.V1 = q.t1;
+
+    cache->Slot[c] = (ImWchar)slot;
+    cache->SlotPage[slot - cache->FirstSlot] = (ImU8)page_n;
+    page.Codepoints.push_back(c);
+    cache->Stats.GlyphsRasterized++;
+    cache->Stats.GlyphsResident++;
+    return &glyph;
+}
+
+static const ImFontGlyph* ImFontGlyphCacheFindGlyph(const ImFont* font, ImWchar c)
+{
+    ImFontGlyphCacheData* cache = NULL;
+    for (int n = 0; n < IM_FONT_GLYPH_CACHE_MAX && cache == NULL; n++)
+        if (GImFontGlyphCaches[n] && GImFontGlyphCaches[n]->Font == font)
+            cache = GImFontGlyphCaches[n];
+    if (cache == NULL || !ImFontGlyphCacheIsValid(cache) || !cache->Lazy.GetBit(c))
+        return font->FallbackGlyph;
+
+    const ImFontGlyph* glyph;
+    ImWchar slot = cache->Slot[c];
+    if (slot != IM_FONT_GLYPH_CACHE_NO_SLOT)
+        glyph = &font->Glyphs[slot];
+    else if ((glyph = ImFontGlyphCacheLoad(cache, c)) == font->FallbackGlyph)
+        return glyph;
+    else
+        slot = cache->Slot[c];
+    cache->Font->IndexLookup[c] = slot;
+    cache->Pages[cache->SlotPage[slot - cache->FirstSlot]].LastUsedFrame = cache->Frame;
+    cache->Touched.push_back(c);
+    return glyph;
+}
+
+ImFontGlyphCache::ImFontGlyphCache()
+{
+    Data = NULL;
+}
+
+ImFontGlyphCache::~ImFontGlyphCache()
+{
+    Detach();
+}
+
+bool ImFontGlyphCache::IsAttached() const
+{
+    return Data != NULL && ImFontGlyphCacheIsValid(Data);
+}
+
+bool ImFontGlyphCache::Attach(ImFontAtlas* atlas, ImFont* font, const ImWchar* lazy_ranges, int cache_height, int pages, int max_glyphs)
+{
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL && "Call atlas->Build() first.");
+    IM_ASSERT(font->ContainerAtlas == atlas && lazy_ranges != NULL);
+    IM_ASSERT(cache_height > 0 && pages > 0 && pages <= IM_FONT_GLYPH_CACHE_MAX_PAGES && max_glyphs > 0);
+    Detach();
+    if (atlas->TexPixelsAlpha8 == NULL || font->ContainerAtlas != atlas || font->Glyphs.Size + max_glyphs >= 0xFFFF)
+        return false;
+    int registry_n = 0;
+    while (registry_n < IM_FONT_GLYPH_CACHE_MAX && GImFontGlyphCaches[registry_n] != NULL)
+        registry_n++;
+    IM_ASSERT(registry_n < IM_FONT_GLYPH_CACHE_MAX && "Too many glyph caches attached at the same time.");
+    if (registry_n == IM_FONT_GLYPH_CACHE_MAX)
+        return false;
+
+    ImFontGlyphCacheData* cache = IM_NEW(ImFontGlyphCacheData)();
+    cache->Atlas = atlas;
+    cache->Font = font;
+    for (int cfg_i = 0; cfg_i < atlas->ConfigData.Size; cfg_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[cfg_i];
+        if (cfg.DstFont != font || cfg.FontData == NULL)
+            continue;
+        ImFontGlyphCacheSource src;
+        memset(&src, 0, sizeof(src));
+        src.Config = &cfg;
+        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+        if (font_offset < 0 || !stbtt_InitFont(&src.FontInfo, (unsigned char*)cfg.FontData, font_offset))
+            continue;
+        src.Scale = stbtt_ScaleForPixelHeight(&src.FontInfo, cfg.SizePixels);
+        cache->Sources.push_back(src);
+    }
+    if (cache->Sources.Size == 0)
+    {
+        IM_DELETE(cache);
+        return false;
+    }
+
+    // Grow the texture. Heights stay powers of two unless the atlas asks otherwise, so rescaling V is exact.
+    const int old_height = atlas->TexHeight;
+    int new_height = old_height + cache_height;
+    if (!(atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight))
+        new_height = ImUpperPowerOfTwo(new_height);
+    const size_t old_pixels = (size_t)atlas->TexWidth * old_height;
+    const size_t new_pixels = (size_t)atlas->TexWidth * new_height;
+    unsigned char* alpha8 = (unsigned char*)IM_ALLOC(new_pixels);
+    memcpy(alpha8, atlas->TexPixelsAlpha8, old_pixels);
+    memset(alpha8 + old_pixels, 0, new_pixels - old_pixels);
+    IM_FREE(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = alpha8;
+    if (atlas->TexPixelsRGBA32)
+    {
+        unsigned int* rgba32 = (unsigned int*)IM_ALLOC(new_pixels * 4);
+        memcpy(rgba32, atlas->TexPixelsRGBA32, old_pixels * 4);
+        for (size_t n = old_pixels; n < new_pixels; n++)
+            rgba32[n] = IM_COL32(255, 255, 255, 0);
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = rgba32;
+    }
+    const float v_scale = (float)old_height / (float)new_height;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        for (int glyph_n = 0; glyph_n < atlas->Fonts[font_n]->Glyphs.Size; glyph_n++)
+        {
+            ImFontGlyph& glyph = atlas->Fonts[font_n]->Glyphs[glyph_n];
+            glyph.V0 *= v_scale;
+            glyph.V1 *= v_scale;
+        }
+    atlas->TexHeight = new_height;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel.y *= v_scale;
+    cache->AtlasPixels = atlas->TexPixelsAlpha8;
+    cache->AtlasHeight = atlas->TexHeight;
+
+    // Pages split the new rows evenly
+    const int band_height = new_height - old_height;
+    pages = ImMin(pages, band_height);
+    cache->Pages.resize(pages);
+    memset(cache->Pages.Data, 0, (size_t)cache->Pages.size_in_bytes());
+    for (int page_n = 0; page_n < pages; page_n++)
+    {
+        ImFontGlyphCachePage& page = cache->Pages[page_n];
+        page.Y = old_height + band_height * page_n / pages;
+        page.Height = old_height + band_height * (page_n + 1) / pages - page.Y;
+        page.LastUsedFrame = -1;
+        page.Nodes.resize(atlas->TexWidth);
+        stbrp_init_target(&page.Packer, atlas->TexWidth, page.Height, page.Nodes.Data, page.Nodes.Size);
+    }
+
+    // Mark lazy codepoints and give them their real advance, so layout does not depend on what is resident
+    int lazy_highest = 0;
+    for (const ImWchar* range = lazy_ranges; range[0] && range[1]; range += 2)
+        lazy_highest = ImMax(lazy_highest, (int)range[1]);
+    const int old_index_size = font->IndexLookup.Size;
+    font->GrowIndex(lazy_highest + 1);
+    for (int n = old_index_size; n < font->IndexAdvanceX.Size; n++)
+        font->IndexAdvanceX[n] = font->FallbackAdvanceX;
+    cache->Lazy.Resize(font->IndexLookup.Size);
+    for (const ImWchar* range = lazy_ranges; range[0] && range[1]; range += 2)
+        for (unsigned int c = range[0]; c <= range[1]; c++)
+        {
+            int glyph_index = 0;
+            if (font->IndexLookup[c] != (ImWchar)-1 || cache->Lazy.GetBit(c))
+                continue;
+            if (const ImFontGlyphCacheSource* src = ImFontGlyphCacheFindSource(cache, (ImWchar)c, &glyph_index))
+            {
+                cache->Lazy.SetBit(c, true);
+                font->IndexAdvanceX[c] = ImFontGlyphCacheCalcAdvance(font, *src, glyph_index, NULL);
+            }
+        }
+    cache->Slot.resize(font->IndexLookup.Size, IM_FONT_GLYPH_CACHE_NO_SLOT);
+    cache->FirstSlot = font->Glyphs.Size;
+    cache->MaxGlyphs = max_glyphs;
+    cache->SlotPage.resize(max_glyphs);
+    font->Glyphs.reserve(font->Glyphs.Size + max_glyphs);
+    font->FallbackGlyph = font->FindGlyphNoFallback(font->FallbackChar);   // reserve() moved the glyphs
+
+    GImFontGlyphCaches[registry_n] = cache;
+    GImFontGlyphCachesCount++;
+    GImFontGeneration++;
+    Data = cache;
+    return true;
+}
+
+void ImFontGlyphCache::Detach()
+{
+    ImFontGlyphCacheData* cache = Data;
+    if (cache == NULL)
+        return;
+    if (IsAttached())
+    {
+        ImFont* font = cache->Font;
+        for (int c = 0; c < cache->Slot.Size; c++)
+            if (cache->Lazy.GetBit(c))
+            {
+                font->IndexLookup[c] = (ImWchar)-1;
+                font->IndexAdvanceX[c] = font->FallbackAdvanceX;
+            }
+        font->Glyphs.resize(cache->FirstSlot);
+    }
+    for (int n = 0; n < IM_FONT_GLYPH_CACHE_MAX; n++)
+        if (GImFontGlyphCaches[n] == cache)
+        {
+            GImFontGlyphCaches[n] = NULL;
+            GImFontGlyphCachesCount--;
+            GImFontGeneration++;
+        }
+    for (int page_n = 0; page_n < cache->Pages.Size; page_n++)
+        cache->Pages[page_n].~ImFontGlyphCachePage();
+    cache->Pages.clear();
+    IM_DELETE(cache);
+    Data = NULL;
+}
+
+void ImFontGlyphCache::NewFrame()
+{
+    if (Data == NULL)
+        return;
+    if (!IsAttached())
+    {
+        Detach();
+        return;
+    }
+    ImFont* font = Data->Font;
+    for (int n = 0; n < Data->Touched.Size; n++)
+        font->IndexLookup[Data->Touched[n]] = (ImWchar)-1;
+    Data->Touched.resize(0);
+    Data->Frame++;
+}
+
+bool ImFontGlyphCache::GetDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const
+{
+    if (Data == NULL || Data->DirtyX1 <= Data->DirtyX0)
+        return false;
+    *out_x = Data->DirtyX0;
+    *out_y = Data->DirtyY0;
+    *out_w = Data->DirtyX1 - Data->DirtyX0;
+    *out_h = Data->DirtyY1 - Data->DirtyY0;
+    return true;
+}
+
+void ImFontGlyphCache::ClearDirtyRect()
+{
+    if (Data == NULL)
+        return;
+    Data->Stats.PixelsUploaded += ImMax(Data->DirtyX1 - Data->DirtyX0, 0) * ImMax(Data->DirtyY1 - Data->DirtyY0, 0);
+    Data->DirtyX0 = Data->DirtyY0 = Data->DirtyX1 = Data->DirtyY1 = 0;
+}
+
+const ImFontGlyphCacheStats& ImFontGlyphCache::GetStats() const
+{
+    static const ImFontGlyphCacheStats empty_stats = {};
+    return Data ? Data->Stats : empty_stats;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImTextLayoutCache
+//-----------------------------------------------------------------------------
+// An entry is created without a copy of the text the first time a (font, size, wrap width, text) key is seen. When
+// the key is seen again in a later frame the entry keeps a copy of the text. CalcTextSizeA() then fills in the size the
+// first time it asks, and RenderText() the run. A run holds one ImU32 op per glyph, newline or wrap that the
+// RenderText() loop would process: the kind in the top 2 bits and the glyph index + 1 below. Replaying the ops with the
+// drawing half of that loop produces the same vertices, because RenderText() only calls the word wrapper at the start
+// of a line (where x == pos.x), so the break positions do not depend on where the text is drawn.
+//-----------------------------------------------------------------------------
+
+#define IM_TEXT_LAYOUT_OP_GLYPH         (0u << 30)  // Glyph with a quad
+#define IM_TEXT_LAYOUT_OP_BLANK         (1u << 30)  // Space or tab: advance only
+#define IM_TEXT_LAYOUT_OP_NEWLINE       (2u << 30)
+#define IM_TEXT_LAYOUT_OP_WRAP          (3u << 30)
+#define IM_TEXT_LAYOUT_OP_KIND_MASK     (3u << 30)
+#define IM_TEXT_LAYOUT_OP_GLYPH_MASK    ((1u << 30) - 1)
+
+struct ImTextLayoutEntry
+{
+    ImU64               Hash;
+    const ImFont*       Font;
+    float               Size;
+    float               WrapWidth;          // 0.0f for every non-wrapping call
+    int                 TextLen;
+    int                 FirstFrame, LastFrame;
+    char*               Text;               // NULL until the key is seen in a second frame
+    const ImFontGlyph*  FontGlyphs;         // The font's tables when Text was set. Another ImGui build sharing the atlas may rebuild the font behind our back.
+    const ImWchar*      FontIndexLookup;
+    const float*        FontIndexAdvanceX;
+    int                 FontGlyphsCount, FontIndexCount;
+    float               FontSize;
+    bool                HasSize;
+    ImVec2              TextSize;
+    int                 RemainingOffset;
+    ImU32*              Ops;                // NULL until RenderText() asks
+    int                 OpsCount;
+};
+
+struct ImTextLayoutCacheData
+{
+    ImVector<ImTextLayoutEntry> Entries;    // Reserved up front, never reallocated
+    ImVector<int>       Index;              // Open addressing into Entries, -1 = empty. Power of two, at least twice MaxEntries
+    ImVector<ImU32>     ScratchOps;
+    int                 MaxEntries, MaxAge;
+    int                 Frame;
+    unsigned int        Generation;
+    ImTextLayoutCacheStats Stats;
+
+    ImTextLayoutCacheData() { MaxEntries = MaxAge = Frame = 0; Generation = 0; memset(&Stats, 0, sizeof(Stats)); }
+};
+
+static ImU64 ImTextLayoutHash(const char* text, int text_len, ImU64 seed)
+{
+    const ImU64 PRIME = 0x9E3779B97F4A7C15ull;
+    ImU64 h = seed ^ ((ImU64)text_len * PRIME);
+    const char* p = text;
+    const char* p_end = text + text_len;
+    for (; p + 8 <= p_end; p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        h = (h ^ k) * PRIME;
+        h ^= h >> 29;
+    }
+    ImU64 tail = 0;
+    memcpy(&tail, p, (size_t)(p_end - p));
+    h = (h ^ tail) * PRIME;
+    h ^= h >> 32;
+    h *= PRIME;
+    h ^= h >> 29;
+    return h;
+}
+
+static void ImTextLayoutEntryClearLayout(ImTextLayoutCacheData* cache, ImTextLayoutEntry* entry)
+{
+    if (entry->Text)
+    {
+        cache->Stats.Bytes -= (size_t)entry->TextLen;
+        IM_FREE(entry->Text);
+        entry->Text = NULL;
+    }
+    if (entry->Ops)
+    {
+        cache->Stats.Bytes -= (size_t)entry->OpsCount * sizeof(ImU32);
+        IM_FREE(entry->Ops);
+        entry->Ops = NULL;
+    }
+    entry->OpsCount = 0;
+    entry->HasSize = false;
+}
+
+static void ImTextLayoutCacheRebuildIndex(ImTextLayoutCacheData* cache)
+{
+    memset(cache->Index.Data, 0xFF, (size_t)cache->Index.size_in_bytes());
+    const int mask = cache->Index.Size - 1;
+    for (int n = 0; n < cache->Entries.Size; n++)
+    {
+        int slot = (int)(cache->Entries[n].Hash & (ImU64)mask);
+        while (cache->Index[slot] != -1)
+            slot = (slot + 1) & mask;
+        cache->Index[slot] = n;
+    }
+    cache->Stats.Entries = cache->Entries.Size;
+}
+
+static void ImTextLayoutCacheFlush(ImTextLayoutCacheData* cache)
+{
+    for (int n = 0; n < cache->Entries.Size; n++)
+        ImTextLayoutEntryClearLayout(cache, &cache->Entries[n]);
+    cache->Entries.resize(0);
+    ImTextLayoutCacheRebuildIndex(cache);
+}
+
+static bool ImTextLayoutEntryMatchesFont(const ImTextLayoutEntry* entry, const ImFont* font)
+{
+    return entry->FontGlyphs == font->Glyphs.Data && entry->FontGlyphsCount == font->Glyphs.Size
+        && entry->FontIndexLookup == font->IndexLookup.Data && entry->FontIndexAdvanceX == font->IndexAdvanceX.Data
+        && entry->FontIndexCount == font->IndexLookup.Size && entry->FontSize == font->FontSize;
+}
+
+// Returns an entry holding a copy of the text, or NULL when the caller must run the uncached code
+static ImTextLayoutEntry* ImTextLayoutCacheFind(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    ImTextLayoutCacheData* cache = GImTextLayoutCache;
+    const int text_len = (int)(text_end - text_begin);
+    if (text_len <= 0 || text_len > IM_TEXT_LAYOUT_CACHE_MAX_TEXT || !(size > 0.0f) || GImFontGlyphCachesCount > 0)
+        return NULL;
+    if (cache->Generation != GImFontGeneration)
+    {
+        ImTextLayoutCacheFlush(cache);
+        cache->Generation = GImFontGeneration;
+        cache->Stats.Flushes++;
+    }
+
+    // Every wrap_width <= 0.0f (or NaN) means no wrapping: CalcTextSize() passes -1.0f, AddText() 0.0f
+    if (!(wrap_width > 0.0f))
+        wrap_width = 0.0f;
+    ImU32 size_bits, wrap_bits;
+    memcpy(&size_bits, &size, sizeof(float));
+    memcpy(&wrap_bits, &wrap_width, sizeof(float));
+    const ImU64 hash = ImTextLayoutHash(text_begin, text_len, ((ImU64)(size_t)font * 0x9E3779B97F4A7C15ull) ^ (((ImU64)size_bits << 32) | wrap_bits));
+
+    const int mask = cache->Index.Size - 1;
+    int slot = (int)(hash & (ImU64)mask);
+    for (; cache->Index[slot] != -1; slot = (slot + 1) & mask)
+    {
+        ImTextLayoutEntry* entry = &cache->Entries[cache->Index[slot]];
+        if (entry->Hash != hash || entry->Font != font || entry->Size != size || entry->WrapWidth != wrap_width || entry->TextLen != text_len)
+            continue;
+        if (entry->Text != NULL && memcmp(entry->Text, text_begin, (size_t)text_len) != 0)
+            continue;
+
+        entry->LastFrame = cache->Frame;
+        if (entry->Text != NULL && !ImTextLayoutEntryMatchesFont(entry, font))
+        {
+            ImTextLayoutEntryClearLayout(cache, entry);
+            entry->FirstFrame = cache->Frame;
+            cache->Stats.Evictions++;
+        }
+        if (entry->Text == NULL)
+        {
+            if (entry->FirstFrame == cache->Frame)
+                return NULL;
+            entry->Text = (char*)IM_ALLOC((size_t)text_len);
+            memcpy(entry->Text, text_begin, (size_t)text_len);
+            cache->Stats.Bytes += (size_t)text_len;
+            entry->FontGlyphs = font->Glyphs.Data;
+            entry->FontGlyphsCount = font->Glyphs.Size;
+            entry->FontIndexLookup = font->IndexLookup.Data;
+            entry->FontIndexAdvanceX = font->IndexAdvanceX.Data;
+            entry->FontIndexCount = font->IndexLookup.Size;
+            entry->FontSize = font->FontSize;
+        }
+        return entry;
+    }
+
+    // First sighting: remember the key only, so that text changing every frame costs no copy
+    if (cache->Entries.Size >= cache->MaxEntries)
+        return NULL;
+    cache->Index[slot] = cache->Entries.Size;
+    cache->Entries.resize(cache->Entries.Size + 1);
+    ImTextLayoutEntry* entry = &cache->Entries.back();
+    memset(entry, 0, sizeof(*entry));
+    entry->Hash = hash;
+    entry->Font = font;
+    entry->Size = size;
+    entry->WrapWidth = wrap_width;
+    entry->TextLen = text_len;
+    entry->FirstFrame = entry->LastFrame = cache->Frame;
+    cache->Stats.Entries = cache->Entries.Size;
+    return NULL;
+}
+
+static bool ImTextLayoutCacheCalcTextSize(const ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVec2* out_size)
+{
+    ImTextLayoutCacheData* cache = GImTextLayoutCache;
+    ImTextLayoutEntry* entry = ImTextLayoutCacheFind(font, size, wrap_width, text_begin, text_end);
+    if (entry == NULL)
+    {
+        cache->Stats.Misses++;
+        return false;
+    }
+    if (!entry->HasSize)
+    {
+        // Run the uncached code once
+        const char* entry_remaining = NULL;
+        GImTextLayoutCache = NULL;
+        entry->TextSize = font->CalcTextSizeA(size, FLT_MAX, wrap_width, text_begin, text_end, &entry_remaining);
+        GImTextLayoutCache = cache;
+        entry->RemainingOffset = (int)(entry_remaining - text_begin);
+        entry->HasSize = true;
+        cache->Stats.Misses++;
+    }
+    else
+    {
+        cache->Stats.Hits++;
+    }
+    if (remaining)
+        *remaining = text_begin + entry->RemainingOffset;
+    *out_size = entry->TextSize;
+    return true;
+}
+
+// The ImFont::RenderText() loop without the drawing
+static void ImTextLayoutShape(const ImFont* font, float scale, const char* text_begin, const char* text_end, float wrap_width, ImVector<ImU32>* out_ops)
+{
+    out_ops->resize(0);
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            if (!word_wrap_eol)
+            {
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width);
+                if (word_wrap_eol == s)
+                    word_wrap_eol++;
+            }
+
+            if (s >= word_wrap_eol)
+            {
+                out_ops->push_back(IM_TEXT_LAYOUT_OP_WRAP);
+                word_wrap_eol = NULL;
+
+                // Wrapping skips upcoming blanks
+                while (s < text_end)
+                {
+                    const char c = *s;
+                    if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+                }
+                continue;
+            }
+        }
+
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0) // Malformed UTF-8?
+                break;
+        }
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                out_ops->push_back(IM_TEXT_LAYOUT_OP_NEWLINE);
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        // No glyph: RenderText() adds an advance of 0.0f, which cannot change x
+        if (const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c))
+            out_ops->push_back(((c != ' ' && c != '\t') ? IM_TEXT_LAYOUT_OP_GLYPH : IM_TEXT_LAYOUT_OP_BLANK) | (ImU32)(glyph - font->Glyphs.Data + 1));
+    }
+}
+
+static bool ImTextLayoutCacheRenderText(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
+{
+    ImTextLayoutCacheData* cache = GImTextLayoutCache;
+    ImTextLayoutEntry* entry = ImTextLayoutCacheFind(font, size, wrap_width, text_begin, text_end);
+    if (entry == NULL)
+    {
+        cache->Stats.Misses++;
+        return false;
+    }
+
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    if (entry->Ops == NULL)
+    {
+        ImTextLayoutShape(font, scale, text_begin, text_end, wrap_width, &cache->ScratchOps);
+        entry->OpsCount = cache->ScratchOps.Size;
+        entry->Ops = (ImU32*)IM_ALLOC((size_t)ImMax(entry->OpsCount, 1) * sizeof(ImU32));
+        memcpy(entry->Ops, cache->ScratchOps.Data, (size_t)entry->OpsCount * sizeof(ImU32));
+        cache->Stats.Bytes += (size_t)entry->OpsCount * sizeof(ImU32);
+        cache->Stats.Misses++;
+    }
+    else
+    {
+        cache->Stats.Hits++;
+    }
+
+    // Same reservation as RenderText(): PrimReserve() may start a new draw command depending on the count
+    float x = pos.x;
+    float y = pos.y;
+    const int vtx_count_max = (int)(text_end - text_begin) * 4;
+    const int idx_count_max = (int)(text_end - text_begin) * 6;
+    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    const ImFontGlyph* glyphs = font->Glyphs.Data;
+    for (const ImU32* op = entry->Ops, *op_end = entry->Ops + entry->OpsCount; op < op_end; op++)
+    {
+        const ImU32 kind = *op & IM_TEXT_LAYOUT_OP_KIND_MASK;
+        if (kind == IM_TEXT_LAYOUT_OP_WRAP)
+        {
+            x = pos.x;
+            y += line_height;
+            continue;
+        }
+        if (kind == IM_TEXT_LAYOUT_OP_NEWLINE)
+        {
+            x = pos.x;
+            y += line_height;
+            if (y > clip_rect.w)
+                break; // break out of main loop
+            continue;
+        }
+
+        const ImFontGlyph* glyph = &glyphs[(*op & IM_TEXT_LAYOUT_OP_GLYPH_MASK) - 1];
+        const float char_width = glyph->AdvanceX * scale;
+        if (kind == IM_TEXT_LAYOUT_OP_GLYPH)
+        {
+            float x1 = x + glyph->X0 * scale;
+            float x2 = x + glyph->X1 * scale;
+            float y1 = y + glyph->Y0 * scale;
+            float y2 = y + glyph->Y1 * scale;
+            if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+            {
+                float u1 = glyph->U0;
+                float v1 = glyph->V0;
+                float u2 = glyph->U1;
+                float v2 = glyph->V1;
+
+                if (cpu_fine_clip)
+                {
+                    if (x1 < clip_rect.x)
+                    {
+                        u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+                        x1 = clip_rect.x;
+                    }
+                    if (y1 < clip_rect.y)
+                    {
+                        v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+                        y1 = clip_rect.y;
+                    }
+                    if (x2 > clip_rect.z)
+                    {
+                        u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+                        x2 = clip_rect.z;
+                    }
+                    if (y2 > clip_rect.w)
+                    {
+                        v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+                        y2 = clip_rect.w;
+                    }
+                    if (y1 >= y2)
+                    {
+                        x += char_width;
+                        continue;
+                    }
+                }
+
+                idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                vtx_write += 4;
+                vtx_current_idx += 4;
+                idx_write += 6;
+            }
+        }
+        x += char_width;
+    }
+
+    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data);
+    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+    return true;
+}
+
+void ImTextLayoutCacheSetEnabled(bool enabled, int max_entries, int max_age)
+{
+    if (GImTextLayoutCache != NULL)
+    {
+        ImTextLayoutCacheFlush(GImTextLayoutCache);
+        IM_DELETE(GImTextLayoutCache);
+        GImTextLayoutCache = NULL;
+    }
+    if (!enabled)
+        return;
+
+    IM_ASSERT(max_entries > 0 && max_age > 0);
+    ImTextLayoutCacheData* cache = IM_NEW(ImTextLayoutCacheData)();
+    cache->MaxEntries = max_entries;
+    cache->MaxAge = max_age;
+    cache->Generation = GImFontGeneration;
+    cache->Entries.reserve(max_entries);
+    int index_size = 16;
+    while (index_size < max_entries * 2)
+        index_size <<= 1;
+    cache->Index.resize(index_size, -1);
+    GImTextLayoutCache = cache;
+}
+
+bool ImTextLayoutCacheIsEnabled()
+{
+    return GImTextLayoutCache != NULL;
+}
+
+void ImTextLayoutCacheNewFrame(int frame_count)
+{
+    ImTextLayoutCacheData* cache = GImTextLayoutCache;
+    if (cache == NULL || cache->Frame == frame_count)
+        return;
+    cache->Frame = frame_count;
+
+    // Keys seen in one frame only are kept for the next frame only
+    int dst_n = 0;
+    for (int n = 0; n < cache->Entries.Size; n++)
+    {
+        ImTextLayoutEntry& entry = cache->Entries[n];
+        if (frame_count - entry.LastFrame > (entry.Text ? cache->MaxAge : 1))
+        {
+            if (entry.Text)
+                cache->Stats.Evictions++;
+            ImTextLayoutEntryClearLayout(cache, &entry);
+            continue;
+        }
+        cache->Entries[dst_n++] = entry;
+    }
+    if (dst_n != cache->Entries.Size)
+    {
+        cache->Entries.resize(dst_n);
+        ImTextLayoutCacheRebuildIndex(cache);
+    }
+}
+
+void ImTextLayoutCacheClear()
+{
+    if (GImTextLayoutCache != NULL)
+        ImTextLayoutCacheFlush(GImTextLayoutCache);
+}
+
+const ImTextLayoutCacheStats& ImTextLayoutCacheGetStats()
+{
+    static const ImTextLayoutCacheStats empty_stats = {};
+    return GImTextLayoutCache ? GImTextLayoutCache->Stats : empty_stats;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Internal Render Helpers
 // (progressively moved from imgui.cpp to here when they are redesigned to stop accessing ImGui global state)
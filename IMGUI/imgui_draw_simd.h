@@ -0,0 +1,245 @@
+// Batched vertex math for ImDrawList::AddPolyline() and AddConvexPolyFilled().
+//
+// The per-point work of those two functions (segment normals, averaged and "fixed" miter normals, fringe
+// points) is done here several points at a time. The instruction set is picked at compile time:
+//   AVX      when the translation unit is built with AVX enabled (/arch:AVX, /arch:AVX2, -mavx, -mavx2), 8 points per step
+//   SSE2     on x64 and on x86 built with SSE2 (the default for MSVC), 4 points per step
+//   NEON     on AArch64, 4 points per step
+//   scalar   otherwise, or when IMGUI_DISABLE_DRAW_SIMD is defined in imconfig.h
+// Every backend performs the same IEEE operations in the same order as upstream's scalar code (no FMA, no
+// reciprocal estimates), so the vertices are bit-identical as long as the compiler does not contract or
+// reorder the scalar code either (/fp:fast, -ffast-math, -ffp-contract=fast on FMA targets).
+
+#pragma once
+#include "imgui.h"
+
+#if !defined(IMGUI_DISABLE_DRAW_SIMD) && defined(__AVX__)
+#define IMGUI_DRAW_SIMD_AVX 1
+#include <immintrin.h>
+#elif !defined(IMGUI_DISABLE_DRAW_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_DRAW_SIMD_SSE 1
+#include <emmintrin.h>
+#elif !defined(IMGUI_DISABLE_DRAW_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define IMGUI_DRAW_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ImDrawSimd
+{
+    // Each backend provides W lanes of float math plus loads/stores of W consecutive ImVec2 split into x and y.
+    struct ScalarOps
+    {
+        typedef float V;
+        typedef bool M;
+        static const int W = 1;
+        static inline V Set1(float f)                { return f; }
+        static inline V Add(V a, V b)                { return a + b; }
+        static inline V Sub(V a, V b)                { return a - b; }
+        static inline V Mul(V a, V b)                { return a * b; }
+        static inline V Div(V a, V b)                { return a / b; }
+        static inline V Sqrt(V a)                    { return ImSqrt(a); }
+        static inline V Neg(V a)                     { return -a; }
+        static inline V AtLeast(V a, V lo)           { return a < lo ? lo : a; }
+        static inline M GreaterThan(V a, V b)        { return a > b; }
+        static inline V Select(M m, V a, V b)        { return m ? a : b; }
+        static inline void Load(const ImVec2* p, V& x, V& y) { x = p->x; y = p->y; }
+        static inline void Store(ImVec2* p, V x, V y)       { p->x = x; p->y = y; }
+    };
+
+#if IMGUI_DRAW_SIMD_AVX
+    struct SimdOps
+    {
+        typedef __m256 V;
+        typedef __m256 M;
+        static const int W = 8;
+        static inline V Set1(float f)                { return _mm256_set1_ps(f); }
+        static inline V Add(V a, V b)                { return _mm256_add_ps(a, b); }
+        static inline V Sub(V a, V b)                { return _mm256_sub_ps(a, b); }
+        static inline V Mul(V a, V b)                { return _mm256_mul_ps(a, b); }
+        static inline V Div(V a, V b)                { return _mm256_div_ps(a, b); }
+        static inline V Sqrt(V a)                    { return _mm256_sqrt_ps(a); }
+        static inline V Neg(V a)                     { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+        static inline V AtLeast(V a, V lo)           { return _mm256_max_ps(a, lo); }
+        static inline M GreaterThan(V a, V b)        { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static inline V Select(M m, V a, V b)        { return _mm256_blendv_ps(b, a, m); }
+        // Shuffles stay within 128-bit lanes, so x/y come out as points 0 1 4 5 | 2 3 6 7. Store() undoes the same
+        // permutation, and everything in between is per-lane, so results land back on the right points.
+        static inline void Load(const ImVec2* p, V& x, V& y)
+        {
+            const __m256 a = _mm256_loadu_ps(&p[0].x);
+            const __m256 b = _mm256_loadu_ps(&p[4].x);
+            x = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            y = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        static inline void Store(ImVec2* p, V x, V y)
+        {
+            _mm256_storeu_ps(&p[0].x, _mm256_unpacklo_ps(x, y));
+            _mm256_storeu_ps(&p[4].x, _mm256_unpackhi_ps(x, y));
+        }
+    };
+#elif IMGUI_DRAW_SIMD_SSE
+    struct SimdOps
+    {
+        typedef __m128 V;
+        typedef __m128 M;
+        static const int W = 4;
+        static inline V Set1(float f)                { return _mm_set1_ps(f); }
+        static inline V Add(V a, V b)                { return _mm_add_ps(a, b); }
+        static inline V Sub(V a, V b)                { return _mm_sub_ps(a, b); }
+        static inline V Mul(V a, V b)                { return _mm_mul_ps(a, b); }
+        static inline V Div(V a, V b)                { return _mm_div_ps(a, b); }
+        static inline V Sqrt(V a)                    { return _mm_sqrt_ps(a); }
+        static inline V Neg(V a)                     { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+        static inline V AtLeast(V a, V lo)           { return _mm_max_ps(a, lo); }
+        static inline M GreaterThan(V a, V b)        { return _mm_cmpgt_ps(a, b); }
+        static inline V Select(M m, V a, V b)        { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        static inline void Load(const ImVec2* p, V& x, V& y)
+        {
+            const __m128 a = _mm_loadu_ps(&p[0].x);
+            const __m128 b = _mm_loadu_ps(&p[2].x);
+            x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        static inline void Store(ImVec2* p, V x, V y)
+        {
+            _mm_storeu_ps(&p[0].x, _mm_unpacklo_ps(x, y));
+            _mm_storeu_ps(&p[2].x, _mm_unpackhi_ps(x, y));
+        }
+    };
+#elif IMGUI_DRAW_SIMD_NEON
+    struct SimdOps
+    {
+        typedef float32x4_t V;
+        typedef uint32x4_t M;
+        static const int W = 4;
+        static inline V Set1(float f)                { return vdupq_n_f32(f); }
+        static inline V Add(V a, V b)                { return vaddq_f32(a, b); }
+        static inline V Sub(V a, V b)                { return vsubq_f32(a, b); }
+        static inline V Mul(V a, V b)                { return vmulq_f32(a, b); }
+        static inline V Div(V a, V b)                { return vdivq_f32(a, b); }
+        static inline V Sqrt(V a)                    { return vsqrtq_f32(a); }
+        static inline V Neg(V a)                     { return vnegq_f32(a); }
+        static inline V AtLeast(V a, V lo)           { return vbslq_f32(vcltq_f32(a, lo), lo, a); }
+        static inline M GreaterThan(V a, V b)        { return vcgtq_f32(a, b); }
+        static inline V Select(M m, V a, V b)        { return vbslq_f32(m, a, b); }
+        static inline void Load(const ImVec2* p, V& x, V& y) { const float32x4x2_t v = vld2q_f32(&p->x); x = v.val[0]; y = v.val[1]; }
+        static inline void Store(ImVec2* p, V x, V y)       { float32x4x2_t v; v.val[0] = x; v.val[1] = y; vst2q_f32(&p->x, v); }
+    };
+#else
+    typedef ScalarOps SimdOps;
+#endif
+
+    static inline const char* BackendName()
+    {
+#if IMGUI_DRAW_SIMD_AVX
+        return "avx";
+#elif IMGUI_DRAW_SIMD_SSE
+        return "sse2";
+#elif IMGUI_DRAW_SIMD_NEON
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+
+    // out[i] = unit normal (dy, -dx) of segment points[i] -> points[i+1], for i in [0, n). Zero-length segments give (0, -0).
+    template<typename O>
+    static inline int SegmentNormalsSteps(const ImVec2* points, int n, ImVec2* out)
+    {
+        typedef typename O::V V;
+        const V zero = O::Set1(0.0f), one = O::Set1(1.0f);
+        int i = 0;
+        for (; i + O::W <= n; i += O::W)
+        {
+            V x0, y0, x1, y1;
+            O::Load(points + i, x0, y0);
+            O::Load(points + i + 1, x1, y1);
+            V dx = O::Sub(x1, x0);
+            V dy = O::Sub(y1, y0);
+            const V d2 = O::Add(O::Mul(dx, dx), O::Mul(dy, dy));
+            const typename O::M nonzero = O::GreaterThan(d2, zero);
+            const V inv_len = O::Div(one, O::Sqrt(d2));
+            dx = O::Select(nonzero, O::Mul(dx, inv_len), dx);
+            dy = O::Select(nonzero, O::Mul(dy, inv_len), dy);
+            O::Store(out + i, dy, O::Neg(dx));
+        }
+        return i;
+    }
+
+    // Miter offset at point i from the normals of the segments on either side, nrm_prev[i] and nrm_next[i]:
+    // dm = fixnormal((nrm_prev + nrm_next) * 0.5). Writes points[i] + dm * scale[k] to out[k][i] for each of the
+    // SCALES output arrays, for i in [0, n).
+    template<typename O, int SCALES>
+    static inline int FringeSteps(const ImVec2* points, const ImVec2* nrm_prev, const ImVec2* nrm_next, int n, const float* scale, ImVec2* const* out)
+    {
+        typedef typename O::V V;
+        const V half = O::Set1(0.5f), one = O::Set1(1.0f);
+        V s[SCALES];
+        for (int k = 0; k < SCALES; k++)
+            s[k] = O::Set1(scale[k]);
+        int i = 0;
+        for (; i + O::W <= n; i += O::W)
+        {
+            V ax, ay, bx, by, px, py;
+            O::Load(nrm_prev + i, ax, ay);
+            O::Load(nrm_next + i, bx, by);
+            O::Load(points + i, px, py);
+            V dm_x = O::Mul(O::Add(ax, bx), half);
+            V dm_y = O::Mul(O::Add(ay, by), half);
+            const V d2 = O::AtLeast(O::Add(O::Mul(dm_x, dm_x), O::Mul(dm_y, dm_y)), half);
+            const V inv_lensq = O::Div(one, d2);
+            dm_x = O::Mul(dm_x, inv_lensq);
+            dm_y = O::Mul(dm_y, inv_lensq);
+            for (int k = 0; k < SCALES; k++)
+                O::Store(out[k] + i, O::Add(px, O::Mul(dm_x, s[k])), O::Add(py, O::Mul(dm_y, s[k])));
+        }
+        return i;
+    }
+
+    template<typename O>
+    static inline void SegmentNormals(const ImVec2* points, int n, ImVec2* out)
+    {
+        const int done = SegmentNormalsSteps<O>(points, n, out);
+        SegmentNormalsSteps<ScalarOps>(points + done, n - done, out + done);
+    }
+
+    template<typename O, int SCALES>
+    static inline void Fringe(const ImVec2* points, const ImVec2* nrm_prev, const ImVec2* nrm_next, int n, const float* scale, ImVec2* const* out)
+    {
+        const int done = FringeSteps<O, SCALES>(points, nrm_prev, nrm_next, n, scale, out);
+        ImVec2* tail[SCALES];
+        for (int k = 0; k < SCALES; k++)
+            tail[k] = out[k] + done;
+        FringeSteps<ScalarOps, SCALES>(points + done, nrm_prev + done, nrm_next + done, n - done, scale, tail);
+    }
+
+    // normals[i] for the segment leaving points[i]. Closed: the last one wraps to points[0]. Open: the last point
+    // repeats the previous normal.
+    template<typename O>
+    static inline void PolyNormals(const ImVec2* points, int points_count, bool closed, ImVec2* normals)
+    {
+        SegmentNormals<O>(points, points_count - 1, normals);
+        if (closed)
+        {
+            const ImVec2 wrap[2] = { points[points_count - 1], points[0] };
+            SegmentNormalsSteps<ScalarOps>(wrap, 1, normals + points_count - 1);
+        }
+        else
+        {
+            normals[points_count - 1] = normals[points_count - 2];
+        }
+    }
+
+    // Fringe points for points 1..points_count-1, and for point 0 as well when the shape is closed (its previous
+    // segment is the wrapping one). Open shapes write their own caps for point 0.
+    template<typename O, int SCALES>
+    static inline void PolyFringe(const ImVec2* points, int points_count, bool closed, const ImVec2* normals, const float* scale, ImVec2* const* out)
+    {
+        ImVec2* from1[SCALES];
+        for (int k = 0; k < SCALES; k++)
+            from1[k] = out[k] + 1;
+        Fringe<O, SCALES>(points + 1, normals, normals + 1, points_count - 1, scale, from1);
+        if (closed)
+            FringeSteps<ScalarOps, SCALES>(points, normals + points_count - 1, normals, 1, scale, out);
+    }
+}
@@ -0,0 +1,398 @@
+#include "pch.h"
+#include "imgui_font_cache.h"
+#include "imgui_internal.h"
+#include <stdio.h>      // rename, remove
+#include <string.h>     // memcpy, memset
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// File layout (native endianness, every section 64-byte aligned):
+//   ImFontAtlasCacheHeader
+//   TexWidth * TexHeight alpha pixels
+//   ImFontAtlasCacheFont[FontsCount]
+//   ImFontGlyph[GlyphsCount]                   all fonts' glyphs, in font order
+//   ImFontAtlasCacheRect[CustomRectsCount]     packed positions of atlas->CustomRects
+// Checksum covers everything after the header.
+
+#define IM_FONT_ATLAS_CACHE_VERSION     1
+#define IM_FONT_ATLAS_CACHE_ALIGN       64
+
+static const char IM_FONT_ATLAS_CACHE_MAGIC[8] = { 'I', 'M', 'F', 'A', 'T', 'L', 'A', 'S' };
+
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[8];
+    ImU32       Version;
+    ImU32       HeaderSize;
+    ImU64       Key;
+    ImU64       Checksum;
+    ImU64       FileSize;
+    ImS32       TexWidth, TexHeight;
+    float       TexUvWhitePixel[2];
+    ImS32       FontsCount, GlyphsCount, CustomRectsCount;
+    ImS32       Reserved;
+    ImU64       PixelsOffset, FontsOffset, GlyphsOffset, RectsOffset;
+};
+
+struct ImFontAtlasCacheFont
+{
+    ImS32       ConfigIndex;                    // Into atlas->ConfigData, or -1 if Build() left the font unloaded
+    ImS32       ConfigDataCount;
+    ImS32       GlyphsCount;
+    ImS32       MetricsTotalSurface;
+    float       FontSize, Ascent, Descent;
+    ImU32       EllipsisChar;
+};
+
+struct ImFontAtlasCacheRect
+{
+    ImU16       X, Y;
+};
+
+//-----------------------------------------------------------------------------
+// Hashing: 8 bytes per step. Fonts are hashed on every start, so this has to be cheap for multi-MB CJK fonts.
+//-----------------------------------------------------------------------------
+
+static inline ImU64 ImFontCacheRotl(ImU64 v, int r) { return (v << r) | (v >> (64 - r)); }
+
+static ImU64 ImFontCacheHash(const void* data, size_t size, ImU64 seed)
+{
+    const ImU64 PRIME1 = 0x9E3779B185EBCA87ull, PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* p_end = p + size;
+    ImU64 h = seed ^ ((ImU64)size * PRIME1);
+    for (; p + 8 <= p_end; p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        h ^= ImFontCacheRotl(k * PRIME2, 31) * PRIME1;
+        h = ImFontCacheRotl(h, 27) * PRIME1 + PRIME2;
+    }
+    ImU64 tail = 0;
+    for (int shift = 0; p < p_end; p++, shift += 8)
+        tail |= (ImU64)*p << shift;
+    h ^= ImFontCacheRotl(tail * PRIME2, 31) * PRIME1;
+    h ^= h >> 33; h *= PRIME2;
+    h ^= h >> 29; h *= PRIME1;
+    h ^= h >> 32;
+    return h;
+}
+
+template<typename T>
+static ImU64 ImFontCacheHashValue(ImU64 h, const T& v) { return ImFontCacheHash(&v, sizeof(v), h); }
+
+ImU64 ImFontAtlasCacheKey(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+
+    ImU64 h = ImFontCacheHash(IMGUI_VERSION, strlen(IMGUI_VERSION), IM_FONT_ATLAS_CACHE_VERSION);
+    h = ImFontCacheHashValue(h, (ImU32)sizeof(ImFontGlyph));
+    h = ImFontCacheHashValue(h, (ImU32)sizeof(ImWchar));
+    h = ImFontCacheHashValue(h, (ImS32)atlas->Flags);
+    h = ImFontCacheHashValue(h, atlas->TexDesiredWidth);
+    h = ImFontCacheHashValue(h, atlas->TexGlyphPadding);
+    for (int cfg_i = 0; cfg_i < atlas->ConfigData.Size; cfg_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[cfg_i];
+        h = ImFontCacheHash(cfg.FontData, cfg.FontData ? (size_t)cfg.FontDataSize : 0, h);
+        h = ImFontCacheHashValue(h, cfg.FontNo);
+        h = ImFontCacheHashValue(h, cfg.SizePixels);
+        h = ImFontCacheHashValue(h, cfg.OversampleH);
+        h = ImFontCacheHashValue(h, cfg.OversampleV);
+        h = ImFontCacheHashValue(h, (ImU8)cfg.PixelSnapH);
+        h = ImFontCacheHashValue(h, cfg.GlyphExtraSpacing.x);
+        h = ImFontCacheHashValue(h, cfg.GlyphExtraSpacing.y);
+        h = ImFontCacheHashValue(h, cfg.GlyphOffset.x);
+        h = ImFontCacheHashValue(h, cfg.GlyphOffset.y);
+        h = ImFontCacheHashValue(h, cfg.GlyphMinAdvanceX);
+        h = ImFontCacheHashValue(h, cfg.GlyphMaxAdvanceX);
+        h = ImFontCacheHashValue(h, (ImU8)cfg.MergeMode);
+        h = ImFontCacheHashValue(h, cfg.RasterizerFlags);
+        h = ImFontCacheHashValue(h, cfg.RasterizerMultiply);
+        h = ImFontCacheHashValue(h, cfg.EllipsisChar);
+        h = ImFontCacheHashValue(h, (ImS32)atlas->Fonts.index_from_ptr(atlas->Fonts.find(cfg.DstFont)));
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        const ImWchar* ranges_end = ranges;
+        while (ranges_end[0] && ranges_end[1])
+            ranges_end += 2;
+        h = ImFontCacheHash(ranges, (size_t)(ranges_end - ranges) * sizeof(ImWchar), h);
+    }
+    for (int rect_i = 0; rect_i < atlas->CustomRects.Size; rect_i++)
+    {
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[rect_i];
+        h = ImFontCacheHashValue(h, r.ID);
+        h = ImFontCacheHashValue(h, r.Width);
+        h = ImFontCacheHashValue(h, r.Height);
+        h = ImFontCacheHashValue(h, r.GlyphAdvanceX);
+        h = ImFontCacheHashValue(h, r.GlyphOffset.x);
+        h = ImFontCacheHashValue(h, r.GlyphOffset.y);
+        h = ImFontCacheHashValue(h, (ImS32)(r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1));
+    }
+    return h;
+}
+
+//-----------------------------------------------------------------------------
+// Read-only file mapping
+//-----------------------------------------------------------------------------
+
+struct ImFontCacheMapping
+{
+    const unsigned char*    Data;
+    size_t                  Size;
+#ifdef _WIN32
+    HANDLE                  File, Mapping;
+#endif
+};
+
+static bool ImFontCacheMap(ImFontCacheMapping* m, const char* filename)
+{
+    memset(m, 0, sizeof(*m));
+#ifdef _WIN32
+    m->File = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m->File == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m->File, &size) || size.QuadPart < (LONGLONG)sizeof(ImFontAtlasCacheHeader)
+        || (m->Mapping = CreateFileMappingA(m->File, NULL, PAGE_READONLY, 0, 0, NULL)) == NULL)
+    {
+        CloseHandle(m->File);
+        return false;
+    }
+    m->Data = (const unsigned char*)MapViewOfFile(m->Mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m->Data == NULL)
+    {
+        CloseHandle(m->Mapping);
+        CloseHandle(m->File);
+        return false;
+    }
+    m->Size = (size_t)size.QuadPart;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ImFontAtlasCacheHeader))
+    {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    m->Data = (const unsigned char*)data;
+    m->Size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+static void ImFontCacheUnmap(ImFontCacheMapping* m)
+{
+    if (m->Data == NULL)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m->Data);
+    CloseHandle(m->Mapping);
+    CloseHandle(m->File);
+#else
+    munmap((void*)m->Data, m->Size);
+#endif
+    m->Data = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Load / Save
+//-----------------------------------------------------------------------------
+
+static inline size_t ImFontCacheAlign(size_t offset) { return (offset + IM_FONT_ATLAS_CACHE_ALIGN - 1) & ~(size_t)(IM_FONT_ATLAS_CACHE_ALIGN - 1); }
+
+static bool ImFontCacheSectionValid(const ImFontAtlasCacheHeader& hdr, ImU64 offset, ImU64 count, size_t elem_size)
+{
+    return offset >= sizeof(hdr) && offset % IM_FONT_ATLAS_CACHE_ALIGN == 0 && offset <= hdr.FileSize && count <= (hdr.FileSize - offset) / elem_size;
+}
+
+bool ImFontAtlasCacheLoad(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(atlas->ConfigData.Size > 0);
+    const ImU64 key = ImFontAtlasCacheKey(atlas);
+
+    ImFontCacheMapping m;
+    if (!ImFontCacheMap(&m, filename))
+        return false;
+    ImFontAtlasCacheHeader hdr;
+    memcpy(&hdr, m.Data, sizeof(hdr));
+    bool ok = memcmp(hdr.Magic, IM_FONT_ATLAS_CACHE_MAGIC, sizeof(hdr.Magic)) == 0 && hdr.Version == IM_FONT_ATLAS_CACHE_VERSION && hdr.HeaderSize == sizeof(hdr)
+        && hdr.Key == key && hdr.FileSize == m.Size && hdr.FontsCount == atlas->Fonts.Size && hdr.CustomRectsCount == atlas->CustomRects.Size
+        && hdr.TexWidth > 0 && hdr.TexHeight > 0 && hdr.GlyphsCount >= 0
+        && ImFontCacheSectionValid(hdr, hdr.PixelsOffset, (ImU64)hdr.TexWidth * (ImU64)hdr.TexHeight, 1)
+        && ImFontCacheSectionValid(hdr, hdr.FontsOffset, (ImU64)hdr.FontsCount, sizeof(ImFontAtlasCacheFont))
+        && ImFontCacheSectionValid(hdr, hdr.GlyphsOffset, (ImU64)hdr.GlyphsCount, sizeof(ImFontGlyph))
+        && ImFontCacheSectionValid(hdr, hdr.RectsOffset, (ImU64)hdr.CustomRectsCount, sizeof(ImFontAtlasCacheRect))
+        && ImFontCacheHash(m.Data + sizeof(hdr), m.Size - sizeof(hdr), hdr.Key) == hdr.Checksum;
+
+    // Validate the per-font records before touching the atlas
+    const ImFontAtlasCacheFont* src_fonts = (const ImFontAtlasCacheFont*)(m.Data + hdr.FontsOffset);
+    int glyphs_total = 0;
+    for (int font_i = 0; ok && font_i < hdr.FontsCount; font_i++)
+    {
+        const ImFontAtlasCacheFont& f = src_fonts[font_i];
+        ok = f.GlyphsCount >= 0 && f.GlyphsCount <= hdr.GlyphsCount - glyphs_total && f.ConfigIndex >= -1 && f.ConfigIndex < atlas->ConfigData.Size
+            && (f.ConfigIndex < 0 || atlas->ConfigData[f.ConfigIndex].DstFont == atlas->Fonts[font_i]);
+        glyphs_total += f.GlyphsCount;
+    }
+    if (!ok || glyphs_total != hdr.GlyphsCount)
+    {
+        ImFontCacheUnmap(&m);
+        return false;
+    }
+
+    // Same end state as ImFontAtlasBuildWithStbTruetype()
+    atlas->TexID = (ImTextureID)NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = hdr.TexWidth;
+    atlas->TexHeight = hdr.TexHeight;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel = ImVec2(hdr.TexUvWhitePixel[0], hdr.TexUvWhitePixel[1]);
+    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)atlas->TexWidth * atlas->TexHeight);
+    memcpy(atlas->TexPixelsAlpha8, m.Data + hdr.PixelsOffset, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+    const ImFontGlyph* src_glyphs = (const ImFontGlyph*)(m.Data + hdr.GlyphsOffset);
+    for (int font_i = 0; font_i < hdr.FontsCount; font_i++)
+    {
+        const ImFontAtlasCacheFont& f = src_fonts[font_i];
+        ImFont* font = atlas->Fonts[font_i];
+        font->ClearOutputData();
+        font->ConfigDataCount = 0;
+        if (f.ConfigIndex >= 0)
+        {
+            font->FontSize = f.FontSize;
+            font->ConfigData = &atlas->ConfigData[f.ConfigIndex];
+            font->ConfigDataCount = (short)f.ConfigDataCount;
+            font->ContainerAtlas = atlas;
+            font->Ascent = f.Ascent;
+            font->Descent = f.Descent;
+            font->EllipsisChar = (ImWchar)f.EllipsisChar;
+            font->Glyphs.resize(f.GlyphsCount);
+            if (f.GlyphsCount > 0)
+                memcpy(font->Glyphs.Data, src_glyphs, (size_t)f.GlyphsCount * sizeof(ImFontGlyph));
+            font->BuildLookupTable();
+            font->MetricsTotalSurface = f.MetricsTotalSurface;
+        }
+        src_glyphs += f.GlyphsCount;
+    }
+    const ImFontAtlasCacheRect* src_rects = (const ImFontAtlasCacheRect*)(m.Data + hdr.RectsOffset);
+    for (int rect_i = 0; rect_i < hdr.CustomRectsCount; rect_i++)
+    {
+        atlas->CustomRects[rect_i].X = src_rects[rect_i].X;
+        atlas->CustomRects[rect_i].Y = src_rects[rect_i].Y;
+    }
+    ImFontCacheUnmap(&m);
+    return true;
+}
+
+bool ImFontAtlasCacheSave(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL && "Call Build() first.");
+    for (int cfg_i = 0; cfg_i < atlas->ConfigData.Size; cfg_i++)
+        if (atlas->ConfigData[cfg_i].FontData == NULL)
+            return false;   // ClearInputData() was called: the key can no longer be computed
+    if (atlas->TexPixelsAlpha8 == NULL)
+        return false;
+
+    ImFontAtlasCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.Magic, IM_FONT_ATLAS_CACHE_MAGIC, sizeof(hdr.Magic));
+    hdr.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    hdr.HeaderSize = sizeof(hdr);
+    hdr.Key = ImFontAtlasCacheKey(atlas);
+    hdr.TexWidth = atlas->TexWidth;
+    hdr.TexHeight = atlas->TexHeight;
+    hdr.TexUvWhitePixel[0] = atlas->TexUvWhitePixel.x;
+    hdr.TexUvWhitePixel[1] = atlas->TexUvWhitePixel.y;
+    hdr.FontsCount = atlas->Fonts.Size;
+    hdr.CustomRectsCount = atlas->CustomRects.Size;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+        hdr.GlyphsCount += atlas->Fonts[font_i]->IsLoaded() ? atlas->Fonts[font_i]->Glyphs.Size : 0;
+    hdr.PixelsOffset = ImFontCacheAlign(sizeof(hdr));
+    hdr.FontsOffset = ImFontCacheAlign((size_t)hdr.PixelsOffset + (size_t)hdr.TexWidth * hdr.TexHeight);
+    hdr.GlyphsOffset = ImFontCacheAlign((size_t)hdr.FontsOffset + (size_t)hdr.FontsCount * sizeof(ImFontAtlasCacheFont));
+    hdr.RectsOffset = ImFontCacheAlign((size_t)hdr.GlyphsOffset + (size_t)hdr.GlyphsCount * sizeof(ImFontGlyph));
+    hdr.FileSize = hdr.RectsOffset + (ImU64)hdr.CustomRectsCount * sizeof(ImFontAtlasCacheRect);
+
+    // Build the whole file in memory (zeroed, so padding bytes are deterministic), then write it in one go
+    unsigned char* buf = (unsigned char*)IM_ALLOC((size_t)hdr.FileSize);
+    if (buf == NULL)
+        return false;
+    memset(buf, 0, (size_t)hdr.FileSize);
+    memcpy(buf + hdr.PixelsOffset, atlas->TexPixelsAlpha8, (size_t)hdr.TexWidth * hdr.TexHeight);
+    ImFontAtlasCacheFont* dst_fonts = (ImFontAtlasCacheFont*)(buf + hdr.FontsOffset);
+    ImFontGlyph* dst_glyphs = (ImFontGlyph*)(buf + hdr.GlyphsOffset);
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        const ImFont* font = atlas->Fonts[font_i];
+        ImFontAtlasCacheFont& f = dst_fonts[font_i];
+        f.ConfigIndex = font->IsLoaded() ? atlas->ConfigData.index_from_ptr(font->ConfigData) : -1;
+        if (f.ConfigIndex < 0)
+            continue;
+        f.ConfigDataCount = font->ConfigDataCount;
+        f.GlyphsCount = font->Glyphs.Size;
+        f.MetricsTotalSurface = font->MetricsTotalSurface;
+        f.FontSize = font->FontSize;
+        f.Ascent = font->Ascent;
+        f.Descent = font->Descent;
+        f.EllipsisChar = font->EllipsisChar;
+        for (int glyph_i = 0; glyph_i < font->Glyphs.Size; glyph_i++, dst_glyphs++)
+        {
+            const ImFontGlyph& src = font->Glyphs[glyph_i];
+            dst_glyphs->Codepoint = src.Codepoint;
+            dst_glyphs->AdvanceX = src.AdvanceX;
+            dst_glyphs->X0 = src.X0; dst_glyphs->Y0 = src.Y0; dst_glyphs->X1 = src.X1; dst_glyphs->Y1 = src.Y1;
+            dst_glyphs->U0 = src.U0; dst_glyphs->V0 = src.V0; dst_glyphs->U1 = src.U1; dst_glyphs->V1 = src.V1;
+        }
+    }
+    ImFontAtlasCacheRect* dst_rects = (ImFontAtlasCacheRect*)(buf + hdr.RectsOffset);
+    for (int rect_i = 0; rect_i < atlas->CustomRects.Size; rect_i++)
+    {
+        dst_rects[rect_i].X = atlas->CustomRects[rect_i].X;
+        dst_rects[rect_i].Y = atlas->CustomRects[rect_i].Y;
+    }
+    hdr.Checksum = ImFontCacheHash(buf + sizeof(hdr), (size_t)hdr.FileSize - sizeof(hdr), hdr.Key);
+    memcpy(buf, &hdr, sizeof(hdr));
+
+    // Write next to the target and rename, so a crash or a concurrent reader never sees a partial file
+    char tmp_filename[1024];
+    ImFormatString(tmp_filename, IM_ARRAYSIZE(tmp_filename), "%s.tmp", filename);
+    bool ok = false;
+    if (ImFileHandle f = ImFileOpen(tmp_filename, "wb"))
+    {
+        ok = ImFileWrite(buf, 1, hdr.FileSize, f) == hdr.FileSize;
+        ok = ImFileClose(f) && ok;
+    }
+    IM_FREE(buf);
+#ifdef _WIN32
+    ok = ok && MoveFileExA(tmp_filename, filename, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    ok = ok && rename(tmp_filename, filename) == 0;
+#endif
+    if (!ok)
+        remove(tmp_filename);
+    return ok;
+}
+
+bool ImFontAtlasBuildCached(ImFontAtlas* atlas, const char* filename)
+{
+    if (ImFontAtlasCacheLoad(atlas, filename))
+        return true;
+    if (!atlas->Build())
+        return false;
+    ImFontAtlasCacheSave(atlas, filename);
+    return true;
+}
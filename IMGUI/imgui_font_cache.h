@@ -0,0 +1,30 @@
+// Prebuilt font atlas cache.
+//
+// ImFontAtlas::Build() rasterizes every glyph with stb_truetype on each start. ImFontAtlasBuildCached() instead looks for
+// a cache file written by an earlier build with the same inputs, and fills the atlas from it: texture pixels, glyph
+// tables and custom rectangle positions. stb_truetype does not run at all on a hit.
+//
+//   ImFontAtlas* atlas = ...;                              // AddFont*() and AddCustomRect*() calls as usual
+//   char path[512];
+//   ImFormatString(path, sizeof(path), "%s/fonts-%016llx.bin", cache_dir, (unsigned long long)ImFontAtlasCacheKey(atlas));
+//   ImFontAtlasBuildCached(atlas, path);                  // Instead of atlas->Build()
+//
+// - The key covers what the output depends on: the bytes of every font, FontNo, size, glyph ranges and the other
+//   ImFontConfig build fields, atlas flags, TexDesiredWidth, TexGlyphPadding, custom rectangles, the file format
+//   version and the ImGui version/struct sizes. A file with another key, a bad checksum or a truncated payload is
+//   ignored (the atlas is then built and the file rewritten).
+// - The file is mapped read-only and its sections are 64-byte aligned, so it is usable in place. ImFontAtlas owns and
+//   frees its buffers, so pixels and glyphs are still copied out of the mapping: one memcpy each instead of rasterizing.
+// - The result is identical to Build(): same pixels, glyphs, lookup tables and custom rectangle positions.
+// - The file holds the texture as Build() leaves it. Applications that draw into custom rectangles after Build() do the
+//   same after ImFontAtlasBuildCached().
+// - Library only: MatchAdminHotkeys draws with the host's atlas and never builds one, so imgui_font_cache.cpp is not part
+//   of the plugin project. Add it to a build that owns its ImFontAtlas.
+
+#pragma once
+#include "imgui.h"
+
+IMGUI_API ImU64     ImFontAtlasCacheKey(ImFontAtlas* atlas);                        // Registers ImGui's default custom rectangle first, as Build() does
+IMGUI_API bool      ImFontAtlasCacheLoad(ImFontAtlas* atlas, const char* filename); // Returns false (atlas untouched) if the file is missing, stale or damaged
+IMGUI_API bool      ImFontAtlasCacheSave(ImFontAtlas* atlas, const char* filename); // After Build(). Writes a temporary file and renames it over 'filename'
+IMGUI_API bool      ImFontAtlasBuildCached(ImFontAtlas* atlas, const char* filename);   // Load, or Build() then Save
@@ -0,0 +1,62 @@
+// On-demand glyph rasterization for fonts with large ranges (CJK).
+//
+// ImFontAtlas::Build() rasterizes every glyph of every requested range up front. For GetGlyphRangesChineseFull() that is
+// tens of thousands of glyphs and a texture of several MB, of which a screen shows a few hundred. ImFontGlyphCache
+// instead builds the atlas with a small base range, then adds a band of texture rows where the glyphs of the remaining
+// ("lazy") ranges are rasterized the first time ImFont::FindGlyph() asks for them:
+//
+//   ImFontConfig cfg;                                      // Keep the font data alive: the cache reads it later
+//   ImFont* font = atlas->AddFontFromFileTTF("NotoSansCJK.ttc", 18.0f, &cfg, atlas->GetGlyphRangesDefault());
+//   atlas->Build();
+//   static ImFontGlyphCache cache;
+//   cache.Attach(atlas, font, atlas->GetGlyphRangesChineseFull());
+//   // upload the whole texture once, then every frame:
+//   cache.NewFrame();
+//   ... ImGui::NewFrame() / widgets / ImGui::Render() ...
+//   if (cache.GetDirtyRect(&x, &y, &w, &h)) { upload that sub-rectangle of atlas->TexPixelsAlpha8 (or RGBA32); cache.ClearDirtyRect(); }
+//
+// - Advances of lazy glyphs are set in IndexAdvanceX at attach time, so CalcTextSize() and wrapping are the same as with
+//   an eager build before any glyph was drawn. Glyph quads and advances match an eager build exactly; only UVs differ.
+// - The band is split into pages, each packed with stb_rect_pack. When no page has room, the least recently used page
+//   is cleared. Pages holding a glyph used in the current frame are never cleared: that glyph shows as the fallback
+//   character until the next frame.
+// - Only ImFont::FindGlyph() rasterizes (RenderText(), RenderChar()). FindGlyphNoFallback() reports lazy glyphs that
+//   are not resident as missing.
+// - No ImGui structure changes layout, so this can be used with a context shared with another ImGui build, but only for
+//   fonts of an atlas the plugin owns and uploads. A rebuild of the atlas detaches the cache (call Attach() again).
+// - Not thread-safe: call from the thread that runs ImGui.
+
+#pragma once
+#include "imgui.h"
+
+struct ImFontGlyphCacheData;
+
+struct ImFontGlyphCacheStats
+{
+    int     GlyphsResident;         // Lazy glyphs currently in the texture
+    int     GlyphsRasterized;       // Total rasterizations (including glyphs rasterized again after an eviction)
+    int     GlyphsEvicted;
+    int     PagesEvicted;
+    int     GlyphsDeferred;         // Requests answered with the fallback glyph because every page was in use this frame
+    int     PixelsUploaded;         // Pixels in the dirty rectangles released with ClearDirtyRect()
+};
+
+struct ImFontGlyphCache
+{
+    IMGUI_API ImFontGlyphCache();
+    IMGUI_API ~ImFontGlyphCache();
+
+    // Call after atlas->Build() and before creating the texture. Grows the texture by at least 'cache_height' rows and
+    // splits them into 'pages' pages. Glyphs of 'lazy_ranges' that the font does not have yet become lazy.
+    // 'max_glyphs' bounds the resident lazy glyphs (ImFont::Glyphs is reserved up front). Returns false on failure.
+    IMGUI_API bool  Attach(ImFontAtlas* atlas, ImFont* font, const ImWchar* lazy_ranges, int cache_height = 512, int pages = 4, int max_glyphs = 2048);
+    IMGUI_API void  Detach();           // Lazy glyphs become missing glyphs again. The texture keeps its size.
+    IMGUI_API bool  IsAttached() const;
+
+    IMGUI_API void  NewFrame();         // Call once per frame before drawing. Usage of the previous frame decides what is evicted.
+    IMGUI_API bool  GetDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const;    // Texture area written since the last ClearDirtyRect()
+    IMGUI_API void  ClearDirtyRect();                                                       // Call after uploading it
+    IMGUI_API const ImFontGlyphCacheStats& GetStats() const;
+
+    ImFontGlyphCacheData* Data;
+};
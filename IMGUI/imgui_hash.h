@@ -0,0 +1,209 @@
+// ID hashing backends for ImHashData()/ImHashStr().
+//
+// Selected at compile time in imconfig.h:
+//   (default)            CRC32, slicing-by-8. Bit-identical to upstream's byte-wise CRC32.
+//   IMGUI_HASH_CRC32C    CRC32C, SSE4.2 crc32 instruction when the CPU has it (checked at runtime), sliced table otherwise.
+//   IMGUI_HASH_WORDS     8-bytes-at-a-time multiply/xor hash with a 64->32 bit finalizer.
+//
+// Only the default produces the same IDs as other ImGui builds. The plugin draws into BakkesMod's context, whose
+// .ini settings and other plugins look windows up by ImHashStr(name) computed with upstream CRC32, so the other
+// backends are only safe in a context the plugin owns (tools, tests).
+//
+// All backends keep the "label###id" rule: hashing restarts from the seed at the last "###" in the string.
+
+#pragma once
+#include "imgui.h"
+#include <stddef.h>     // size_t
+#include <stdint.h>     // uint64_t
+#include <string.h>     // memcpy, memchr, strlen
+
+#if defined(__SSE4_2__) || defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IMGUI_HASH_HAS_X86 1
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace ImHashImpl
+{
+    struct SlicedTable { ImU32 T[8][256]; };
+
+    // Reflected CRC tables for slicing-by-8, built at compile time so they are usable from static constructors.
+    constexpr SlicedTable MakeSlicedTable(ImU32 poly)
+    {
+        SlicedTable t = {};
+        for (ImU32 i = 0; i < 256; i++)
+        {
+            ImU32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? (c >> 1) ^ poly : (c >> 1);
+            t.T[0][i] = c;
+        }
+        for (ImU32 i = 0; i < 256; i++)
+            for (int s = 1; s < 8; s++)
+                t.T[s][i] = (t.T[s - 1][i] >> 8) ^ t.T[0][t.T[s - 1][i] & 0xFF];
+        return t;
+    }
+
+    static constexpr SlicedTable Crc32Table = MakeSlicedTable(0xEDB88320u);
+    static constexpr SlicedTable Crc32cTable = MakeSlicedTable(0x82F63B78u);
+
+    static inline ImU32 Load32(const unsigned char* p) { ImU32 v; memcpy(&v, p, 4); return v; }
+    static inline uint64_t Load64(const unsigned char* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+
+    // Running (pre-inverted) CRC over [p, end). Little-endian loads; all supported targets are little-endian.
+    static inline ImU32 SlicedUpdate(const SlicedTable& tab, ImU32 crc, const unsigned char* p, const unsigned char* end)
+    {
+        const ImU32 (*t)[256] = tab.T;
+        while (end - p >= 8)
+        {
+            const ImU32 lo = Load32(p) ^ crc;
+            const ImU32 hi = Load32(p + 4);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+        }
+        if (end - p >= 4) // PushID(int) and most label tails
+        {
+            const ImU32 v = Load32(p) ^ crc;
+            crc = t[3][v & 0xFF] ^ t[2][(v >> 8) & 0xFF] ^ t[1][(v >> 16) & 0xFF] ^ t[0][v >> 24];
+            p += 4;
+        }
+        while (p < end)
+            crc = (crc >> 8) ^ t[0][(crc & 0xFF) ^ *p++];
+        return crc;
+    }
+
+#if IMGUI_HASH_HAS_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("sse4.2")))
+#endif
+    static inline ImU32 Crc32cHwUpdate(ImU32 crc, const unsigned char* p, const unsigned char* end)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        uint64_t c64 = crc;
+        while (end - p >= 8) { c64 = _mm_crc32_u64(c64, Load64(p)); p += 8; }
+        crc = (ImU32)c64;
+#endif
+        while (end - p >= 4) { crc = _mm_crc32_u32(crc, Load32(p)); p += 4; }
+        while (p < end) crc = _mm_crc32_u8(crc, *p++);
+        return crc;
+    }
+
+    static inline bool CpuHasSse42()
+    {
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+        return (regs[2] & (1 << 20)) != 0;
+#else
+        return __builtin_cpu_supports("sse4.2");
+#endif
+    }
+    // Read as false by hashes run from static constructors before this is initialized; the table path gives the same result.
+    static const bool HasSse42 = CpuHasSse42();
+#endif
+
+    static inline ImU32 Crc32cUpdate(ImU32 crc, const unsigned char* p, const unsigned char* end)
+    {
+#if IMGUI_HASH_HAS_X86
+        if (HasSse42)
+            return Crc32cHwUpdate(crc, p, end);
+#endif
+        return SlicedUpdate(Crc32cTable, crc, p, end);
+    }
+
+    // Word-at-a-time: FNV-style xor/multiply on 64-bit lanes, tail packed into one last word, then a murmur3
+    // finalizer so every input bit reaches the low 32 bits. The running state is the 32-bit result so far,
+    // which keeps seeding and chaining (PushID) the same as for the CRCs.
+    static inline ImU32 WordsUpdate(ImU32 h32, const unsigned char* p, const unsigned char* end)
+    {
+        const uint64_t prime = 0x100000001B3ull;
+        uint64_t h = (0xCBF29CE484222325ull ^ h32) * prime;
+        while (end - p >= 8)
+        {
+            h = (h ^ Load64(p)) * prime;
+            h ^= h >> 29;
+            p += 8;
+        }
+        uint64_t tail = (uint64_t)(end - p) << 56;
+        for (int s = 0; p < end; s += 8)
+            tail |= (uint64_t)*p++ << s;
+        h = (h ^ tail) * prime;
+        h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return (ImU32)h;
+    }
+
+    // Start of the part of [p, end) that is hashed: the last "###" (which is itself hashed), or p if there is none.
+    static inline const unsigned char* LastTripleHash(const unsigned char* p, const unsigned char* end)
+    {
+        const unsigned char* from = p;
+        const unsigned char* q = p;
+        while (end - q >= 3)
+        {
+            q = (const unsigned char*)memchr(q, '#', (size_t)(end - q - 2));
+            if (!q)
+                break;
+            if (q[1] == '#' && q[2] == '#')
+                from = q;
+            q++;
+        }
+        return from;
+    }
+
+    // Backend dispatch. 'state' is the backend's running value: inverted for the CRCs, plain for WORDS.
+    template<int BACKEND> struct Backend;
+
+    template<> struct Backend<0>
+    {
+        static ImU32 Begin(ImU32 seed) { return ~seed; }
+        static ImU32 Update(ImU32 s, const unsigned char* p, const unsigned char* e) { return SlicedUpdate(Crc32Table, s, p, e); }
+        static ImU32 End(ImU32 s) { return ~s; }
+    };
+    template<> struct Backend<1>
+    {
+        static ImU32 Begin(ImU32 seed) { return ~seed; }
+        static ImU32 Update(ImU32 s, const unsigned char* p, const unsigned char* e) { return Crc32cUpdate(s, p, e); }
+        static ImU32 End(ImU32 s) { return ~s; }
+    };
+    template<> struct Backend<2>
+    {
+        static ImU32 Begin(ImU32 seed) { return seed; }
+        static ImU32 Update(ImU32 s, const unsigned char* p, const unsigned char* e) { return WordsUpdate(s, p, e); }
+        static ImU32 End(ImU32 s) { return s; }
+    };
+
+    template<int BACKEND>
+    static inline ImU32 HashData(const void* data, size_t size, ImU32 seed)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        return Backend<BACKEND>::End(Backend<BACKEND>::Update(Backend<BACKEND>::Begin(seed), p, p + size));
+    }
+
+    template<int BACKEND>
+    static inline ImU32 HashStr(const char* data, size_t size, ImU32 seed)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        const unsigned char* end = p + (size != 0 ? size : strlen(data));
+        p = LastTripleHash(p, end);
+        return Backend<BACKEND>::End(Backend<BACKEND>::Update(Backend<BACKEND>::Begin(seed), p, end));
+    }
+}
+
+enum ImHashBackend_
+{
+    ImHashBackend_Crc32 = 0,
+    ImHashBackend_Crc32c = 1,
+    ImHashBackend_Words = 2,
+};
+
+#if defined(IMGUI_HASH_CRC32C)
+#define IMGUI_HASH_BACKEND ImHashBackend_Crc32c
+#elif defined(IMGUI_HASH_WORDS)
+#define IMGUI_HASH_BACKEND ImHashBackend_Words
+#else
+#define IMGUI_HASH_BACKEND ImHashBackend_Crc32
+#endif
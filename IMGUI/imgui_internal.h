@@ -1874,6 +1874,7 @@ IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas,
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void              ImFontAtlasBuildSetThreadCount(int count);  // Threads rasterizing glyphs in ImFontAtlasBuildWithStbTruetype(). 0 = automatic (default), 1 = no worker threads.
 
 // Debug Tools
 // Use 'Metrics->Tools->Item Picker' to break into the call-stack of a specific item.
@@ -1,6 +1,15 @@
 #include "pch.h"
 #include "imgui_searchablecombo.h"
 #include "imgui_internal.h"
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SEARCHABLECOMBO_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 static float CalcMaxPopupHeightFromItemCount(int items_count)
 {
@@ -157,7 +166,7 @@ void ImGui::EndSearchableCombo()
 
 /* Modified version of Combo from imgui.cpp at line 9343,
  * to include a input field to be able to filter the combo values. */
-bool ImGui::SearchableCombo(const char* label, int* current_item, std::vector<std::string> items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items)
+bool ImGui::SearchableCombo(const char* label, int* current_item, const std::vector<std::string>& items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items, const char* no_match_text)
 {
     ImGuiContext& g = *GImGui;
 
@@ -178,29 +187,26 @@ bool ImGui::SearchableCombo(const char* label, int* current_item, std::vector<st
     if (!BeginSearchableCombo(label, preview_text, input_buffer, input_size, input_preview_value, ImGuiComboFlags_None))
         return false;
 
+    // Lowercase the query once; items are compared case-insensitively in place.
+    std::string input(input_buffer);
+    std::transform(input.begin(), input.end(), input.begin(),
+        [](unsigned char c) { return (unsigned char)std::tolower(c); });
+    auto equals_lower = [](char a, char b) { return (char)std::tolower((unsigned char)a) == b; };
+
     // Display items
     // FIXME-OPT: Use clipper (but we need to disable it on the appearing frame to make sure our call to SetItemDefaultFocus() is processed)
     int matched_items = 0;
     bool value_changed = false;
     for (int i = 0; i < (int)items.size(); i++)
     {
-        char buffer[input_size] = "";
-        ImStrncpy(buffer, input_buffer, input_size);
-        std::string input(buffer);
-        std::string item = items[i];
-
-        std::transform(item.begin(), item.end(), item.begin(),
-            [](unsigned char c) { return (unsigned char)std::tolower(c); });
-        std::transform(input.begin(), input.end(), input.begin(),
-            [](unsigned char c) { return (unsigned char)std::tolower(c); });
-
-        if (item.find(input, 0) == std::string::npos)
+        const std::string& item = items[i];
+        if (std::search(item.begin(), item.end(), input.begin(), input.end(), equals_lower) == item.end())
             continue;
 
         matched_items++;
         PushID((void*)(intptr_t)i);
         const bool item_selected = (i == *current_item);
-        const char* item_text = items[i].c_str();
+        const char* item_text = item.c_str();
         if (Selectable(item_text, item_selected))
         {
             value_changed = true;
@@ -211,9 +217,366 @@ bool ImGui::SearchableCombo(const char* label, int* current_item, std::vector<st
         PopID();
     }
     if (matched_items == 0)
-        ImGui::Selectable("No maps found", false, ImGuiSelectableFlags_Disabled);
+        ImGui::Selectable(no_match_text, false, ImGuiSelectableFlags_Disabled);
+
+    EndSearchableCombo();
+
+    return value_changed;
+}
+
+static inline int CharMaskBit(unsigned char c)
+{
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 26 + (c - '0');
+    return 36 + (c % 28);
+}
+
+static inline uint64_t CharMask(const char* p, const char* end)
+{
+    uint64_t mask = 0;
+    for (; p < end; p++)
+        mask |= 1ull << CharMaskBit((unsigned char)*p);
+    return mask;
+}
+
+static inline int CountTrailingZeros(unsigned int v)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+// First occurrence of c in [p, end), or end.
+static inline const char* FindChar(const char* p, const char* end, char c)
+{
+#ifdef SEARCHABLECOMBO_SSE2
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; p + 16 <= end; p += 16)
+    {
+        const int hits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), needle));
+        if (hits != 0)
+            return p + CountTrailingZeros((unsigned int)hits);
+    }
+#endif
+    for (; p < end; p++)
+        if (*p == c)
+            return p;
+    return end;
+}
+
+static inline uint32_t TrigramKey(const char* p)
+{
+    return (uint32_t)(unsigned char)p[0] | ((uint32_t)(unsigned char)p[1] << 8) | ((uint32_t)(unsigned char)p[2] << 16);
+}
+
+void SearchableComboIndex::SetItems(std::vector<std::string> items)
+{
+    Items = std::move(items);
+    Lower.clear();
+    LowerOffsets.clear();
+    LowerOffsets.reserve(Items.size() + 1);
+    for (const std::string& item : Items)
+    {
+        LowerOffsets.push_back((int)Lower.size());
+        for (char c : item)
+            Lower.push_back((char)std::tolower((unsigned char)c));
+    }
+    LowerOffsets.push_back((int)Lower.size());
+
+    // Posting lists in CSR form: one sort over (trigram, item) pairs, no per-key allocations.
+    std::vector<std::pair<uint32_t, int>> pairs;
+    pairs.reserve(Lower.size());
+    for (int i = 0; i < (int)Items.size(); i++)
+        for (int p = LowerOffsets[i]; p + 3 <= LowerOffsets[i + 1]; p++)
+            pairs.emplace_back(TrigramKey(&Lower[p]), i);
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    TrigramKeys.clear();
+    TrigramStarts.clear();
+    TrigramItems.clear();
+    TrigramItems.reserve(pairs.size());
+    for (size_t n = 0; n < pairs.size(); n++)
+    {
+        if (n == 0 || pairs[n].first != pairs[n - 1].first)
+        {
+            TrigramKeys.push_back(pairs[n].first);
+            TrigramStarts.push_back((int)n);
+        }
+        TrigramItems.push_back(pairs[n].second);
+    }
+    TrigramStarts.push_back((int)pairs.size());
+
+    FuzzyPool.reserve(Items.size());
+    CharMasks.resize(Items.size());
+    for (int i = 0; i < (int)Items.size(); i++)
+        CharMasks[i] = CharMask(Lower.data() + LowerOffsets[i], Lower.data() + LowerOffsets[i + 1]);
+
+    Valid = false;
+    Search(Query);
+}
+
+bool SearchableComboIndex::ItemContains(int item, const std::string& needle) const
+{
+    const std::string_view hay(Lower.data() + LowerOffsets[item], (size_t)(LowerOffsets[item + 1] - LowerOffsets[item]));
+    return hay.find(needle) != std::string_view::npos;
+}
+
+void SearchableComboIndex::SetFuzzy(bool fuzzy, int max_results)
+{
+    Fuzzy = fuzzy;
+    MaxResults = ImMax(1, max_results);
+    Valid = false;
+}
+
+// Scores the tightest window that contains the needle as a subsequence:
+// a forward pass finds where the first full match ends, a backward pass from
+// there finds the latest start. Returns -1 if there is no match.
+int SearchableComboIndex::FuzzyScore(int item, const std::string& needle) const
+{
+    enum { MATCH = 16, PREFIX = 48, WORD_START = 24, CONSECUTIVE = 20, WHOLE_PREFIX = 64 };
+    const char* begin = Lower.data() + LowerOffsets[item];
+    const char* end = Lower.data() + LowerOffsets[item + 1];
+    const char* q = needle.data();
+    const char* q_end = q + needle.size();
+
+    const char* p = begin;
+    if (needle.size() == 1)
+    {
+        // First keystroke scores every item; the first occurrence is the best window.
+        p = FindChar(begin, end, *q);
+        if (p == end)
+            return -1;
+        if (p == begin)
+            return MATCH + PREFIX + WHOLE_PREFIX;
+        const bool word_start = p[-1] == ' ' || p[-1] == '-' || p[-1] == '_' || p[-1] == '.' || p[-1] == '/';
+        return ImMax(MATCH + (word_start ? WORD_START : 0) - ImMin((int)(p - begin), 16), 0);
+    }
+    for (const char* c = q; c < q_end; c++)
+    {
+        p = FindChar(p, end, *c);
+        if (p == end)
+            return -1;
+        p++;
+    }
+    const char* window_end = p;
+    const char* c = q_end;
+    while (c > q)
+        if (*--p == *(c - 1))
+            c--;
+    const char* window_begin = p;
+
+    int score = 0;
+    const char* prev = NULL;
+    c = q;
+    for (p = window_begin; p < window_end && c < q_end; p++)
+    {
+        if (*p != *c)
+            continue;
+        score += MATCH;
+        if (p == begin)
+            score += PREFIX;
+        else if (p[-1] == ' ' || p[-1] == '-' || p[-1] == '_' || p[-1] == '.' || p[-1] == '/')
+            score += WORD_START;
+        if (prev != NULL)
+            score += (p == prev + 1) ? CONSECUTIVE : -ImMin((int)(p - prev - 1), 8);
+        prev = p;
+        c++;
+    }
+    if (window_begin == begin && (size_t)(end - begin) >= needle.size() && memcmp(begin, needle.data(), needle.size()) == 0)
+        score += WHOLE_PREFIX;
+    score -= ImMin((int)(window_begin - begin), 16);
+    return ImMax(score, 0);
+}
+
+void SearchableComboIndex::SearchFuzzy(bool narrow)
+{
+    const uint64_t need = CharMask(QueryLower.data(), QueryLower.data() + QueryLower.size());
+    if (!narrow)
+    {
+        // Character-set pre-filter: an item can only contain the query as a subsequence
+        // if it has every character of it. Two masks per SSE2 compare.
+        // Branch-free compaction into a pre-sized pool.
+        const int count = (int)CharMasks.size();
+        FuzzyPool.resize(count);
+        int* out = FuzzyPool.data();
+        int n = 0;
+        int i = 0;
+#ifdef SEARCHABLECOMBO_SSE2
+        const __m128i want = _mm_set1_epi64x((long long)need);
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128i masks = _mm_loadu_si128((const __m128i*)&CharMasks[i]);
+            const __m128i missing = _mm_xor_si128(_mm_and_si128(masks, want), want);
+            const int zero = _mm_movemask_epi8(_mm_cmpeq_epi32(missing, _mm_setzero_si128()));
+            out[n] = i;
+            n += (zero & 0x00FF) == 0x00FF;
+            out[n] = i + 1;
+            n += (zero & 0xFF00) == 0xFF00;
+        }
+#endif
+        for (; i < count; i++)
+        {
+            out[n] = i;
+            n += (CharMasks[i] & need) == need;
+        }
+        FuzzyPool.resize(n);
+    }
+
+    // Top-K selection while scoring: Scored is a max-heap of the best MaxResults
+    // keys so far (smaller key = better), so most candidates cost one compare.
+    Scored.clear();
+    const size_t k = (size_t)MaxResults;
+    int kept = 0;
+    for (int item : FuzzyPool)
+    {
+        const int score = FuzzyScore(item, QueryLower);
+        if (score < 0)
+            continue;
+        FuzzyPool[kept++] = item;
+        // Shorter items first on equal score, then original order.
+        const std::pair<int, int> key(-(score * 256 - ImMin(LowerOffsets[item + 1] - LowerOffsets[item], 255)), item);
+        if (Scored.size() < k)
+        {
+            Scored.push_back(key);
+            std::push_heap(Scored.begin(), Scored.end());
+        }
+        else if (key < Scored.front())
+        {
+            std::pop_heap(Scored.begin(), Scored.end());
+            Scored.back() = key;
+            std::push_heap(Scored.begin(), Scored.end());
+        }
+    }
+    FuzzyPool.resize(kept);
+
+    std::sort_heap(Scored.begin(), Scored.end());
+    Matches.resize(Scored.size());
+    for (size_t n = 0; n < Scored.size(); n++)
+        Matches[n] = Scored[n].second;
+}
+
+const std::vector<int>& SearchableComboIndex::Search(const char* query)
+{
+    QueryLower.assign(query);
+    for (char& c : QueryLower)
+        c = (char)std::tolower((unsigned char)c);
+    if (Valid && QueryLower == LastQuery)
+        return Matches;
+
+    const int count = (int)Items.size();
+    if (Fuzzy && !QueryLower.empty())
+    {
+        // Typing more letters at the end only removes subsequence matches.
+        const bool narrow = Valid && !LastQuery.empty() && QueryLower.compare(0, LastQuery.size(), LastQuery) == 0;
+        SearchFuzzy(narrow);
+    }
+    else if (QueryLower.empty())
+    {
+        Matches.resize(count);
+        for (int i = 0; i < count; i++)
+            Matches[i] = i;
+    }
+    else if (Valid && !LastQuery.empty() && QueryLower.find(LastQuery) != std::string::npos)
+    {
+        // Anything matching the longer query matched the previous one too.
+        Matches.erase(std::remove_if(Matches.begin(), Matches.end(), [this](int i) { return !ItemContains(i, QueryLower); }), Matches.end());
+    }
+    else if (QueryLower.size() >= 3)
+    {
+        // Verify candidates from the rarest trigram of the query.
+        int best_start = 0, best_end = -1;
+        for (size_t p = 0; p + 3 <= QueryLower.size(); p++)
+        {
+            const uint32_t key = TrigramKey(&QueryLower[p]);
+            auto it = std::lower_bound(TrigramKeys.begin(), TrigramKeys.end(), key);
+            if (it == TrigramKeys.end() || *it != key)
+            {
+                best_start = 0;
+                best_end = 0;
+                break;
+            }
+            const size_t k = (size_t)(it - TrigramKeys.begin());
+            if (best_end < 0 || TrigramStarts[k + 1] - TrigramStarts[k] < best_end - best_start)
+            {
+                best_start = TrigramStarts[k];
+                best_end = TrigramStarts[k + 1];
+            }
+        }
+        Matches.clear();
+        for (int n = best_start; n < best_end; n++)
+            if (ItemContains(TrigramItems[n], QueryLower))
+                Matches.push_back(TrigramItems[n]);
+    }
+    else
+    {
+        Matches.clear();
+        for (int i = 0; i < count; i++)
+            if (ItemContains(i, QueryLower))
+                Matches.push_back(i);
+    }
+
+    LastQuery = QueryLower;
+    Valid = true;
+    return Matches;
+}
+
+bool ImGui::IndexedSearchableCombo(const char* label, int* current_item, SearchableComboIndex& index, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items, const char* no_match_text)
+{
+    ImGuiContext& g = *GImGui;
+    const std::vector<std::string>& items = index.Items;
+
+    const char* preview_text = default_preview_text;
+    if (*current_item >= (int)items.size())
+        *current_item = -1;
+    if (*current_item >= 0)
+        preview_text = items[*current_item].c_str();
+
+    if (popup_max_height_in_items != -1 && !(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint))
+        SetNextWindowSizeConstraints(ImVec2(0, 0), ImVec2(FLT_MAX, CalcMaxPopupHeightFromItemCount(popup_max_height_in_items)));
+
+    if (!BeginSearchableCombo(label, preview_text, index.Query, IM_ARRAYSIZE(index.Query), input_preview_value, ImGuiComboFlags_None))
+        return false;
+
+    const std::vector<int>& matches = index.Search(index.Query);
+
+    // The clipper skips the selected row when it is off-screen, so scroll to it explicitly on open.
+    if (IsWindowAppearing() && *current_item >= 0)
+    {
+        auto it = index.IsFuzzy() ? std::find(matches.begin(), matches.end(), *current_item) : std::lower_bound(matches.begin(), matches.end(), *current_item);
+        if (it != matches.end() && *it == *current_item)
+            SetScrollY((float)(it - matches.begin()) * GetTextLineHeightWithSpacing());
+    }
+
+    bool value_changed = false;
+    ImGuiListClipper clipper((int)matches.size(), GetTextLineHeightWithSpacing());
+    while (clipper.Step())
+    {
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+        {
+            const int i = matches[n];
+            PushID((void*)(intptr_t)i);
+            const bool item_selected = (i == *current_item);
+            if (Selectable(items[i].c_str(), item_selected))
+            {
+                value_changed = true;
+                *current_item = i;
+            }
+            if (item_selected)
+                SetItemDefaultFocus();
+            PopID();
+        }
+    }
+    if (matches.empty())
+        Selectable(no_match_text, false, ImGuiSelectableFlags_Disabled);
 
     EndSearchableCombo();
 
+    if (value_changed)
+        index.Query[0] = 0;
     return value_changed;
-}
\ No newline at end of file
+}
@@ -5,10 +5,52 @@
 #include <vector>       // vector<>
 #include <string>       // string
 #include <algorithm>    // transform
+#include <cstdint>      // uint32_t
+
+// Search state for IndexedSearchableCombo(), meant to live as long as its item
+// list. Items are lowercased once and indexed by trigram when set; the match
+// list is only recomputed when the query text changes, and is narrowed in
+// place when the new query contains the previous one (typing more letters).
+//
+// In fuzzy mode the query only has to appear as a subsequence ("nrgesp"
+// finds "NRG Esports"). Matches are ranked by score (prefix, word-start and
+// consecutive-letter bonuses, gap penalty) and the best MaxResults are kept.
+struct SearchableComboIndex
+{
+    std::vector<std::string>    Items;
+    std::vector<int>            Matches;            // Indices into Items; ascending, or best first in fuzzy mode
+    char                        Query[64] = "";     // Persists between frames while the popup is open
+
+    IMGUI_API void              SetItems(std::vector<std::string> items);
+    IMGUI_API void              SetFuzzy(bool fuzzy, int max_results = 256);
+    IMGUI_API const std::vector<int>& Search(const char* query);
+    bool                        IsFuzzy() const { return Fuzzy; }
+
+private:
+    bool                        ItemContains(int item, const std::string& needle) const;
+    int                         FuzzyScore(int item, const std::string& needle) const;
+    void                        SearchFuzzy(bool narrow);
+
+    std::string                 Lower;              // All items lowercased, back to back
+    std::vector<int>            LowerOffsets;       // Items.size() + 1 entries
+    std::vector<uint32_t>       TrigramKeys;        // Sorted, unique
+    std::vector<int>            TrigramStarts;      // TrigramKeys.size() + 1 entries into TrigramItems
+    std::vector<int>            TrigramItems;       // Ascending item indices per trigram
+    std::vector<uint64_t>       CharMasks;          // Per item: which characters occur, for a cheap fuzzy pre-filter
+    std::vector<int>            FuzzyPool;          // Every item matching LastQuery as a subsequence (fuzzy mode)
+    std::vector<std::pair<int, int>> Scored;        // (-score, item) heap for top-K selection
+    std::string                 LastQuery;
+    std::string                 QueryLower;
+    bool                        Fuzzy = false;
+    int                         MaxResults = 256;
+    bool                        Valid = false;
+};
 
 namespace ImGui
 {
     IMGUI_API bool          BeginSearchableCombo(const char* label, const char* preview_value, char* input, int input_size, const char* input_preview_value, ImGuiComboFlags flags = 0);
     IMGUI_API void          EndSearchableCombo();
-    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, std::vector<std::string> items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1);
+    IMGUI_API bool          SearchableCombo(const char* label, int* current_item, const std::vector<std::string>& items, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1, const char* no_match_text = "No maps found");
+    // Same widget over a prebuilt index; only the visible matches are submitted.
+    IMGUI_API bool          IndexedSearchableCombo(const char* label, int* current_item, SearchableComboIndex& index, const char* default_preview_text, const char* input_preview_value, int popup_max_height_in_items = -1, const char* no_match_text = "No matches");
 } // namespace ImGui
\ No newline at end of file
@@ -0,0 +1,42 @@
+// Text layout cache for ImFont::CalcTextSizeA() and ImFont::RenderText().
+//
+// Both functions decode UTF-8, look up every glyph and (when wrapping) run the word wrapper again on each call, although
+// most labels are the same every frame. With the cache enabled, a text seen in two different frames gets an entry keyed
+// by (font, size, wrap width, text bytes) that holds its size and its "shaped run": the glyph index of every character
+// and where lines break. Later calls skip decoding, glyph lookup and wrapping and only place the quads:
+//
+//   ImTextLayoutCacheSetEnabled(true);                     // Opt-in
+//   // every frame, before drawing:
+//   ImTextLayoutCacheNewFrame(ImGui::GetFrameCount());
+//
+// - Output is identical to the uncached functions: same sizes, same vertices and indices. Quads are placed with the
+//   same float operations in the same order, and advances are still read from the glyphs.
+// - Entries are dropped when any font's glyph tables change through this ImGui build (Build(), BuildLookupTable(),
+//   AddRemapChar(), glyph cache attach/detach...). A font rebuilt by another ImGui build sharing the atlas is detected per
+//   entry (glyph table pointers and sizes, FontSize), so cached glyph indices never outlive the glyphs they point to.
+// - Not cached: texts longer than IM_TEXT_LAYOUT_CACHE_MAX_TEXT bytes, CalcTextSizeA() with a max_width, RenderText()
+//   calls that start above the clip rectangle without wrapping (upstream skips lines there), and every font while an
+//   ImFontGlyphCache is attached (glyph slots change within a frame).
+// - Entries unused for 'max_age' frames are dropped in NewFrame(). No entry is added while 'max_entries' are live.
+// - Global, not thread-safe: call from the thread that runs ImGui.
+
+#pragma once
+#include "imgui.h"
+
+#define IM_TEXT_LAYOUT_CACHE_MAX_TEXT   1024
+
+struct ImTextLayoutCacheStats
+{
+    int     Entries;                // Live entries, with or without a layout yet
+    int     Hits;                   // Calls answered from the cache
+    int     Misses;                 // Calls that ran the uncached code
+    int     Flushes;                // Whole-cache drops after a glyph table change
+    int     Evictions;              // Entries dropped for age or because their font was rebuilt
+    size_t  Bytes;                  // Heap used by text copies and layouts
+};
+
+IMGUI_API void  ImTextLayoutCacheSetEnabled(bool enabled, int max_entries = 2048, int max_age = 120);  // Disabling frees everything
+IMGUI_API bool  ImTextLayoutCacheIsEnabled();
+IMGUI_API void  ImTextLayoutCacheNewFrame(int frame_count);     // Repeated calls with the same frame count are ignored
+IMGUI_API void  ImTextLayoutCacheClear();
+IMGUI_API const ImTextLayoutCacheStats& ImTextLayoutCacheGetStats();
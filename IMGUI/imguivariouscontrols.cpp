@@ -7,6 +7,7 @@
 //-----------------------------------------------------------------------------------------------------------------
 
 #include "imguivariouscontrols.h"
+#include <stdint.h>     // intptr_t (not pulled in by the other headers outside MSVC)
 #define NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 #ifndef NO_IMGUIVARIOUSCONTROLS_ANIMATEDIMAGE
 #ifndef IMGUI_USE_AUTO_BINDING
@@ -0,0 +1,249 @@
+#include "pch.h"
+#include "ImGuiAllocator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <malloc.h>
+
+#ifdef _WIN32
+static size_t UsableSize(void* p) { return _msize(p); }
+#else
+static size_t UsableSize(void* p) { return malloc_usable_size(p); }
+#endif
+
+// Block sizes including the header; multiples of 16 so every block stays 16-byte aligned.
+const uint32_t ImGuiAllocator::CLASS_SIZES[NUM_CLASSES] = {
+	32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096 };
+
+namespace
+{
+	struct BlockHeader
+	{
+		uint32_t cls;
+		uint32_t reserved;
+		uint64_t size;
+	};
+	static_assert(sizeof(BlockHeader) == 16, "header must keep user pointers 16-byte aligned");
+
+	void* AllocThunk(size_t size, void* user) { return static_cast<ImGuiAllocator*>(user)->Alloc(size); }
+	void FreeThunk(void* p, void* user) { static_cast<ImGuiAllocator*>(user)->Free(p); }
+	void* PlainAlloc(size_t size, void*) { return malloc(size); }
+	void PlainFree(void* p, void*) { free(p); }
+
+	size_t Round16(size_t n) { return (n + 15) & ~static_cast<size_t>(15); }
+}
+
+ImGuiAllocator::~ImGuiAllocator()
+{
+	if (installed_) Uninstall();
+	// ImGui may still own pooled blocks if its context outlives us; those slabs are leaked, not freed under it.
+	if (running_.liveBlocks == 0 || mode_ == Mode::Counting) ReleaseAll();
+}
+
+void ImGuiAllocator::Install(Mode mode)
+{
+	mode_ = mode;
+	transient_ = false;
+	ImGui::SetAllocatorFunctions(AllocThunk, FreeThunk, this);
+	installed_ = true;
+}
+
+void ImGuiAllocator::Uninstall()
+{
+	ImGui::SetAllocatorFunctions(PlainAlloc, PlainFree, nullptr);
+	installed_ = false;
+}
+
+int ImGuiAllocator::ClassFor(size_t total)
+{
+	if (total > CLASS_SIZES[NUM_CLASSES - 1]) return -1;
+	const uint32_t* it = std::lower_bound(CLASS_SIZES, CLASS_SIZES + NUM_CLASSES, static_cast<uint32_t>(total));
+	return static_cast<int>(it - CLASS_SIZES);
+}
+
+void* ImGuiAllocator::PoolAlloc(int cls)
+{
+	if (!freeLists_[cls])
+	{
+		unsigned char* slab = static_cast<unsigned char*>(malloc(SLAB_BYTES));
+		if (!slab) return nullptr;
+		slabs_.push_back(slab);
+		running_.slabBytes += SLAB_BYTES;
+		// Thread the slab onto the free list back to front so blocks are handed out in address order.
+		const size_t bs = CLASS_SIZES[cls];
+		for (size_t off = (SLAB_BYTES / bs) * bs; off >= bs; off -= bs)
+		{
+			FreeBlock* b = reinterpret_cast<FreeBlock*>(slab + off - bs);
+			b->next = freeLists_[cls];
+			freeLists_[cls] = b;
+		}
+	}
+	FreeBlock* b = freeLists_[cls];
+	freeLists_[cls] = b->next;
+	return b;
+}
+
+void* ImGuiAllocator::ArenaAlloc(size_t size)
+{
+	const size_t need = HEADER + Round16(size);
+	while (arenaChunk_ < arena_.size() && arenaOffset_ + need > arena_[arenaChunk_].size)
+	{
+		++arenaChunk_;
+		arenaOffset_ = 0;
+	}
+	if (arenaChunk_ == arena_.size())
+	{
+		Chunk c;
+		c.size = std::max(ARENA_CHUNK, need);
+		c.data = static_cast<unsigned char*>(malloc(c.size));
+		if (!c.data) return nullptr;
+		arena_.push_back(c);
+		running_.arenaCapacity += c.size;
+		arenaOffset_ = 0;
+	}
+	unsigned char* raw = arena_[arenaChunk_].data + arenaOffset_;
+	arenaOffset_ += need;
+	arenaFrameBytes_ += need;
+	BlockHeader* h = reinterpret_cast<BlockHeader*>(raw);
+	h->cls = CLASS_ARENA;
+	h->size = size;
+	return raw + HEADER;
+}
+
+void* ImGuiAllocator::FrameAlloc(size_t size)
+{
+	return ArenaAlloc(size);
+}
+
+void ImGuiAllocator::NoteAlloc(size_t size)
+{
+	++running_.allocs;
+	++running_.liveBlocks;
+	running_.liveBytes += static_cast<int64_t>(size);
+	running_.peakBytes = std::max(running_.peakBytes, running_.liveBytes);
+	++frameAllocs_;
+	frameBytes_ += size;
+}
+
+void ImGuiAllocator::NoteFree(size_t size)
+{
+	++running_.frees;
+	--running_.liveBlocks;
+	running_.liveBytes -= static_cast<int64_t>(size);
+}
+
+void* ImGuiAllocator::Alloc(size_t size)
+{
+	if (mode_ == Mode::Counting)
+	{
+		void* p = malloc(size);
+		if (p) NoteAlloc(UsableSize(p));
+		return p;
+	}
+	if (transient_)
+	{
+		++running_.transientAllocs;
+		++frameAllocs_;
+		return ArenaAlloc(size);
+	}
+
+	const int cls = ClassFor(size + HEADER);
+	unsigned char* raw;
+	if (cls < 0)
+	{
+		raw = static_cast<unsigned char*>(malloc(size + HEADER));
+		++running_.largeAllocs;
+	}
+	else
+	{
+		raw = static_cast<unsigned char*>(PoolAlloc(cls));
+		++running_.pooledAllocs;
+	}
+	if (!raw) return nullptr;
+	BlockHeader* h = reinterpret_cast<BlockHeader*>(raw);
+	h->cls = cls < 0 ? CLASS_LARGE : static_cast<uint32_t>(cls);
+	h->size = size;
+	NoteAlloc(size);
+	return raw + HEADER;
+}
+
+void ImGuiAllocator::Free(void* p)
+{
+	if (!p) return;
+	if (mode_ == Mode::Counting)
+	{
+		NoteFree(UsableSize(p));
+		free(p);
+		return;
+	}
+
+	unsigned char* raw = static_cast<unsigned char*>(p) - HEADER;
+	const BlockHeader* h = reinterpret_cast<const BlockHeader*>(raw);
+	if (h->cls == CLASS_ARENA) return;
+	NoteFree(static_cast<size_t>(h->size));
+	if (h->cls == CLASS_LARGE)
+	{
+		free(raw);
+		return;
+	}
+	FreeBlock* b = reinterpret_cast<FreeBlock*>(raw);
+	b->next = freeLists_[h->cls];
+	freeLists_[h->cls] = b;
+}
+
+void ImGuiAllocator::BeginFrame(int frame)
+{
+	if (frame == frame_) return;
+	frame_ = frame;
+
+	++running_.frames;
+	running_.lastFrameAllocs = frameAllocs_;
+	running_.lastFrameBytes = frameBytes_;
+	running_.peakFrameAllocs = std::max(running_.peakFrameAllocs, frameAllocs_);
+	running_.arenaUsed = arenaFrameBytes_;
+	running_.arenaPeak = std::max(running_.arenaPeak, arenaFrameBytes_);
+	frameAllocs_ = 0;
+	frameBytes_ = 0;
+
+	// A frame that spilled into several chunks gets one chunk of the combined size from now on.
+	if (arena_.size() > 1 && arenaChunk_ > 0)
+	{
+		size_t total = 0;
+		for (Chunk& c : arena_)
+		{
+			total += c.size;
+			free(c.data);
+		}
+		arena_.clear();
+		Chunk c;
+		c.size = total;
+		c.data = static_cast<unsigned char*>(malloc(total));
+		if (c.data) arena_.push_back(c);
+		running_.arenaCapacity = c.data ? total : 0;
+	}
+	arenaChunk_ = 0;
+	arenaOffset_ = 0;
+	arenaFrameBytes_ = 0;
+
+	std::lock_guard<std::mutex> lock(publishMutex_);
+	published_ = running_;
+}
+
+ImGuiAllocStats ImGuiAllocator::Stats() const
+{
+	std::lock_guard<std::mutex> lock(publishMutex_);
+	return published_;
+}
+
+void ImGuiAllocator::ReleaseAll()
+{
+	for (unsigned char* s : slabs_) free(s);
+	slabs_.clear();
+	for (Chunk& c : arena_) free(c.data);
+	arena_.clear();
+	std::fill(std::begin(freeLists_), std::end(freeLists_), nullptr);
+	arenaChunk_ = 0;
+	arenaOffset_ = 0;
+	running_.slabBytes = 0;
+	running_.arenaCapacity = 0;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+struct ImGuiAllocStats
+{
+	// Bytes requested through ImGui::MemAlloc minus bytes released through MemFree. In a shared context
+	// (Counting mode) frees of blocks another module allocated are included, so this can dip below zero.
+	int64_t liveBytes = 0;
+	int64_t peakBytes = 0;
+	int64_t liveBlocks = 0;
+	uint64_t allocs = 0;
+	uint64_t frees = 0;
+	uint64_t frames = 0;
+	uint64_t lastFrameAllocs = 0;
+	uint64_t lastFrameBytes = 0;
+	uint64_t peakFrameAllocs = 0;
+	// Pooled mode only.
+	uint64_t pooledAllocs = 0;
+	uint64_t largeAllocs = 0;
+	uint64_t transientAllocs = 0;
+	size_t slabBytes = 0;
+	size_t arenaUsed = 0;
+	size_t arenaPeak = 0;
+	size_t arenaCapacity = 0;
+};
+
+// Allocator hooks for ImGui::SetAllocatorFunctions.
+//
+// Counting: malloc/free plus statistics. Blocks stay interchangeable with
+// any other ImGui build's, which is what a context shared with BakkesMod and
+// other plugins needs: windows and draw lists the plugin creates are freed by
+// BakkesMod's copy of ImGui and the other way round.
+//
+// Pooled: size classes up to 4 KB carved from 64 KB slabs, with malloc above
+// that, and a bump arena reset every frame. Only for contexts whose every
+// MemFree goes through this allocator (tools, a context the plugin owns).
+// Inside a TransientScope, ImGui allocations come from the arena; freeing them
+// is a no-op and they are gone at the next BeginFrame, so only allocations
+// that die within the frame belong there. FrameAlloc hands out the same
+// memory to callers directly.
+//
+// Used from the thread that runs ImGui. Stats() may be called from any
+// thread; it returns the figures as of the last frame boundary.
+class ImGuiAllocator
+{
+public:
+	enum class Mode { Counting, Pooled };
+
+	ImGuiAllocator() = default;
+	~ImGuiAllocator();
+	ImGuiAllocator(const ImGuiAllocator&) = delete;
+	ImGuiAllocator& operator=(const ImGuiAllocator&) = delete;
+
+	// Installs this allocator for the calling module's ImGui. Only switch modes with no live ImGui allocations.
+	void Install(Mode mode);
+	// Puts plain malloc/free back. Pooled blocks still alive are leaked rather than handed to free().
+	void Uninstall();
+	bool Installed() const { return installed_; }
+	Mode GetMode() const { return mode_; }
+
+	// Closes the previous frame's tally and resets the arena. Repeated calls with the same frame number are ignored.
+	void BeginFrame(int frame);
+
+	void* FrameAlloc(size_t size);
+	ImGuiAllocStats Stats() const;
+
+	void* Alloc(size_t size);
+	void Free(void* p);
+
+	class TransientScope
+	{
+	public:
+		explicit TransientScope(ImGuiAllocator& a) : a_(a), prev_(a.transient_) { a_.transient_ = a_.mode_ == Mode::Pooled; }
+		~TransientScope() { a_.transient_ = prev_; }
+		TransientScope(const TransientScope&) = delete;
+		TransientScope& operator=(const TransientScope&) = delete;
+	private:
+		ImGuiAllocator& a_;
+		bool prev_;
+	};
+
+private:
+	static constexpr size_t HEADER = 16;
+	static constexpr size_t SLAB_BYTES = 64 * 1024;
+	static constexpr size_t ARENA_CHUNK = 64 * 1024;
+	static constexpr int NUM_CLASSES = 15;
+	static constexpr uint32_t CLASS_LARGE = 0xFE;
+	static constexpr uint32_t CLASS_ARENA = 0xFF;
+	static const uint32_t CLASS_SIZES[NUM_CLASSES];
+
+	struct FreeBlock { FreeBlock* next; };
+	struct Chunk
+	{
+		unsigned char* data = nullptr;
+		size_t size = 0;
+	};
+
+	static int ClassFor(size_t total);
+	void* PoolAlloc(int cls);
+	void* ArenaAlloc(size_t size);
+	void NoteAlloc(size_t size);
+	void NoteFree(size_t size);
+	void ReleaseAll();
+
+	Mode mode_ = Mode::Counting;
+	bool installed_ = false;
+	bool transient_ = false;
+	int frame_ = -1;
+
+	FreeBlock* freeLists_[NUM_CLASSES] = {};
+	std::vector<unsigned char*> slabs_;
+	std::vector<Chunk> arena_;
+	size_t arenaChunk_ = 0;
+	size_t arenaOffset_ = 0;
+	size_t arenaFrameBytes_ = 0;
+
+	ImGuiAllocStats running_;
+	uint64_t frameAllocs_ = 0;
+	uint64_t frameBytes_ = 0;
+
+	mutable std::mutex publishMutex_;
+	ImGuiAllocStats published_;
+};
@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "LocalSocket.h"
+
+#ifdef _WIN32
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+
+namespace LocalSocket
+{
+	bool NetStartup()
+	{
+#ifdef _WIN32
+		WSADATA wsa;
+		return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+#else
+		return true;
+#endif
+	}
+
+	void NetCleanup()
+	{
+#ifdef _WIN32
+		WSACleanup();
+#endif
+	}
+
+	void Close(socket_t s)
+	{
+#ifdef _WIN32
+		closesocket(s);
+#else
+		close(s);
+#endif
+	}
+
+	void SetNoDelay(socket_t s)
+	{
+		int yes = 1;
+		setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&yes), sizeof(yes));
+	}
+
+	void SetNonBlocking(socket_t s)
+	{
+#ifdef _WIN32
+		u_long on = 1;
+		ioctlsocket(s, FIONBIO, &on);
+#else
+		fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+	}
+
+	bool WouldBlock()
+	{
+#ifdef _WIN32
+		return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+		return errno == EWOULDBLOCK || errno == EAGAIN;
+#endif
+	}
+
+	socket_t ListenLoopback(uint16_t port)
+	{
+		socket_t s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (s == INVALID_SOCKET) return INVALID_SOCKET;
+
+		int yes = 1;
+		setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(s, 8) != 0)
+		{
+			Close(s);
+			return INVALID_SOCKET;
+		}
+		return s;
+	}
+
+	socket_t OpenWakeup()
+	{
+		socket_t s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if (s == INVALID_SOCKET) return INVALID_SOCKET;
+
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_port = 0;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socklen_t len = sizeof(addr);
+		if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+			|| getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len) != 0
+			|| connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+		{
+			Close(s);
+			return INVALID_SOCKET;
+		}
+		SetNonBlocking(s);
+		return s;
+	}
+
+	void Wake(socket_t s)
+	{
+		const char b = 0;
+		send(s, &b, 1, 0);
+	}
+
+	void DrainWakeup(socket_t s)
+	{
+		char buf[64];
+		while (recv(s, buf, sizeof(buf), 0) > 0) {}
+	}
+}
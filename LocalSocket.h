@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socket_t = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using socket_t = int;
+constexpr socket_t INVALID_SOCKET = -1;
+#endif
+
+// Thin portability layer over Winsock/BSD sockets for the plugin's loopback
+// endpoints. NetStartup/NetCleanup calls must be balanced.
+namespace LocalSocket
+{
+	bool NetStartup();
+	void NetCleanup();
+	void Close(socket_t s);
+	void SetNoDelay(socket_t s);
+	void SetNonBlocking(socket_t s);
+	bool WouldBlock();
+
+	// Listening TCP socket bound to 127.0.0.1:port, or INVALID_SOCKET.
+	socket_t ListenLoopback(uint16_t port);
+
+	// Non-blocking loopback UDP socket connected to itself, for waking a
+	// thread blocked in select(): Wake() from any thread makes it readable,
+	// the select()ing thread empties it with DrainWakeup().
+	socket_t OpenWakeup();
+	void Wake(socket_t s);
+	void DrainWakeup(socket_t s);
+}
@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "MacroEngine.h"
+#include <cstdlib>
+#include <optional>
+
+static constexpr int MACRO_MAX_DEPTH = 8;
+
+static std::string Trim(const std::string& s)
+{
+	size_t b = s.find_first_not_of(" \t\r\n");
+	if (b == std::string::npos) return {};
+	size_t e = s.find_last_not_of(" \t\r\n");
+	return s.substr(b, e - b + 1);
+}
+
+// Splits on ';' outside of double quotes.
+static std::vector<std::string> SplitCommands(const std::string& source)
+{
+	std::vector<std::string> parts;
+	std::string cur;
+	bool quoted = false;
+	for (char c : source)
+	{
+		if (c == '"') quoted = !quoted;
+		if (c == ';' && !quoted)
+		{
+			parts.push_back(Trim(cur));
+			cur.clear();
+			continue;
+		}
+		cur += c;
+	}
+	parts.push_back(Trim(cur));
+	return parts;
+}
+
+// Splits a command into console arguments: whitespace-separated, with double quotes grouping (and removed).
+static std::vector<std::string> SplitArgs(const std::string& command)
+{
+	std::vector<std::string> args;
+	std::string cur;
+	bool quoted = false, any = false;
+	for (char c : command)
+	{
+		if (c == '"') { quoted = !quoted; any = true; continue; }
+		if (!quoted && (c == ' ' || c == '\t'))
+		{
+			if (any) args.push_back(std::move(cur));
+			cur.clear();
+			any = false;
+			continue;
+		}
+		cur += c;
+		any = true;
+	}
+	if (any) args.push_back(std::move(cur));
+	return args;
+}
+
+static bool ConsumeWord(std::string& s, const char* word)
+{
+	const size_t n = std::char_traits<char>::length(word);
+	if (s.compare(0, n, word) != 0) return false;
+	if (s.size() > n && s[n] != ' ' && s[n] != '\t') return false;
+	s = Trim(s.substr(n));
+	return true;
+}
+
+MacroEngine::MacroEngine(ExecFn exec, ScheduleFn schedule, ContextFn context, BindFn bind)
+	: exec_(std::move(exec))
+	, schedule_(std::move(schedule))
+	, context_(std::move(context))
+	, bind_(std::move(bind))
+{
+}
+
+void MacroEngine::Define(const std::string& name, const std::string& source)
+{
+	sources_[name] = source;
+	// Macros may reference each other through @name, so dependents are rebuilt too.
+	Recompile();
+}
+
+bool MacroEngine::IsEmpty(const std::string& name) const
+{
+	return StepCount(name) == 0;
+}
+
+size_t MacroEngine::StepCount(const std::string& name) const
+{
+	auto it = compiled_.find(name);
+	return it == compiled_.end() ? 0 : it->second->steps.size();
+}
+
+size_t MacroEngine::BoundStepCount(const std::string& name) const
+{
+	auto it = compiled_.find(name);
+	if (it == compiled_.end()) return 0;
+	size_t n = 0;
+	for (const MacroStep& step : it->second->steps) n += step.call ? 1 : 0;
+	return n;
+}
+
+bool MacroEngine::Run(const std::string& name)
+{
+	auto it = compiled_.find(name);
+	if (it == compiled_.end() || it->second->steps.empty()) return false;
+	RunFrom(it->second, 0);
+	return true;
+}
+
+void MacroEngine::Recompile()
+{
+	compiled_.clear();
+	for (const auto& [name, source] : sources_)
+	{
+		auto macro = std::make_shared<CompiledMacro>();
+		macro->source = source;
+		CompileInto(source, macro->steps, 0);
+		compiled_[name] = std::move(macro);
+	}
+}
+
+void MacroEngine::CompileInto(const std::string& source, std::vector<MacroStep>& out, int depth) const
+{
+	if (depth > MACRO_MAX_DEPTH)
+	{
+		LOG("MAH: Macro nesting too deep, ignoring: {}", source);
+		return;
+	}
+	for (std::string part : SplitCommands(source))
+	{
+		if (part.empty()) continue;
+
+		uint8_t conditions = MacroCond_None;
+		for (bool more = true; more && !part.empty() && part[0] == '?';)
+		{
+			if (ConsumeWord(part, "?paused")) conditions |= MacroCond_Paused;
+			else if (ConsumeWord(part, "?unpaused")) conditions |= MacroCond_Unpaused;
+			else if (ConsumeWord(part, "?overtime")) conditions |= MacroCond_Overtime;
+			else if (ConsumeWord(part, "?regulation")) conditions |= MacroCond_Regulation;
+			else more = false;
+		}
+		if (part.empty()) continue;
+
+		if (part[0] == '@')
+		{
+			auto it = sources_.find(Trim(part.substr(1)));
+			if (it == sources_.end())
+			{
+				LOG("MAH: Unknown macro reference {}", part);
+				continue;
+			}
+			const size_t first = out.size();
+			CompileInto(it->second, out, depth + 1);
+			for (size_t i = first; i < out.size(); ++i) out[i].conditions |= conditions;
+			continue;
+		}
+
+		MacroStep step;
+		step.conditions = conditions;
+		if (ConsumeWord(part, "wait"))
+		{
+			step.op = MacroOp::Delay;
+			step.delaySeconds = std::strtof(part.c_str(), nullptr);
+			if (step.delaySeconds <= 0.f) continue;
+		}
+		else
+		{
+			step.op = MacroOp::Exec;
+			if (bind_) step.call = bind_(SplitArgs(part));
+			step.command = std::move(part);
+		}
+		out.push_back(std::move(step));
+	}
+}
+
+void MacroEngine::RunFrom(std::shared_ptr<const CompiledMacro> macro, size_t index)
+{
+	// Sampled lazily, and again after every exec: a command may have just paused or reset the match.
+	std::optional<MacroContext> ctx;
+	const auto& steps = macro->steps;
+	for (size_t i = index; i < steps.size(); ++i)
+	{
+		const MacroStep& step = steps[i];
+		if (step.conditions != MacroCond_None)
+		{
+			if (!ctx) ctx = context_();
+			if ((step.conditions & MacroCond_Paused) && !ctx->paused) continue;
+			if ((step.conditions & MacroCond_Unpaused) && ctx->paused) continue;
+			if ((step.conditions & MacroCond_Overtime) && !ctx->overtime) continue;
+			if ((step.conditions & MacroCond_Regulation) && ctx->overtime) continue;
+		}
+		if (step.op == MacroOp::Delay)
+		{
+			schedule_([this, alive = std::weak_ptr<void>(alive_), macro, next = i + 1]() {
+				if (alive.expired()) return;	// Engine destroyed (plugin unloaded) while the delay was pending
+				RunFrom(macro, next);
+			}, step.delaySeconds);
+			return;
+		}
+		if (step.call) step.call();
+		else exec_(step.command);
+		ctx.reset();
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Game state sampled when a macro step carries a condition.
+struct MacroContext
+{
+	bool paused = false;
+	bool overtime = false;
+};
+
+enum class MacroOp : uint8_t
+{
+	Exec,
+	Delay,
+};
+
+enum MacroCond : uint8_t
+{
+	MacroCond_None = 0,
+	MacroCond_Paused = 1 << 0,
+	MacroCond_Unpaused = 1 << 1,
+	MacroCond_Overtime = 1 << 2,
+	MacroCond_Regulation = 1 << 3,
+};
+
+struct MacroStep
+{
+	MacroOp op = MacroOp::Exec;
+	uint8_t conditions = MacroCond_None;
+	float delaySeconds = 0.f;
+	std::string command;
+	std::function<void()> call;	// Target resolved at compile time; empty runs 'command' through exec
+};
+
+struct CompiledMacro
+{
+	std::string source;
+	std::vector<MacroStep> steps;
+};
+
+// Compiles ';'-separated command lists once (when their cvar changes) and runs
+// the resulting step list without touching the source string again. Each
+// command is split into arguments at compile time and offered to 'bind'; a
+// target it resolves (the plugin's own notifiers and cvars) is called directly
+// when the step runs. Any other command is passed to 'exec' as a string, and
+// BakkesMod tokenizes it again on every run: the SDK takes nothing else.
+//
+// Syntax, per step:
+//   <console command>          executed as-is
+//   wait <seconds>             delays the remaining steps
+//   ?paused / ?unpaused <cmd>  only runs when the server is (un)paused
+//   ?overtime / ?regulation    only runs in (or outside) overtime
+//   @<name>                    inlines another defined macro
+class MacroEngine
+{
+public:
+	using ExecFn = std::function<void(const std::string&)>;
+	using ScheduleFn = std::function<void(std::function<void()>, float)>;
+	using ContextFn = std::function<MacroContext()>;
+	using BindFn = std::function<std::function<void()>(const std::vector<std::string>& args)>;
+
+	MacroEngine(ExecFn exec, ScheduleFn schedule, ContextFn context, BindFn bind = nullptr);
+
+	void Define(const std::string& name, const std::string& source);
+	bool IsEmpty(const std::string& name) const;
+	size_t StepCount(const std::string& name) const;
+	size_t BoundStepCount(const std::string& name) const;
+	bool Run(const std::string& name);
+	// Rebuilds every macro, so steps can bind to commands registered since they were defined.
+	void Recompile();
+
+private:
+	void CompileInto(const std::string& source, std::vector<MacroStep>& out, int depth) const;
+	void RunFrom(std::shared_ptr<const CompiledMacro> macro, size_t index);
+
+	ExecFn exec_;
+	ScheduleFn schedule_;
+	ContextFn context_;
+	BindFn bind_;
+	std::unordered_map<std::string, std::string> sources_;
+	std::unordered_map<std::string, std::shared_ptr<const CompiledMacro>> compiled_;
+	std::shared_ptr<void> alive_ = std::make_shared<char>(0);	// Scheduled continuations hold a weak_ptr to it
+};
@@ -8,7 +8,14 @@
 #include <set>
 #include <regex>
 #include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include "imgui/imgui.h"
+#include "IMGUI/imgui_text_cache.h"
 
 #if __has_include("bakkesmod/wrappers/GameObject/ServerWrapper.h")
 #include "bakkesmod/wrappers/GameObject/ServerWrapper.h"
@@ -44,6 +51,61 @@ static constexpr auto NOTI_RESET = "mah_reset_kickoff";
 static constexpr auto CVAR_PAUSE_CMD = "mah_pause_cmd";
 static constexpr auto CVAR_RESET_CMD = "mah_reset_cmd";
 static constexpr auto CVAR_ENABLED = "mah_enabled";
+static constexpr auto CVAR_UNPAUSE_COUNTDOWN = "mah_unpause_countdown";
+static constexpr auto CVAR_CONTROL_ENABLED = "mah_control_enabled";
+static constexpr auto CVAR_CONTROL_PORT = "mah_control_port";
+static constexpr auto NOTI_CONTROL_STATS = "mah_control_stats";
+static constexpr auto CVAR_STREAM_ENABLED = "mah_stream_enabled";
+static constexpr auto CVAR_STREAM_PORT = "mah_stream_port";
+static constexpr auto NOTI_STREAM_STATS = "mah_stream_stats";
+static constexpr auto CVAR_SHM_ENABLED = "mah_shm_enabled";
+static constexpr auto CVAR_CFG_WATCH = "mah_cfg_watch";
+static constexpr auto NOTI_IMGUI_MEM = "mah_imgui_mem";
+static constexpr auto CVAR_TEXT_CACHE = "mah_text_cache";
+
+static constexpr auto NOTI_MACRO_DEFINE = "mah_macro_define";
+static constexpr auto NOTI_MACRO_RUN = "mah_macro_run";
+static constexpr auto MACRO_PAUSE = "pause";
+static constexpr auto MACRO_RESET = "reset";
+
+static constexpr auto NOTI_SCHEDULE = "mah_schedule";
+static constexpr auto NOTI_SCHEDULE_CANCEL = "mah_schedule_cancel";
+
+static constexpr auto NOTI_SERIES_START = "mah_series_start";
+static constexpr auto NOTI_SERIES_STATUS = "mah_series_status";
+static constexpr auto NOTI_SERIES_UNDO = "mah_series_undo";
+static constexpr auto NOTI_SERIES_SWAP = "mah_series_swap";
+static constexpr auto NOTI_SERIES_RESUME = "mah_series_resume";
+static constexpr auto NOTI_SERIES_END = "mah_series_end";
+static constexpr auto SERIES_LOG_FILE = "series.log";
+
+static constexpr auto NOTI_MATCHES_LOAD = "mah_matches_load";
+static constexpr auto NOTI_MATCHES_NEXT = "mah_matches_next";
+static constexpr auto NOTI_MATCHES_START = "mah_matches_start";
+static constexpr auto NOTI_MATCHES_FIND = "mah_matches_find";
+static constexpr auto SCHEDULE_FILE = "schedule.csv";
+
+static constexpr auto NOTI_SCENARIO_DEFINE = "mah_scenario_define";
+static constexpr auto NOTI_SCENARIO_APPLY = "mah_scenario_apply";
+static constexpr auto NOTI_SCENARIO_LIST = "mah_scenario_list";
+static constexpr auto NOTI_SCENARIO_RELOAD = "mah_scenario_reload";
+static constexpr auto SCENARIO_FILE = "scenarios.txt";
+
+static constexpr auto HOOK_VIEWPORT_TICK = "Function Engine.GameViewportClient.Tick";
+static constexpr auto HOOK_MATCH_ENDED = "Function TAGame.GameEvent_Soccar_TA.EventMatchEnded";
+static constexpr auto HOOK_GAME_DESTROYED = "Function TAGame.GameEvent_Soccar_TA.Destroyed";
+static constexpr auto HOOK_TEAM_SCORE_UPDATED = "Function TAGame.Team_TA.EventScoreUpdated";
+static constexpr auto HOOK_GOAL_SCORED = "Function TAGame.GameEvent_Soccar_TA.EventGoalScored";
+static constexpr auto HOOK_KICKOFF_COUNTDOWN = "Function GameEvent_Soccar_TA.Countdown.BeginState";
+
+// Timer wheel resolution; delays are rounded up to the next tick.
+static constexpr double TIMER_TICK_HZ = 120.0;
+
+enum TimerGroup : uint32_t
+{
+	TimerGroup_Plugin = 0,
+	TimerGroup_Match = 1,
+};
 
 static constexpr auto CVAR_KEY_BLUE_PLUS = "mah_key_blue_plus";
 static constexpr auto CVAR_KEY_ORANGE_PLUS = "mah_key_orange_plus";
@@ -62,11 +124,22 @@ static std::string ui_key_reset;
 static std::string last_blue_plus, last_orange_plus, last_blue_minus, last_orange_minus, last_pause, last_reset;
 static bool unsavedToastShown = false;
 
-static void ExecMulti(const std::shared_ptr<CVarManagerWrapper>& cvars, const std::string& cmdsSemicolonSeparated)
+struct ManagedKey
 {
-	if (cmdsSemicolonSeparated.empty()) return;
-	cvars->executeCommand(cmdsSemicolonSeparated);
-}
+	const char* notifier;
+	const char* cvar;
+	std::string* ui;
+	std::string* last;
+};
+
+static const ManagedKey MANAGED_KEYS[] = {
+	{ NOTI_BLUE_PLUS, CVAR_KEY_BLUE_PLUS, &ui_key_blue_plus, &last_blue_plus },
+	{ NOTI_BLUE_MINUS, CVAR_KEY_BLUE_MINUS, &ui_key_blue_minus, &last_blue_minus },
+	{ NOTI_ORANGE_PLUS, CVAR_KEY_ORANGE_PLUS, &ui_key_orange_plus, &last_orange_plus },
+	{ NOTI_ORANGE_MINUS, CVAR_KEY_ORANGE_MINUS, &ui_key_orange_minus, &last_orange_minus },
+	{ NOTI_PAUSE_TOGGLE, CVAR_KEY_PAUSE, &ui_key_pause, &last_pause },
+	{ NOTI_RESET, CVAR_KEY_RESET, &ui_key_reset, &last_reset },
+};
 
 static std::optional<std::pair<TeamWrapper, TeamWrapper>> FindTeams(GameWrapper* gw)
 {
@@ -81,6 +154,53 @@ static std::optional<std::pair<TeamWrapper, TeamWrapper>> FindTeams(GameWrapper*
 	return std::make_pair(blue, orange);
 }
 
+static std::optional<PlayerControllerWrapper> GetLocalPC(GameWrapper* gw, ServerWrapper server);
+
+// ApplyScenario() target for the live server. Pausing needs a controller, so
+// it falls back to doing nothing when none can be resolved.
+struct ServerScenarioTarget
+{
+	GameWrapper* gw;
+	ServerWrapper server;
+	std::pair<TeamWrapper, TeamWrapper> teams;
+	bool kickoff = false;
+	bool pauseChanged = false;
+	bool paused = false;
+
+	void SetScore(int team, int value) { (team == 0 ? teams.first : teams.second).SetScore(value); }
+	void SetClock(int seconds)
+	{
+		server.SetSecondsRemaining(seconds);
+		server.SetGameTimeRemaining(static_cast<float>(seconds));
+	}
+	void SetOvertime(bool on) { server.SetbOverTime(on ? 1 : 0); }
+	void Kickoff()
+	{
+		server.StartNewRound();
+		kickoff = true;
+	}
+	void SetPaused(bool on)
+	{
+		PlayerControllerWrapper pauser = server.GetPauser();
+		if (!on && pauser)
+		{
+			server.SetPaused(pauser, 0);
+		}
+		else if (on && !pauser)
+		{
+			auto pc = GetLocalPC(gw, server);
+			if (!pc) return;
+			server.SetPaused(*pc, 1);
+		}
+		else
+		{
+			return;
+		}
+		pauseChanged = true;
+		paused = on;
+	}
+};
+
 static std::optional<PlayerControllerWrapper> GetLocalPC(GameWrapper* gw, ServerWrapper server)
 {
 	if (!gw) return std::nullopt;
@@ -123,6 +243,19 @@ static void UnbindAllManagedKeys(const std::shared_ptr<CVarManagerWrapper>& cvar
 	cvars->executeCommand(cmd);
 }
 
+static std::filesystem::path CfgPath(GameWrapper* gw)
+{
+	return gw->GetBakkesModPath() / "cfg" / "matchadminhotkeys.cfg";
+}
+
+static bool ReadTextFile(const std::filesystem::path& file, std::string& text)
+{
+	std::ifstream in(file, std::ios::binary);
+	if (!in.is_open()) return false;
+	text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	return true;
+}
+
 static void PersistBinds(const std::shared_ptr<CVarManagerWrapper>& cvars)
 {
 	cvars->executeCommand("writeconfig");
@@ -243,6 +376,8 @@ void MatchAdminHotkeys::onLoad()
 	if (gameWrapper) {
 		gameWrapper->Toast("MatchAdminHotkeys", "Loaded " + std::string(plugin_version));
 	}
+	menuTitle_ = "Match Admin Scoreboard";
+
 	cvarManager->registerCvar(CVAR_KEY_BLUE_PLUS, "U", "Key");
 	cvarManager->registerCvar(CVAR_KEY_ORANGE_PLUS, "I", "Key");
 	cvarManager->registerCvar(CVAR_KEY_BLUE_MINUS, "J", "Key");
@@ -251,21 +386,222 @@ void MatchAdminHotkeys::onLoad()
 	cvarManager->registerCvar(CVAR_KEY_RESET, "O", "Key");
 
 	cvarManager->executeCommand("exec matchadminhotkeys.cfg");
-	cvarManager->registerCvar(CVAR_PAUSE_CMD, "", "Optional");
-	cvarManager->registerCvar(CVAR_RESET_CMD, "", "Optional");
+	CVarWrapper pauseCmdCvar = cvarManager->registerCvar(CVAR_PAUSE_CMD, "", "Optional");
+	CVarWrapper resetCmdCvar = cvarManager->registerCvar(CVAR_RESET_CMD, "", "Optional");
 	cvarManager->registerCvar(CVAR_ENABLED, "1", "Enable");
+	cvarManager->registerCvar(CVAR_UNPAUSE_COUNTDOWN, "0", "Seconds of countdown before unpausing (0 = instant)", true, true, 0.f, true, 10.f);
+
+	macros_ = std::make_unique<MacroEngine>(
+		[this](const std::string& cmd) { cvarManager->executeCommand(cmd, false); },
+		[this](std::function<void()> fn, float delay) { gameWrapper->SetTimeout([fn = std::move(fn)](GameWrapper*) { fn(); }, delay); },
+		[this]() { return SampleMacroContext(); },
+		[this](const std::vector<std::string>& args) { return BindMacroCommand(args); });
+	macros_->Define(MACRO_PAUSE, pauseCmdCvar.getStringValue());
+	macros_->Define(MACRO_RESET, resetCmdCvar.getStringValue());
+	pauseCmdCvar.addOnValueChanged([this](std::string, CVarWrapper cvar) { macros_->Define(MACRO_PAUSE, cvar.getStringValue()); });
+	resetCmdCvar.addOnValueChanged([this](std::string, CVarWrapper cvar) { macros_->Define(MACRO_RESET, cvar.getStringValue()); });
+
+	RegisterNotifier(NOTI_MACRO_DEFINE, [this](std::vector<std::string> args) {
+		if (args.size() < 3) { LOG("MAH: usage: {} <name> \"<commands>\"", NOTI_MACRO_DEFINE); return; }
+		macros_->Define(args[1], args[2]);
+		LOG("MAH: Macro {} compiled to {} step(s), {} called directly", args[1], macros_->StepCount(args[1]), macros_->BoundStepCount(args[1]));
+	}, "Define a reusable command macro", PERMISSION_ALL);
+	RegisterNotifier(NOTI_MACRO_RUN, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <name>", NOTI_MACRO_RUN); return; }
+		if (!macros_->Run(args[1])) LOG("MAH: Macro {} is empty or undefined", args[1]);
+	}, "Run a macro defined with mah_macro_define", PERMISSION_ALL);
+
+	RegisterNotifier(NOTI_BLUE_PLUS, [this](std::vector<std::string>) { AdjustBlueScore(+1); }, "Add 1 to Blue", PERMISSION_ALL);
+	RegisterNotifier(NOTI_ORANGE_PLUS, [this](std::vector<std::string>) { AdjustOrangeScore(+1); }, "Add 1 to Orange", PERMISSION_ALL);
+	RegisterNotifier(NOTI_BLUE_MINUS, [this](std::vector<std::string>) { AdjustBlueScore(-1); }, "Remove 1 from Blue", PERMISSION_ALL);
+	RegisterNotifier(NOTI_ORANGE_MINUS, [this](std::vector<std::string>) { AdjustOrangeScore(-1); }, "Remove 1 from Orange", PERMISSION_ALL);
+	RegisterNotifier(NOTI_PAUSE_TOGGLE, [this](std::vector<std::string>) { DoPauseToggle(); }, "Toggle server pause", PERMISSION_ALL);
+	RegisterNotifier(NOTI_RESET, [this](std::vector<std::string>) { DoKickoffReset(); }, "Reset to kickoff", PERMISSION_ALL);
+
+	RegisterNotifier(NOTI_SCHEDULE, [this](std::vector<std::string> args) {
+		if (args.size() < 3) { LOG("MAH: usage: {} <seconds> <command>", NOTI_SCHEDULE); return; }
+		float delay = std::strtof(args[1].c_str(), nullptr);
+		std::string cmd = args[2];
+		for (size_t i = 3; i < args.size(); ++i) cmd += " " + args[i];
+		ScheduleAction(delay, [this, cmd]() { cvarManager->executeCommand(cmd, false); }, TimerGroup_Match, cmd);
+		LOG("MAH: Scheduled '{}' in {:.1f}s", cmd, delay);
+	}, "Run a command after a delay, with an on-screen countdown", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SCHEDULE_CANCEL, [this](std::vector<std::string>) {
+		size_t n = timers_.CancelGroup(TimerGroup_Match);
+		countdowns_.clear();
+		LOG("MAH: Cancelled {} scheduled action(s)", n);
+	}, "Cancel all scheduled actions", PERMISSION_ALL);
+
+	cvarManager->registerCvar(CVAR_CONTROL_ENABLED, "0", "Accept commands on a local control socket", true, true, 0.f, true, 1.f)
+		.addOnValueChanged([this](std::string, CVarWrapper) { RestartControlServer(); });
+	cvarManager->registerCvar(CVAR_CONTROL_PORT, std::to_string(ControlProtocol::DEFAULT_PORT), "Loopback TCP port of the control socket", true, true, 1024.f, true, 65535.f)
+		.addOnValueChanged([this](std::string, CVarWrapper) { RestartControlServer(); });
+	RegisterNotifier(NOTI_CONTROL_STATS, [this](std::vector<std::string>) {
+		ControlStats st = control_.Stats();
+		LOG("MAH: Control socket {}: received={} dropped={} invalid={} max enqueue={}us; sequenced duplicates={} stale={}",
+			control_.IsRunning() ? "running" : "stopped", st.received, st.dropped, st.invalid, st.maxEnqueueNs / 1000,
+			sequencedDuplicates_, sequencedStale_);
+	}, "Print control socket counters", PERMISSION_ALL);
+	RestartControlServer();
+
+	cvarManager->registerCvar(CVAR_STREAM_ENABLED, "0", "Push match state to local subscribers", true, true, 0.f, true, 1.f)
+		.addOnValueChanged([this](std::string, CVarWrapper) { RestartStateStream(); });
+	cvarManager->registerCvar(CVAR_STREAM_PORT, std::to_string(StreamProtocol::DEFAULT_PORT), "Loopback TCP port of the state stream", true, true, 1024.f, true, 65535.f)
+		.addOnValueChanged([this](std::string, CVarWrapper) { RestartStateStream(); });
+	RegisterNotifier(NOTI_STREAM_STATS, [this](std::vector<std::string>) {
+		StreamStats st = stream_.Stats();
+		LOG("MAH: State stream {}: subscribers={} frames={} resyncs={} dropped={}",
+			stream_.IsRunning() ? "running" : "stopped", st.subscribers, st.frames, st.resyncs, st.dropped);
+	}, "Print state stream counters", PERMISSION_ALL);
+	RestartStateStream();
+
+	auto applyShm = [this](bool enabled) {
+		if (!enabled) { shm_.Close(); return; }
+		if (shm_.Open()) ExportScoreboard();
+		else LOG("MAH: Could not create shared-memory scoreboard");
+	};
+	cvarManager->registerCvar(CVAR_SHM_ENABLED, "0", "Export the scoreboard through shared memory", true, true, 0.f, true, 1.f)
+		.addOnValueChanged([applyShm](std::string, CVarWrapper cvar) { applyShm(cvar.getBoolValue()); });
+	applyShm(cvarManager->getCvar(CVAR_SHM_ENABLED).getBoolValue());
 
-	cvarManager->registerNotifier(NOTI_BLUE_PLUS, [this](std::vector<std::string>) { AdjustBlueScore(+1); }, "Add 1 to Blue", PERMISSION_ALL);
-	cvarManager->registerNotifier(NOTI_ORANGE_PLUS, [this](std::vector<std::string>) { AdjustOrangeScore(+1); }, "Add 1 to Orange", PERMISSION_ALL);
-	cvarManager->registerNotifier(NOTI_BLUE_MINUS, [this](std::vector<std::string>) { AdjustBlueScore(-1); }, "Remove 1 from Blue", PERMISSION_ALL);
-	cvarManager->registerNotifier(NOTI_ORANGE_MINUS, [this](std::vector<std::string>) { AdjustOrangeScore(-1); }, "Remove 1 from Orange", PERMISSION_ALL);
-	cvarManager->registerNotifier(NOTI_PAUSE_TOGGLE, [this](std::vector<std::string>) { DoPauseToggle(); }, "Toggle server pause", PERMISSION_ALL);
-	cvarManager->registerNotifier(NOTI_RESET, [this](std::vector<std::string>) { DoKickoffReset(); }, "Reset to kickoff", PERMISSION_ALL);
+	cvarManager->registerCvar(CVAR_CFG_WATCH, "1", "Apply external edits to matchadminhotkeys.cfg without reloading the plugin", true, true, 0.f, true, 1.f)
+		.addOnValueChanged([this](std::string, CVarWrapper) { RestartCfgWatcher(); });
+	RestartCfgWatcher();
+
+	if (series_.Open(gameWrapper->GetDataFolder() / "matchadminhotkeys" / SERIES_LOG_FILE))
+	{
+		if (const SeriesInfo* s = series_.Active()) LOG("MAH: Resumed series #{} ({} vs {})", s->id, s->teamA, s->teamB);
+	}
+	else
+	{
+		LOG("MAH: Could not open the series log; series tracking is disabled");
+	}
+	RegisterNotifier(NOTI_SERIES_START, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <best of> [blue team] [orange team]", NOTI_SERIES_START); return; }
+		StartSeries(std::atoi(args[1].c_str()), args.size() > 2 ? args[2] : "Blue", args.size() > 3 ? args[3] : "Orange");
+	}, "Start a best-of-N series; final scores of each match are recorded", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SERIES_STATUS, [this](std::vector<std::string> args) {
+		const SeriesInfo* s = args.size() > 1 ? series_.Find(static_cast<uint32_t>(std::strtoul(args[1].c_str(), nullptr, 10))) : series_.Active();
+		if (!s) { LOG("MAH: No such series ({} stored)", series_.SeriesCount()); return; }
+		LogSeriesStatus(*s);
+	}, "Print the standing and game history of a series", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SERIES_UNDO, [this](std::vector<std::string>) {
+		if (!series_.UndoLastGame()) { LOG("MAH: No recorded game to undo"); return; }
+		LogSeriesStatus(*series_.Active());
+		RecordAction("Series: last game removed");
+	}, "Remove the last recorded game of the active series", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SERIES_SWAP, [this](std::vector<std::string>) {
+		if (!series_.SwapSides()) { LOG("MAH: No active series"); return; }
+		const SeriesInfo* s = series_.Active();
+		LOG("MAH: {} now plays Blue, {} plays Orange", s->teamAIsOrange ? s->teamB : s->teamA, s->teamAIsOrange ? s->teamA : s->teamB);
+	}, "Swap which series team plays Blue", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SERIES_RESUME, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <series id>", NOTI_SERIES_RESUME); return; }
+		const uint32_t id = static_cast<uint32_t>(std::strtoul(args[1].c_str(), nullptr, 10));
+		if (!series_.Resume(id)) { LOG("MAH: Series #{} does not exist or has ended", id); return; }
+		LogSeriesStatus(*series_.Active());
+	}, "Make a stored series the active one", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SERIES_END, [this](std::vector<std::string>) {
+		const SeriesInfo* s = series_.Active();
+		if (!s) { LOG("MAH: No active series"); return; }
+		const uint32_t id = s->id;
+		LogSeriesStatus(*s);
+		series_.End();
+		LOG("MAH: Series #{} closed", id);
+	}, "Close the active series", PERMISSION_ALL);
+
+	RegisterNotifier(NOTI_MATCHES_LOAD, [this](std::vector<std::string> args) {
+		LoadSchedule(args.size() > 1 ? args[1] : std::string());
+	}, "Load the event schedule (default: data/matchadminhotkeys/schedule.csv)", PERMISSION_ALL);
+	RegisterNotifier(NOTI_MATCHES_NEXT, [this](std::vector<std::string>) {
+		if (scheduleNext_ >= schedule_.Size()) { LOG("MAH: No more scheduled matches"); return; }
+		StartScheduledMatch(scheduleNext_);
+	}, "Start series tracking for the next scheduled match", PERMISSION_ALL);
+	RegisterNotifier(NOTI_MATCHES_START, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <match id>", NOTI_MATCHES_START); return; }
+		const uint32_t row = schedule_.FindById(args[1]);
+		if (row == MatchSchedule::NO_ROW) { LOG("MAH: No scheduled match {}", args[1]); return; }
+		StartScheduledMatch(row);
+	}, "Start series tracking for a scheduled match by id", PERMISSION_ALL);
+	RegisterNotifier(NOTI_MATCHES_FIND, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <team>", NOTI_MATCHES_FIND); return; }
+		const std::vector<uint32_t>& rows = schedule_.RowsForTeam(args[1]);
+		if (rows.empty()) { LOG("MAH: {} has no scheduled matches", args[1]); return; }
+		for (uint32_t row : rows)
+			LOG("MAH:   {}: {} vs {} (Bo{}){}", schedule_.Id(row), schedule_.TeamA(row), schedule_.TeamB(row), schedule_.BestOf(row),
+				row < scheduleNext_ ? " - played" : "");
+	}, "List the scheduled matches of a team", PERMISSION_ALL);
+	scheduleTeams_.SetFuzzy(true);
+	LoadSchedule({});
+
+	RegisterNotifier(NOTI_SCENARIO_DEFINE, [this](std::vector<std::string> args) {
+		if (args.size() < 3) { LOG("MAH: usage: {} <name> \"<steps>\"", NOTI_SCENARIO_DEFINE); return; }
+		std::string error;
+		if (!scenarios_.Define(args[1], args[2], &error)) { LOG("MAH: Scenario {} not defined: {}", args[1], error); return; }
+		LOG("MAH: Scenario {} compiled to {} op(s)", args[1], scenarios_.Find(args[1])->ops.size());
+	}, "Define a game-state preset, e.g. \"blue 2; orange 1; clock 1:30; kickoff; pause\"", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SCENARIO_APPLY, [this](std::vector<std::string> args) {
+		if (args.size() < 2) { LOG("MAH: usage: {} <name>", NOTI_SCENARIO_APPLY); return; }
+		ApplyScenarioByName(args[1]);
+	}, "Apply a game-state preset in one tick", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SCENARIO_LIST, [this](std::vector<std::string>) {
+		for (const std::string& name : scenarios_.Names())
+			LOG("MAH:   {}: {}", name, scenarios_.Find(name)->source);
+	}, "List game-state presets", PERMISSION_ALL);
+	RegisterNotifier(NOTI_SCENARIO_RELOAD, [this](std::vector<std::string>) { LoadScenarios(); },
+		"Reload data/matchadminhotkeys/scenarios.txt", PERMISSION_ALL);
+	LoadScenarios();
+
+	// Counting only: the context is BakkesMod's, so blocks our ImGui calls allocate are freed by its copy of ImGui and vice versa.
+	imguiMem_.Install(ImGuiAllocator::Mode::Counting);
+	RegisterNotifier(NOTI_IMGUI_MEM, [this](std::vector<std::string>) {
+		const ImGuiAllocStats st = imguiMem_.Stats();
+		LOG("MAH: ImGui memory: live {} KB in {} block(s), peak {} KB; {} alloc(s), {} free(s) over {} frame(s); last frame {} alloc(s) ({} bytes), worst frame {}",
+			st.liveBytes / 1024, st.liveBlocks, st.peakBytes / 1024, st.allocs, st.frees, st.frames,
+			st.lastFrameAllocs, st.lastFrameBytes, st.peakFrameAllocs);
+		if (ImTextLayoutCacheIsEnabled())
+		{
+			const ImTextLayoutCacheStats& tc = ImTextLayoutCacheGetStats();
+			LOG("MAH: Text layout cache: {} entries, {} KB, {} hit(s), {} miss(es), {} eviction(s), {} flush(es)",
+				tc.Entries, tc.Bytes / 1024, tc.Hits, tc.Misses, tc.Evictions, tc.Flushes);
+		}
+	}, "Print allocation counters of the plugin's ImGui calls", PERMISSION_ALL);
+	// Only the plugin's own text calls go through it. Off by default.
+	cvarManager->registerCvar(CVAR_TEXT_CACHE, "0", "Cache text layout of the plugin's menus between frames", true, true, 0.f, true, 1.f)
+		.addOnValueChanged([](std::string, CVarWrapper cvar) { ImTextLayoutCacheSetEnabled(cvar.getBoolValue()); });
+	ImTextLayoutCacheSetEnabled(cvarManager->getCvar(CVAR_TEXT_CACHE).getBoolValue());
+
+	tickEpoch_ = std::chrono::steady_clock::now();
+	gameWrapper->HookEvent(HOOK_VIEWPORT_TICK, [this](std::string) { OnViewportTick(); });
+	gameWrapper->HookEvent(HOOK_MATCH_ENDED, [this](std::string) { RecordSeriesGame(); OnMatchEnded(); });
+	gameWrapper->HookEvent(HOOK_GAME_DESTROYED, [this](std::string) { OnMatchEnded(); });
+	gameWrapper->RegisterDrawable([this](CanvasWrapper canvas) { RenderCanvas(canvas); });
+
+	events_.Subscribe([this](const MatchEvent&) { ExportScoreboard(); });
+	gameWrapper->HookEventPost(HOOK_TEAM_SCORE_UPDATED, [this](std::string) {
+		PublishScores(scoreByAdmin_ ? MatchEventSource::Admin : MatchEventSource::Game);
+	});
+	gameWrapper->HookEventPost(HOOK_GOAL_SCORED, [this](std::string) { PublishScores(MatchEventSource::Game); });
+	gameWrapper->HookEventPost(HOOK_KICKOFF_COUNTDOWN, [this](std::string) { OnKickoffCountdown(); });
+	SyncMatchState();	// Loaded mid-match
+	macros_->Recompile();	// The pause/reset macros were compiled before the notifiers and cvars they call existed
 
 	LoadKeyCvarsToUi();
 	SnapshotLastSaved();
 }
 
+void MatchAdminHotkeys::onUnload()
+{
+	control_.Stop();
+	stream_.Stop();
+	shm_.Close();
+	cfgWatcher_.Stop();
+	series_.Close();
+	macros_.reset();	// Expires the token that pending macro delays check
+	ImTextLayoutCacheSetEnabled(false);
+	imguiMem_.Uninstall();
+}
+
 void MatchAdminHotkeys::AdjustBlueScore(int delta)
 {
 	if (delta == 0) return;
@@ -276,8 +612,12 @@ void MatchAdminHotkeys::AdjustBlueScore(int delta)
 	int current = blue.GetScore();
 	int next = current + delta;
 	if (next < 0) next = 0;
+	scoreByAdmin_ = true;
 	blue.SetScore(next);
 	LOG("MAH: Blue score {} -> {}", current, next);
+	PublishScores(MatchEventSource::Admin);
+	scoreByAdmin_ = false;
+	RecordAction(std::format("Blue {} -> {}", current, next));
 }
 
 void MatchAdminHotkeys::AdjustOrangeScore(int delta)
@@ -290,8 +630,12 @@ void MatchAdminHotkeys::AdjustOrangeScore(int delta)
 	int current = orange.GetScore();
 	int next = current + delta;
 	if (next < 0) next = 0;
+	scoreByAdmin_ = true;
 	orange.SetScore(next);
 	LOG("MAH: Orange score {} -> {}", current, next);
+	PublishScores(MatchEventSource::Admin);
+	scoreByAdmin_ = false;
+	RecordAction(std::format("Orange {} -> {}", current, next));
 }
 
 void MatchAdminHotkeys::DoPauseToggle()
@@ -306,22 +650,34 @@ void MatchAdminHotkeys::DoPauseToggle()
 		LOG("MAH: Pause toggle skipped (no server).");
 		return;
 	}
+	if (timers_.Cancel(unpauseTimer_)) {
+		unpauseTimer_ = 0;
+		LOG("MAH: Unpause countdown cancelled.");
+		return;
+	}
 	PlayerControllerWrapper pauser = server.GetPauser();
 	if (pauser) {
+		int countdown = cvarManager->getCvar(CVAR_UNPAUSE_COUNTDOWN).getIntValue();
+		if (countdown > 0) {
+			StartUnpauseCountdown(countdown);
+			return;
+		}
 		server.SetPaused(pauser, 0);
 		LOG("MAH: Unpaused via ServerWrapper::SetPaused(false).");
+		PublishPause(false, MatchEventSource::Admin);
+		RecordAction("Unpaused");
 		return;
 	}
 	auto pcOpt = GetLocalPC(gameWrapper.get(), server);
 	if (pcOpt.has_value()) {
 		server.SetPaused(pcOpt.value(), 1);
 		LOG("MAH: Paused via ServerWrapper::SetPaused(true).");
+		PublishPause(true, MatchEventSource::Admin);
+		RecordAction("Paused");
 		return;
 	}
-	std::string userCmds = cvarManager->getCvar(CVAR_PAUSE_CMD).getStringValue();
-	if (!userCmds.empty()) {
-		ExecMulti(cvarManager, userCmds);
-		LOG("MAH: Executed fallback pause cmd(s): {}", userCmds);
+	if (macros_->Run(MACRO_PAUSE)) {
+		LOG("MAH: Executed fallback pause macro ({} step(s)).", macros_->StepCount(MACRO_PAUSE));
 	}
 	else {
 		LOG("MAH: Could not resolve a PlayerController to pause/unpause, and no pause commands configured.");
@@ -340,15 +696,13 @@ void MatchAdminHotkeys::DoKickoffReset()
 		LOG("MAH: Kickoff reset skipped (no server).");
 		return;
 	}
-	{
-		std::string cmd = cvarManager->getCvar(CVAR_RESET_CMD).getStringValue();
-		if (!cmd.empty()) {
-			ExecMulti(cvarManager, cmd);
-			LOG("MAH: Executed reset cmd(s): {}", cmd);
-		}
+	if (macros_->Run(MACRO_RESET)) {
+		LOG("MAH: Executed reset macro ({} step(s)).", macros_->StepCount(MACRO_RESET));
 	}
+	kickoffByAdmin_ = true;
 	server.StartNewRound();
 	LOG("MAH: StartNewRound() called for kickoff reset.");
+	RecordAction("Reset to kickoff");
 	PlayerControllerWrapper currentPauser = server.GetPauser();
 	if (currentPauser) {
 		LOG("MAH: Server already paused after StartNewRound().");
@@ -358,12 +712,11 @@ void MatchAdminHotkeys::DoKickoffReset()
 	if (pcOpt.has_value()) {
 		server.SetPaused(pcOpt.value(), 1);
 		LOG("MAH: Paused after StartNewRound() to await manual unpause.");
+		PublishPause(true, MatchEventSource::Admin);
 		return;
 	}
-	std::string pauseCmds = cvarManager->getCvar(CVAR_PAUSE_CMD).getStringValue();
-	if (!pauseCmds.empty()) {
-		ExecMulti(cvarManager, pauseCmds);
-		LOG("MAH: Executed fallback post-reset pause cmd(s): {}", pauseCmds);
+	if (macros_->Run(MACRO_PAUSE)) {
+		LOG("MAH: Executed fallback post-reset pause macro ({} step(s)).", macros_->StepCount(MACRO_PAUSE));
 	}
 	else {
 		LOG("MAH: Could not resolve PlayerController to pause after reset, and no pause commands configured.");
@@ -372,6 +725,8 @@ void MatchAdminHotkeys::DoKickoffReset()
 
 void MatchAdminHotkeys::RenderSettings()
 {
+	imguiMem_.BeginFrame(ImGui::GetFrameCount());
+	ImTextLayoutCacheNewFrame(ImGui::GetFrameCount());
 	const float leftPadding = 24.f;
 
 	ImGui::Dummy(ImVec2(0.f, 20.f));
@@ -384,6 +739,21 @@ void MatchAdminHotkeys::RenderSettings()
 		LOG("MAH: Settings toggled enabled={}", enabled ? "true" : "false");
 	}
 
+	if (ImGui::Button("Toggle Scoreboard Overlay"))
+	{
+		gameWrapper->Execute([this](GameWrapper*) { cvarManager->executeCommand("togglemenu " + GetMenuName()); });
+	}
+
+	int unpauseCountdown = cvarManager->getCvar(CVAR_UNPAUSE_COUNTDOWN).getIntValue();
+	ImGui::SetNextItemWidth(200.f);
+	if (ImGui::SliderInt("Unpause countdown (seconds, 0 = instant)", &unpauseCountdown, 0, 10))
+	{
+		cvarManager->getCvar(CVAR_UNPAUSE_COUNTDOWN).setValue(unpauseCountdown);
+	}
+
+	RenderSchedulePanel();
+	RenderScenarioPanel();
+
 	ImGui::Dummy(ImVec2(0.f, 16.f));
 	ImGui::TextColored(ImVec4(1.f, 1.f, 0.f, 1.f),
 		"It's best to avoid binding keys already assigned \n"
@@ -622,6 +992,127 @@ void MatchAdminHotkeys::RenderSettings()
 }
 
 
+void MatchAdminHotkeys::Render()
+{
+	imguiMem_.BeginFrame(ImGui::GetFrameCount());
+	ImTextLayoutCacheNewFrame(ImGui::GetFrameCount());
+	PluginWindowBase::Render();
+}
+
+void MatchAdminHotkeys::RenderWindow()
+{
+	overlay_.Render(SampleScoreboard(), lastAction_);
+}
+
+ScoreboardState MatchAdminHotkeys::SampleScoreboard()
+{
+	ScoreboardState st;
+	st.actionSerial = actionSerial_;
+	auto teamsOpt = FindTeams(gameWrapper.get());
+	if (!teamsOpt) return st;
+	ServerWrapper server = gameWrapper->GetCurrentGameState();
+	st.inGame = true;
+	st.blue = matchState_.blue;
+	st.orange = matchState_.orange;
+	st.secondsRemaining = server.GetSecondsRemaining();
+	st.overtime = server.GetbOverTime();
+	st.paused = static_cast<bool>(server.GetPauser());
+	if (const SeriesInfo* s = series_.Active())
+	{
+		st.seriesBestOf = s->bestOf;
+		st.seriesGame = s->GamesPlayed() + (s->Decided() ? 0 : 1);
+		st.seriesBlueWins = s->teamAIsOrange ? s->winsB : s->winsA;
+		st.seriesOrangeWins = s->teamAIsOrange ? s->winsA : s->winsB;
+	}
+	return st;
+}
+
+void MatchAdminHotkeys::RecordAction(std::string text)
+{
+	lastAction_ = std::move(text);
+	++actionSerial_;
+	ExportScoreboard();
+}
+
+void MatchAdminHotkeys::ExportScoreboard()
+{
+	if (!shm_.IsOpen()) return;
+	const ScoreboardState st = SampleScoreboard();
+	ScoreboardShm::Values v;
+	v.blue = st.blue;
+	v.orange = st.orange;
+	v.secondsRemaining = st.secondsRemaining;
+	v.flags = (st.inGame ? ScoreboardShm::Flag_InGame : 0u)
+		| (st.paused ? ScoreboardShm::Flag_Paused : 0u)
+		| (st.overtime ? ScoreboardShm::Flag_Overtime : 0u);
+	v.actionCounter = actionSerial_;
+	v.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+	shm_.Write(v);
+}
+
+void MatchAdminHotkeys::PublishMatchEvent(MatchEventType type, MatchEventSource source)
+{
+	matchState_.type = type;
+	matchState_.source = source;
+	events_.Publish(matchState_);
+}
+
+void MatchAdminHotkeys::PublishScores(MatchEventSource source)
+{
+	auto teamsOpt = FindTeams(gameWrapper.get());
+	if (!teamsOpt) return;
+	const int blue = teamsOpt->first.GetScore();
+	const int orange = teamsOpt->second.GetScore();
+	// Admin changes may also fire the team score hook; only the first report publishes.
+	if (blue == matchState_.blue && orange == matchState_.orange) return;
+	matchState_.blue = blue;
+	matchState_.orange = orange;
+	PublishMatchEvent(MatchEventType::ScoreChanged, source);
+}
+
+void MatchAdminHotkeys::PublishPause(bool paused, MatchEventSource source)
+{
+	matchState_.paused = paused;
+	PublishMatchEvent(MatchEventType::PauseChanged, source);
+}
+
+void MatchAdminHotkeys::OnKickoffCountdown()
+{
+	const MatchEventSource source = kickoffByAdmin_ ? MatchEventSource::Admin : MatchEventSource::Game;
+	kickoffByAdmin_ = false;
+	// Kickoffs also resync scores after joining a match mid-way.
+	if (auto teamsOpt = FindTeams(gameWrapper.get()))
+	{
+		matchState_.blue = teamsOpt->first.GetScore();
+		matchState_.orange = teamsOpt->second.GetScore();
+	}
+	PublishMatchEvent(MatchEventType::KickoffReset, source);
+}
+
+// Seeds the tracked state from the server the first time a match is seen
+// (loaded or joined mid-match), then reports pauses the plugin did not make:
+// other admins, the pause menu of a local host, the server itself.
+void MatchAdminHotkeys::SyncMatchState()
+{
+	if (!gameWrapper->IsInGame()) return;
+	ServerWrapper server = gameWrapper->GetCurrentGameState();
+	if (!server) return;
+	const bool paused = static_cast<bool>(server.GetPauser());
+	if (!matchStateSeeded_)
+	{
+		auto teamsOpt = FindTeams(gameWrapper.get());
+		if (!teamsOpt) return;
+		matchState_.blue = teamsOpt->first.GetScore();
+		matchState_.orange = teamsOpt->second.GetScore();
+		matchState_.paused = paused;
+		matchStateSeeded_ = true;
+		ExportScoreboard();
+		return;
+	}
+	if (paused != matchState_.paused) PublishPause(paused, MatchEventSource::Game);
+}
+
 std::string MatchAdminHotkeys::GetPluginName()
 {
 	return "MatchAdminHotkeys";
@@ -649,12 +1140,516 @@ void MatchAdminHotkeys::LoadKeyCvarsToUi()
 	NormalizeKey(ui_key_reset);
 }
 
+void MatchAdminHotkeys::RegisterNotifier(const std::string& name, std::function<void(std::vector<std::string>)> fn, const std::string& description, unsigned char permissions)
+{
+	notifiers_[name] = fn;
+	cvarManager->registerNotifier(name, std::move(fn), description, permissions);
+}
+
+// Resolves a macro step to a direct call when it targets one of the plugin's notifiers, or sets one of its cvars
+// ("mah_x <value>"). Anything else stays a console command: another plugin's cvar can be unregistered while a
+// macro still holds it.
+std::function<void()> MatchAdminHotkeys::BindMacroCommand(const std::vector<std::string>& args)
+{
+	if (args.empty()) return nullptr;
+	if (auto it = notifiers_.find(args[0]); it != notifiers_.end())
+		return [fn = it->second, args]() { fn(args); };
+	if (args.size() == 2 && args[0].rfind("mah_", 0) == 0)
+	{
+		CVarWrapper cvar = cvarManager->getCvar(args[0]);
+		if (!cvar.IsNull()) return [cvar, value = args[1]]() mutable { cvar.setValue(value); };
+	}
+	return nullptr;
+}
+
+MacroContext MatchAdminHotkeys::SampleMacroContext()
+{
+	MacroContext ctx;
+	if (!gameWrapper || !gameWrapper->IsInGame()) return ctx;
+	ServerWrapper server = gameWrapper->GetCurrentGameState();
+	if (!server) return ctx;
+	ctx.paused = static_cast<bool>(server.GetPauser());
+	ctx.overtime = server.GetbOverTime();
+	return ctx;
+}
+
+TimerHandle MatchAdminHotkeys::ScheduleAction(float delaySeconds, std::function<void()> fn, uint32_t group, std::string countdownLabel)
+{
+	const double ticks = std::ceil(std::max(0.f, delaySeconds) * TIMER_TICK_HZ);
+	TimerHandle handle = timers_.Schedule(static_cast<uint64_t>(ticks), std::move(fn), group);
+	if (!countdownLabel.empty())
+	{
+		countdowns_.push_back({ handle, std::move(countdownLabel) });
+	}
+	return handle;
+}
+
+void MatchAdminHotkeys::OnViewportTick()
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - tickEpoch_;
+	timers_.Advance(static_cast<uint64_t>(elapsed.count() * TIMER_TICK_HZ));
+	control_.Drain([this](const ControlCommand& cmd) { DispatchControl(cmd); });
+	if (const uint64_t dropped = control_.Dropped(); dropped != controlDropped_)
+	{
+		LOG("MAH: Control socket queue full: dropped {} command(s) ({} total)", dropped - controlDropped_, dropped);
+		controlDropped_ = dropped;
+	}
+	const ResolvedActions resolved = sequencer_.Resolve();
+	if (!resolved.Empty()) ApplyResolvedActions(resolved);
+	SyncMatchState();
+	if (stream_.IsRunning()) PublishStreamSnapshot();
+	if (cfgWatcher_.Poll(std::chrono::steady_clock::now())) ApplyCfgChanges();
+}
+
+void MatchAdminHotkeys::RestartCfgWatcher()
+{
+	cfgWatcher_.Stop();
+	if (!cvarManager->getCvar(CVAR_CFG_WATCH).getBoolValue()) return;
+	const std::filesystem::path file = CfgPath(gameWrapper.get());
+	std::string text;
+	ReadTextFile(file, text);
+	cfgDelta_.Reset(text);
+	cfgWatcher_.Start(file);
+	LOG("MAH: Watching {} ({})", file.string(), cfgWatcher_.Backend());
+}
+
+// Applies only what changed in the cfg since it was last seen: rebinds the
+// keys that moved and sets cvars whose value differs, instead of the
+// scrub/unbind/exec/writeconfig cycle used when saving from the UI.
+void MatchAdminHotkeys::ApplyCfgChanges()
+{
+	std::string text;
+	if (!ReadTextFile(CfgPath(gameWrapper.get()), text)) return;
+	const std::vector<std::string> changed = cfgDelta_.Update(text);
+	if (changed.empty()) return;
+
+	CfgSettings cfg;
+	for (const std::string& line : changed) ParseCfgLine(line, cfg);
+
+	// All unbinds go before all binds so swapping two keys works.
+	std::string unbinds, binds;
+	int rebound = 0;
+	for (const ManagedKey& k : MANAGED_KEYS)
+	{
+		auto it = cfg.binds.find(k.notifier);
+		if (it == cfg.binds.end()) continue;
+		std::string key = it->second;
+		NormalizeKey(key);
+		if (key.empty() || key[0] < 'A' || key[0] > 'Z') { LOG("MAH: cfg: ignored bind '{}' for {}", it->second, k.notifier); continue; }
+		CVarWrapper cvar = cvarManager->getCvar(k.cvar);
+		const std::string old = cvar.getStringValue();
+		if (key == old) continue;
+		if (!old.empty()) unbinds += std::format("unbind {};unbind {};", old, static_cast<char>(std::tolower(static_cast<unsigned char>(old[0]))));
+		binds += std::format("bind {} {};", key, k.notifier);
+		cvar.setValue(key);
+		// Keep an in-progress edit in the settings field; otherwise follow the file.
+		if (*k.ui == *k.last) *k.ui = key;
+		*k.last = key;
+		++rebound;
+	}
+	if (!binds.empty()) cvarManager->executeCommand(unbinds + binds);
+
+	int updated = 0;
+	for (const auto& [name, value] : cfg.cvars)
+	{
+		if (name.rfind("mah_", 0) != 0) continue;
+		CVarWrapper cvar = cvarManager->getCvar(name);
+		if (cvar.IsNull() || cvar.getStringValue() == value) continue;
+		cvar.setValue(value);
+		++updated;
+	}
+
+	LOG("MAH: cfg changed ({} line(s)): {} key(s) rebound, {} cvar(s) updated", changed.size(), rebound, updated);
+	if (rebound + updated > 0) gameWrapper->Toast("MatchAdminHotkeys", "Config reloaded");
+}
+
+void MatchAdminHotkeys::RestartControlServer()
+{
+	control_.Stop();
+	if (!cvarManager->getCvar(CVAR_CONTROL_ENABLED).getBoolValue()) return;
+	const int port = cvarManager->getCvar(CVAR_CONTROL_PORT).getIntValue();
+	if (control_.Start(static_cast<uint16_t>(port)))
+		LOG("MAH: Control socket listening on 127.0.0.1:{}", port);
+	else
+		LOG("MAH: Could not open control socket on 127.0.0.1:{}", port);
+}
+
+void MatchAdminHotkeys::RestartStateStream()
+{
+	stream_.Stop();
+	lastStreamSnapshot_ = StreamSnapshot{};
+	if (!cvarManager->getCvar(CVAR_STREAM_ENABLED).getBoolValue()) return;
+	const int port = cvarManager->getCvar(CVAR_STREAM_PORT).getIntValue();
+	if (stream_.Start(static_cast<uint16_t>(port)))
+		LOG("MAH: State stream listening on 127.0.0.1:{}", port);
+	else
+		LOG("MAH: Could not open state stream on 127.0.0.1:{}", port);
+}
+
+void MatchAdminHotkeys::PublishStreamSnapshot()
+{
+	const ScoreboardState st = SampleScoreboard();
+	StreamSnapshot snap;
+	snap.blue = static_cast<int16_t>(st.blue);
+	snap.orange = static_cast<int16_t>(st.orange);
+	snap.secondsRemaining = static_cast<int16_t>(st.secondsRemaining);
+	snap.flags = (st.inGame ? StreamProtocol::Flag_InGame : 0)
+		| (st.paused ? StreamProtocol::Flag_Paused : 0)
+		| (st.overtime ? StreamProtocol::Flag_Overtime : 0);
+	snap.actionSerial = st.actionSerial;
+	if (snap.blue == lastStreamSnapshot_.blue && snap.orange == lastStreamSnapshot_.orange
+		&& snap.secondsRemaining == lastStreamSnapshot_.secondsRemaining && snap.flags == lastStreamSnapshot_.flags
+		&& snap.actionSerial == lastStreamSnapshot_.actionSerial && lastStreamSnapshot_.timestampNs != 0)
+		return;
+
+	snap.actionLen = static_cast<uint8_t>(std::min(lastAction_.size(), StreamProtocol::MAX_ACTION_TEXT));
+	std::memcpy(snap.action, lastAction_.data(), snap.actionLen);
+	snap.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+	stream_.Publish(snap);
+	lastStreamSnapshot_ = snap;
+}
+
+void MatchAdminHotkeys::DispatchControl(const ControlCommand& cmd)
+{
+	switch (cmd.op)
+	{
+	case ControlProtocol::Op_BluePlus: AdjustBlueScore(+1); break;
+	case ControlProtocol::Op_BlueMinus: AdjustBlueScore(-1); break;
+	case ControlProtocol::Op_OrangePlus: AdjustOrangeScore(+1); break;
+	case ControlProtocol::Op_OrangeMinus: AdjustOrangeScore(-1); break;
+	case ControlProtocol::Op_PauseToggle: DoPauseToggle(); break;
+	case ControlProtocol::Op_ResetKickoff: DoKickoffReset(); break;
+	case ControlProtocol::Op_Sequenced:
+	{
+		AdminCommand ac;
+		ac.seat = cmd.seat;
+		ac.seq = cmd.seq;
+		ac.key = cmd.key;
+		ac.team = cmd.team;
+		ac.value = cmd.value;
+		switch (cmd.kind)
+		{
+		case ControlProtocol::Seq_ScoreDelta: ac.kind = AdminOpKind::ScoreDelta; break;
+		case ControlProtocol::Seq_ScoreSet: ac.kind = AdminOpKind::ScoreSet; break;
+		case ControlProtocol::Seq_PauseToggle: ac.kind = AdminOpKind::PauseToggle; break;
+		case ControlProtocol::Seq_ResetKickoff: ac.kind = AdminOpKind::ResetKickoff; break;
+		default: return;
+		}
+		switch (sequencer_.Submit(ac))
+		{
+		case ActionSequencer::Verdict::Duplicate: ++sequencedDuplicates_; break;
+		case ActionSequencer::Verdict::Stale: ++sequencedStale_; break;
+		default: break;
+		}
+		break;
+	}
+	default: break;
+	}
+}
+
+void MatchAdminHotkeys::ApplyResolvedActions(const ResolvedActions& actions)
+{
+	if (cvarManager->getCvar(CVAR_ENABLED).getBoolValue() == false) { LOG("MAH: Ignored sequenced commands (disabled)"); return; }
+	if (actions.setScore[0] || actions.setScore[1] || actions.scoreDelta[0] != 0 || actions.scoreDelta[1] != 0)
+	{
+		auto teamsOpt = FindTeams(gameWrapper.get());
+		if (!teamsOpt) { LOG("MAH: Could not resolve teams"); return; }
+		TeamWrapper teams[2] = { teamsOpt->first, teamsOpt->second };
+		const char* names[2] = { "Blue", "Orange" };
+		for (int t = 0; t < 2; ++t)
+		{
+			if (!actions.setScore[t] && actions.scoreDelta[t] == 0) continue;
+			const int current = teams[t].GetScore();
+			int next = actions.setScore[t].value_or(current) + actions.scoreDelta[t];
+			if (next < 0) next = 0;
+			if (next == current) continue;
+			scoreByAdmin_ = true;
+			teams[t].SetScore(next);
+			LOG("MAH: {} score {} -> {} (sequenced)", names[t], current, next);
+			PublishScores(MatchEventSource::Admin);
+			scoreByAdmin_ = false;
+			RecordAction(std::format("{} {} -> {}", names[t], current, next));
+		}
+	}
+	if (actions.pauseToggle) DoPauseToggle();
+	if (actions.resetKickoff) DoKickoffReset();
+}
+
+void MatchAdminHotkeys::StartUnpauseCountdown(int seconds)
+{
+	unpauseTimer_ = ScheduleAction(static_cast<float>(seconds), [this]() {
+		unpauseTimer_ = 0;
+		if (!gameWrapper->IsInGame()) return;
+		ServerWrapper server = gameWrapper->GetCurrentGameState();
+		if (!server) return;
+		PlayerControllerWrapper pauser = server.GetPauser();
+		if (!pauser) {
+			LOG("MAH: Unpause countdown finished but the server is no longer paused.");
+			return;
+		}
+		server.SetPaused(pauser, 0);
+		LOG("MAH: Unpaused after countdown.");
+		PublishPause(false, MatchEventSource::Admin);
+		RecordAction("Unpaused after countdown");
+	}, TimerGroup_Match);
+	LOG("MAH: Unpausing in {}s (press again to cancel).", seconds);
+	RecordAction(std::format("Unpause countdown ({}s)", seconds));
+}
+
+void MatchAdminHotkeys::OnMatchEnded()
+{
+	size_t n = timers_.CancelGroup(TimerGroup_Match);
+	countdowns_.clear();
+	unpauseTimer_ = 0;
+	matchState_ = MatchEvent{};
+	matchStateSeeded_ = false;
+	sequencer_.Reset();
+	if (n > 0) LOG("MAH: Match ended; cancelled {} scheduled action(s)", n);
+}
+
+void MatchAdminHotkeys::RecordSeriesGame()
+{
+	const SeriesInfo* s = series_.Active();
+	if (!s || s->Decided()) return;
+	auto teamsOpt = FindTeams(gameWrapper.get());
+	if (!teamsOpt) return;
+	const int blue = teamsOpt->first.GetScore();
+	const int orange = teamsOpt->second.GetScore();
+	const bool overtime = gameWrapper->GetCurrentGameState().GetbOverTime();
+	if (!series_.RecordGame(blue, orange, overtime, static_cast<int64_t>(std::time(nullptr))))
+	{
+		LOG("MAH: Could not record game {}-{} to the series log", blue, orange);
+		return;
+	}
+	LogSeriesStatus(*s);
+	RecordAction(std::format("Series game {}: {}-{}", s->GamesPlayed(), blue, orange));
+}
+
+bool MatchAdminHotkeys::StartSeries(int bestOf, const std::string& teamAArg, const std::string& teamBArg)
+{
+	// Look up with the names Start() would store, so empty and over-long names resume too.
+	const std::string teamA = SeriesTracker::TeamName(teamAArg, "Blue");
+	const std::string teamB = SeriesTracker::TeamName(teamBArg, "Orange");
+	// Starting a series that is already running for the same teams picks it back up.
+	const SeriesInfo* existing = series_.FindByTeams(teamA, teamB);
+	if (existing && !existing->closed && !existing->Decided() && existing->bestOf == bestOf && series_.Resume(existing->id))
+	{
+		LogSeriesStatus(*existing);
+		return true;
+	}
+	const uint32_t id = series_.Start(bestOf, teamA, teamB);
+	if (id == 0) { LOG("MAH: Could not start series (best of must be odd, 1-99)"); return false; }
+	LOG("MAH: Started series #{}: {} vs {}, best of {}", id, teamA, teamB, bestOf);
+	RecordAction(std::format("Series #{} started (Bo{})", id, bestOf));
+	return true;
+}
+
+void MatchAdminHotkeys::LoadSchedule(const std::string& path)
+{
+	const std::filesystem::path file = path.empty() ? gameWrapper->GetDataFolder() / "matchadminhotkeys" / SCHEDULE_FILE : std::filesystem::path(path);
+	const auto start = std::chrono::steady_clock::now();
+	const MatchSchedule::LoadResult r = schedule_.Load(file);
+	const std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+	scheduleNext_ = 0;
+	scheduleRowsDirty_ = true;
+	scheduleTeams_.SetItems(schedule_.TeamNames());
+	scheduleTeam_ = -1;
+	if (!r.opened)
+	{
+		// The default file is optional; only an explicit path is worth a message.
+		if (!path.empty()) LOG("MAH: Could not open schedule {}", file.string());
+		return;
+	}
+	LOG("MAH: Loaded {} scheduled match(es) from {} in {:.1f}ms ({} line(s) skipped)", r.rows, file.string(), took.count(), r.skipped);
+	if (r.badQuotes > 0) LOG("MAH: {} schedule line(s) have unbalanced quotes; quoted fields cannot span lines", r.badQuotes);
+}
+
+void MatchAdminHotkeys::StartScheduledMatch(uint32_t row)
+{
+	if (!StartSeries(schedule_.BestOf(row), schedule_.TeamA(row), schedule_.TeamB(row))) return;
+	scheduleNext_ = row + 1;
+	const std::string& map = schedule_.Map(row);
+	LOG("MAH: Match {}: {} (Blue) vs {} (Orange){}", schedule_.Id(row), schedule_.TeamA(row), schedule_.TeamB(row),
+		map.empty() ? std::string() : std::format(" on {}", map));
+}
+
+void MatchAdminHotkeys::RenderSchedulePanel()
+{
+	if (!ImGui::CollapsingHeader("Match schedule")) return;
+
+	if (ImGui::Button("Reload")) LoadSchedule({});
+	ImGui::SameLine();
+	const bool hasNext = scheduleNext_ < schedule_.Size();
+	if (ButtonMaybeDisabled("Start next match", !hasNext, ImVec2(0.f, 0.f)))
+		StartScheduledMatch(scheduleNext_);
+	if (hasNext)
+	{
+		ImGui::SameLine();
+		ImGui::Text("%s: %s vs %s (Bo%d)", schedule_.Id(scheduleNext_).c_str(), schedule_.TeamA(scheduleNext_).c_str(),
+			schedule_.TeamB(scheduleNext_).c_str(), schedule_.BestOf(scheduleNext_));
+	}
+
+	ImGui::SetNextItemWidth(240.f);
+	if (ImGui::InputTextWithHint("##schedule_filter", "Filter by id, team or map", scheduleFilter_, sizeof(scheduleFilter_)))
+		scheduleRowsDirty_ = true;
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(200.f);
+	if (ImGui::IndexedSearchableCombo("##schedule_team", &scheduleTeam_, scheduleTeams_, "Jump to team", "Search teams", 12, "No teams found"))
+	{
+		std::snprintf(scheduleFilter_, sizeof(scheduleFilter_), "%s", scheduleTeams_.Items[scheduleTeam_].c_str());
+		scheduleRowsDirty_ = true;
+	}
+
+	// The filtered row list only changes with the filter or a reload, not per frame.
+	if (scheduleRowsDirty_)
+	{
+		scheduleRowsDirty_ = false;
+		scheduleRows_.clear();
+		std::string needle = scheduleFilter_;
+		std::transform(needle.begin(), needle.end(), needle.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		auto contains = [&needle](const std::string& hay) {
+			return std::search(hay.begin(), hay.end(), needle.begin(), needle.end(),
+				[](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; }) != hay.end();
+		};
+		for (uint32_t row = 0; row < schedule_.Size(); ++row)
+		{
+			if (needle.empty() || contains(schedule_.Id(row)) || contains(schedule_.TeamA(row))
+				|| contains(schedule_.TeamB(row)) || contains(schedule_.Map(row)))
+				scheduleRows_.push_back(row);
+		}
+	}
+
+	ImGui::BeginChild("##schedule_rows", ImVec2(0.f, 240.f), true);
+	ImGui::Columns(4, "##schedule_cols");
+	ImGui::TextDisabled("Id"); ImGui::NextColumn();
+	ImGui::TextDisabled("Match"); ImGui::NextColumn();
+	ImGui::TextDisabled("Best of"); ImGui::NextColumn();
+	ImGui::TextDisabled("Map"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	// Only the visible rows are submitted, so thousands of matches cost the same as a screenful.
+	ImGuiListClipper clipper(static_cast<int>(scheduleRows_.size()));
+	while (clipper.Step())
+	{
+		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+		{
+			const uint32_t row = scheduleRows_[i];
+			ImGui::PushID(static_cast<int>(row));
+			const bool played = row < scheduleNext_;
+			if (played) ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+			if (ImGui::Selectable(schedule_.Id(row).c_str(), row == scheduleNext_, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick)
+				&& ImGui::IsMouseDoubleClicked(0))
+				StartScheduledMatch(row);
+			ImGui::NextColumn();
+			ImGui::Text("%s vs %s", schedule_.TeamA(row).c_str(), schedule_.TeamB(row).c_str()); ImGui::NextColumn();
+			ImGui::Text("%d", schedule_.BestOf(row)); ImGui::NextColumn();
+			ImGui::TextUnformatted(schedule_.Map(row).c_str()); ImGui::NextColumn();
+			if (played) ImGui::PopStyleColor();
+			ImGui::PopID();
+		}
+	}
+	ImGui::Columns(1);
+	ImGui::EndChild();
+	ImGui::TextDisabled("Double-click a row to start that match.");
+}
+
+void MatchAdminHotkeys::LoadScenarios()
+{
+	const std::filesystem::path file = gameWrapper->GetDataFolder() / "matchadminhotkeys" / SCENARIO_FILE;
+	std::vector<std::string> errors;
+	const size_t n = scenarios_.LoadFile(file.string(), &errors);
+	for (const std::string& e : errors) LOG("MAH: {}: {}", file.string(), e);
+	if (n > 0) LOG("MAH: Loaded {} scenario(s) from {}", n, file.string());
+}
+
+void MatchAdminHotkeys::ApplyScenarioByName(const std::string& name)
+{
+	if (cvarManager->getCvar(CVAR_ENABLED).getBoolValue() == false) { LOG("MAH: Ignored scenario (disabled)"); return; }
+	const Scenario* found = scenarios_.Find(name);
+	if (!found) { LOG("MAH: Unknown scenario {}", name); return; }
+	const auto requested = std::chrono::steady_clock::now();
+	// Copied so a redefinition before the callback runs cannot change it mid-apply.
+	gameWrapper->Execute([this, name, scenario = *found, requested](GameWrapper* gw) {
+		const auto start = std::chrono::steady_clock::now();
+		auto teamsOpt = FindTeams(gw);
+		if (!teamsOpt) { LOG("MAH: Scenario {} skipped (not in game)", name); return; }
+		ServerScenarioTarget target{ gw, gw->GetCurrentGameState(), *teamsOpt };
+		scoreByAdmin_ = true;
+		ApplyScenario(scenario, target);
+		const auto done = std::chrono::steady_clock::now();
+
+		if (target.kickoff) kickoffByAdmin_ = true;
+		PublishScores(MatchEventSource::Admin);
+		scoreByAdmin_ = false;
+		if (target.pauseChanged) PublishPause(target.paused, MatchEventSource::Admin);
+		RecordAction(std::format("Scenario {}", name));
+		LOG("MAH: Scenario {} applied: {} op(s) in {}us, {}us after the request", name, scenario.ops.size(),
+			std::chrono::duration_cast<std::chrono::microseconds>(done - start).count(),
+			std::chrono::duration_cast<std::chrono::microseconds>(done - requested).count());
+	});
+}
+
+void MatchAdminHotkeys::RenderScenarioPanel()
+{
+	if (!ImGui::CollapsingHeader("Scenarios")) return;
+	const std::vector<std::string> names = scenarios_.Names();
+	if (names.empty())
+		ImGui::TextDisabled("No scenarios. Add 'name: steps' lines to data/matchadminhotkeys/scenarios.txt.");
+	for (const std::string& name : names)
+	{
+		if (ImGui::Button(name.c_str())) ApplyScenarioByName(name);
+		ImGui::SameLine();
+		ImGui::TextDisabled("%s", scenarios_.Find(name)->source.c_str());
+	}
+	if (ImGui::Button("Reload scenarios")) LoadScenarios();
+}
+
+void MatchAdminHotkeys::LogSeriesStatus(const SeriesInfo& s)
+{
+	LOG("MAH: Series #{} {} {} - {} {} (best of {}){}", s.id, s.teamA, s.winsA, s.winsB, s.teamB, s.bestOf,
+		s.Decided() ? std::format(", won by {}", s.winsA > s.winsB ? s.teamA : s.teamB) : std::string(s.closed ? ", closed" : ""));
+	const std::vector<SeriesGame> games = series_.LoadGames(s.id);
+	for (size_t i = 0; i < games.size(); ++i)
+		LOG("MAH:   Game {}: {} {} - {} {}{}", i + 1, s.teamA, games[i].scoreA, games[i].scoreB, s.teamB, games[i].overtime ? " (OT)" : "");
+}
+
+void MatchAdminHotkeys::RenderCanvas(CanvasWrapper canvas)
+{
+	if (unpauseTimer_ != 0)
+	{
+		// One string per frame: the whole seconds left, rounded up (3, 2, 1).
+		const uint64_t ticks = timers_.RemainingTicks(unpauseTimer_);
+		const int secs = static_cast<int>((ticks + static_cast<uint64_t>(TIMER_TICK_HZ) - 1) / static_cast<uint64_t>(TIMER_TICK_HZ));
+		if (secs > 0)
+		{
+			const Vector2 screen = canvas.GetSize();
+			canvas.SetColor(255, 220, 80, 255);
+			canvas.SetPosition(Vector2{ screen.X / 2 - 24, screen.Y / 3 });
+			canvas.DrawString(std::to_string(secs), 6.f, 6.f, true);
+		}
+	}
+
+	if (countdowns_.empty()) return;
+	std::erase_if(countdowns_, [this](const Countdown& c) { return !timers_.IsPending(c.handle); });
+
+	const Vector2 screen = canvas.GetSize();
+	Vector2 pos = { screen.X / 2 - 120, screen.Y / 6 };
+	for (const Countdown& c : countdowns_)
+	{
+		const double secs = timers_.RemainingTicks(c.handle) / TIMER_TICK_HZ;
+		canvas.SetColor(255, 255, 255, 230);
+		canvas.SetPosition(pos);
+		canvas.DrawString(std::format("{} in {:.1f}s", c.label, secs), 1.5f, 1.5f, true);
+		pos.Y += 24;
+	}
+}
+
 void MatchAdminHotkeys::SaveCfg()
 {
 	if (!gameWrapper) return;
 
-	std::filesystem::path bmPath = gameWrapper->GetBakkesModPath();
-	std::filesystem::path cfgPath = bmPath / "cfg" / "matchadminhotkeys.cfg";
+	std::filesystem::path cfgPath = CfgPath(gameWrapper.get());
 
 	std::string pauseCmd = cvarManager->getCvar(CVAR_PAUSE_CMD).getStringValue();
 	std::string resetCmd = cvarManager->getCvar(CVAR_RESET_CMD).getStringValue();
@@ -695,5 +1690,8 @@ void MatchAdminHotkeys::SaveCfg()
 	f << CVAR_RESET_CMD << " \"" << resetCmd << "\"\n";
 
 	f.close();
+	// Our own write is the new baseline, so the watcher sees nothing to apply.
+	std::string text;
+	if (ReadTextFile(cfgPath, text)) cfgDelta_.Reset(text);
 	LOG("MAH: Wrote cfg to {}", cfgPath.string());
 }
@@ -4,6 +4,7 @@
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 #include "bakkesmod/plugin/pluginwindow.h"
 #include "bakkesmod/plugin/PluginSettingsWindow.h"
+#include "bakkesmod/wrappers/canvaswrapper.h"
 
 #if __has_include("bakkesmod/wrappers/GameObject/TeamWrapper.h")
 #include "bakkesmod/wrappers/GameObject/TeamWrapper.h"
@@ -13,6 +14,22 @@
 #error "TeamWrapper.h not found in expected locations (GameObject/ or GameEvent/)."
 #endif
 
+#include "ActionSequencer.h"
+#include "ConfigWatcher.h"
+#include "ControlServer.h"
+#include "ImGuiAllocator.h"
+#include "MacroEngine.h"
+#include "MatchEvents.h"
+#include "MatchSchedule.h"
+#include "ScenarioEngine.h"
+#include "ScoreboardExport.h"
+#include "ScoreboardOverlay.h"
+#include "SeriesTracker.h"
+#include "StateStream.h"
+#include "TimerWheel.h"
+#include <chrono>
+#include <unordered_map>
+
 #include "version.h"
 constexpr auto plugin_version =
 stringify(VERSION_MAJOR) "." stringify(VERSION_MINOR) "." stringify(VERSION_PATCH) "." stringify(VERSION_BUILD);
@@ -20,8 +37,10 @@ stringify(VERSION_MAJOR) "." stringify(VERSION_MINOR) "." stringify(VERSION_PATC
 class MatchAdminHotkeys
 	: public BakkesMod::Plugin::BakkesModPlugin
 	, public BakkesMod::Plugin::PluginSettingsWindow
+	, public PluginWindowBase
 {
 	void onLoad() override;
+	void onUnload() override;
 
 	void AdjustBlueScore(int delta);
 	void AdjustOrangeScore(int delta);
@@ -31,7 +50,84 @@ class MatchAdminHotkeys
 	void RenderSettings() override;
 	std::string GetPluginName() override;
 	void SetImGuiContext(uintptr_t ctx) override;
+	void Render() override;
+	void RenderWindow() override;
 
 	void SaveCfg();
+	void RestartCfgWatcher();
+	void ApplyCfgChanges();
 	void LoadKeyCvarsToUi();
+
+	void RegisterNotifier(const std::string& name, std::function<void(std::vector<std::string>)> fn, const std::string& description, unsigned char permissions);
+	std::function<void()> BindMacroCommand(const std::vector<std::string>& args);
+	MacroContext SampleMacroContext();
+	ScoreboardState SampleScoreboard();
+	void RecordAction(std::string text);
+	void PublishMatchEvent(MatchEventType type, MatchEventSource source);
+	void PublishScores(MatchEventSource source);
+	void PublishPause(bool paused, MatchEventSource source);
+	void OnKickoffCountdown();
+	void SyncMatchState();
+	void RestartControlServer();
+	void DispatchControl(const ControlCommand& cmd);
+	void ApplyResolvedActions(const ResolvedActions& actions);
+	void RestartStateStream();
+	void PublishStreamSnapshot();
+	void ExportScoreboard();
+
+	TimerHandle ScheduleAction(float delaySeconds, std::function<void()> fn, uint32_t group, std::string countdownLabel = {});
+	void OnViewportTick();
+	void OnMatchEnded();
+	void RecordSeriesGame();
+	bool StartSeries(int bestOf, const std::string& teamA, const std::string& teamB);
+	void LoadSchedule(const std::string& path);
+	void StartScheduledMatch(uint32_t row);
+	void RenderSchedulePanel();
+	void LoadScenarios();
+	void ApplyScenarioByName(const std::string& name);
+	void RenderScenarioPanel();
+	void LogSeriesStatus(const SeriesInfo& s);
+	void StartUnpauseCountdown(int seconds);
+	void RenderCanvas(CanvasWrapper canvas);
+
+	struct Countdown
+	{
+		TimerHandle handle;
+		std::string label;
+	};
+
+	std::unique_ptr<MacroEngine> macros_;
+	std::unordered_map<std::string, std::function<void(std::vector<std::string>)>> notifiers_;	// Ours, for macros to call directly
+	TimerWheel timers_;
+	std::chrono::steady_clock::time_point tickEpoch_;
+	std::vector<Countdown> countdowns_;
+	TimerHandle unpauseTimer_ = 0;
+	ScoreboardOverlay overlay_;
+	MatchEventBus events_;
+	MatchEvent matchState_;
+	bool kickoffByAdmin_ = false;
+	bool scoreByAdmin_ = false;	// Set while the plugin writes team scores, so the score hook reports them as Admin
+	bool matchStateSeeded_ = false;
+	ControlServer control_;
+	ActionSequencer sequencer_;
+	uint64_t controlDropped_ = 0;	// Last reported ControlServer drop count
+	uint64_t sequencedDuplicates_ = 0;
+	uint64_t sequencedStale_ = 0;
+	StateStream stream_;
+	StreamSnapshot lastStreamSnapshot_;
+	ScoreboardExport shm_;
+	SeriesTracker series_;
+	MatchSchedule schedule_;
+	uint32_t scheduleNext_ = 0;
+	char scheduleFilter_[64] = {};
+	std::vector<uint32_t> scheduleRows_;
+	bool scheduleRowsDirty_ = true;
+	SearchableComboIndex scheduleTeams_;
+	int scheduleTeam_ = -1;
+	ScenarioBook scenarios_;
+	ConfigWatcher cfgWatcher_;
+	CfgDelta cfgDelta_;
+	ImGuiAllocator imguiMem_;
+	std::string lastAction_;
+	uint32_t actionSerial_ = 0;
 };
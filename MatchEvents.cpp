@@ -0,0 +1,21 @@
+#include "pch.h"
+#include "MatchEvents.h"
+#include <algorithm>
+
+MatchEventBus::SubscriptionId MatchEventBus::Subscribe(Handler handler)
+{
+	const SubscriptionId id = nextId_++;
+	subscribers_.push_back({ id, std::move(handler) });
+	return id;
+}
+
+void MatchEventBus::Unsubscribe(SubscriptionId id)
+{
+	std::erase_if(subscribers_, [id](const Subscriber& s) { return s.id == id; });
+}
+
+void MatchEventBus::Publish(const MatchEvent& ev) const
+{
+	for (const Subscriber& s : subscribers_)
+		s.handler(ev);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+enum class MatchEventType : uint8_t
+{
+	ScoreChanged,
+	PauseChanged,
+	KickoffReset,
+};
+
+enum class MatchEventSource : uint8_t
+{
+	Admin,
+	Game,
+};
+
+// Plain value type so publishing never allocates.
+struct MatchEvent
+{
+	MatchEventType type = MatchEventType::ScoreChanged;
+	MatchEventSource source = MatchEventSource::Game;
+	int blue = 0;
+	int orange = 0;
+	bool paused = false;
+};
+
+// Subscribers live in a flat vector and are called in subscription order.
+// Handlers must not (un)subscribe from inside a dispatch.
+class MatchEventBus
+{
+public:
+	using Handler = std::function<void(const MatchEvent&)>;
+	using SubscriptionId = uint32_t;
+
+	SubscriptionId Subscribe(Handler handler);
+	void Unsubscribe(SubscriptionId id);
+	void Publish(const MatchEvent& ev) const;
+
+private:
+	struct Subscriber
+	{
+		SubscriptionId id;
+		Handler handler;
+	};
+
+	std::vector<Subscriber> subscribers_;
+	SubscriptionId nextId_ = 1;
+};
@@ -0,0 +1,207 @@
+#include "pch.h"
+#include "MatchSchedule.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+static constexpr size_t READ_CHUNK = 64 * 1024;
+static constexpr size_t MAX_LINE = 4096;
+
+static constexpr size_t MAX_FIELDS = 5;
+
+static std::string_view TrimView(std::string_view s)
+{
+	while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1);
+	while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+	return s;
+}
+
+// Splits one line on ',' or tab into up to MAX_FIELDS trimmed fields. A field
+// starting with '"' runs to its closing quote, separators included, and ""
+// inside it is a literal quote; only such fields are copied into 'unescaped'.
+// False for an unterminated quote or text between a closing quote and the
+// next separator.
+static bool SplitFields(std::string_view line, std::string_view (&fields)[MAX_FIELDS], std::string (&unescaped)[MAX_FIELDS], size_t& count)
+{
+	count = 0;
+	while (count < MAX_FIELDS)
+	{
+		size_t i = 0;
+		while (i < line.size() && line[i] == ' ') ++i;
+		if (i < line.size() && line[i] == '"')
+		{
+			std::string& out = unescaped[count];
+			out.clear();
+			for (++i;; ++i)
+			{
+				if (i == line.size()) return false;
+				if (line[i] != '"') { out += line[i]; continue; }
+				if (i + 1 < line.size() && line[i + 1] == '"') { out += '"'; ++i; continue; }
+				break;
+			}
+			line.remove_prefix(i + 1);
+			const size_t end = line.find_first_of(",\t");
+			if (!TrimView(line.substr(0, end)).empty()) return false;
+			fields[count++] = out;
+			if (end == std::string_view::npos) break;
+			line.remove_prefix(end + 1);
+			continue;
+		}
+		const size_t end = line.find_first_of(",\t");
+		fields[count++] = TrimView(line.substr(0, end));
+		if (end == std::string_view::npos) break;
+		line.remove_prefix(end + 1);
+	}
+	return true;
+}
+
+void MatchSchedule::Clear()
+{
+	strings_.clear();
+	interned_.clear();
+	id_.clear();
+	teamA_.clear();
+	teamB_.clear();
+	map_.clear();
+	bestOf_.clear();
+	rowById_.clear();
+	rowsByTeam_.clear();
+	// Index 0 is the empty string, used for missing maps.
+	Intern({});
+}
+
+uint32_t MatchSchedule::Intern(std::string_view s)
+{
+	auto it = interned_.find(std::string(s));
+	if (it != interned_.end()) return it->second;
+	const uint32_t index = static_cast<uint32_t>(strings_.size());
+	strings_.emplace_back(s);
+	interned_.emplace(strings_.back(), index);
+	return index;
+}
+
+uint32_t MatchSchedule::Lookup(std::string_view s) const
+{
+	auto it = interned_.find(std::string(s));
+	return it == interned_.end() ? NO_ROW : it->second;
+}
+
+bool MatchSchedule::AddLine(std::string_view line, bool& badQuotes)
+{
+	line = TrimView(line);
+	if (line.empty() || line.front() == '#') return true;
+
+	std::string_view fields[MAX_FIELDS];
+	std::string unescaped[MAX_FIELDS];
+	size_t count = 0;
+	if (!SplitFields(line, fields, unescaped, count))
+	{
+		badQuotes = true;
+		return false;
+	}
+	if (count < 4 || fields[0].empty() || fields[1].empty() || fields[2].empty()) return false;
+
+	int bestOf = 0;
+	const auto [ptr, ec] = std::from_chars(fields[3].data(), fields[3].data() + fields[3].size(), bestOf);
+	if (ec != std::errc() || ptr != fields[3].data() + fields[3].size() || bestOf < 1 || bestOf > 99 || bestOf % 2 == 0) return false;
+
+	const uint32_t id = Intern(fields[0]);
+	if (rowById_.count(id)) return false;
+
+	const uint32_t row = static_cast<uint32_t>(bestOf_.size());
+	id_.push_back(id);
+	teamA_.push_back(Intern(fields[1]));
+	teamB_.push_back(Intern(fields[2]));
+	map_.push_back(count > 4 ? Intern(fields[4]) : 0);
+	bestOf_.push_back(static_cast<uint8_t>(bestOf));
+	rowById_.emplace(id, row);
+	rowsByTeam_[teamA_.back()].push_back(row);
+	if (teamB_.back() != teamA_.back()) rowsByTeam_[teamB_.back()].push_back(row);
+	return true;
+}
+
+MatchSchedule::LoadResult MatchSchedule::Load(const std::filesystem::path& file)
+{
+	Clear();
+	LoadResult result;
+	std::ifstream in(file, std::ios::binary);
+	if (!in) return result;
+	result.opened = true;
+
+	// Fixed-size chunks; only a line split across two chunks is copied.
+	std::vector<char> chunk(READ_CHUNK);
+	std::string carry;
+	bool overlong = false;
+	auto feed = [&](std::string_view line) {
+		bool badQuotes = false;
+		if (AddLine(line, badQuotes)) return;
+		++result.skipped;
+		if (badQuotes) ++result.badQuotes;
+	};
+	while (in)
+	{
+		in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+		const size_t got = static_cast<size_t>(in.gcount());
+		if (got == 0) break;
+		std::string_view view(chunk.data(), got);
+		size_t nl;
+		while ((nl = view.find('\n')) != std::string_view::npos)
+		{
+			if (overlong)
+			{
+				++result.skipped;
+				overlong = false;
+			}
+			else if (carry.empty())
+			{
+				feed(view.substr(0, nl));
+			}
+			else
+			{
+				carry.append(view.data(), nl);
+				feed(carry);
+				carry.clear();
+			}
+			view.remove_prefix(nl + 1);
+		}
+		if (overlong || carry.size() + view.size() > MAX_LINE)
+		{
+			carry.clear();
+			overlong = true;
+		}
+		else
+		{
+			carry.append(view);
+		}
+	}
+	if (overlong) ++result.skipped;
+	else if (!carry.empty()) feed(carry);
+	result.rows = Size();
+	return result;
+}
+
+uint32_t MatchSchedule::FindById(std::string_view id) const
+{
+	const uint32_t s = Lookup(id);
+	if (s == NO_ROW) return NO_ROW;
+	auto it = rowById_.find(s);
+	return it == rowById_.end() ? NO_ROW : it->second;
+}
+
+const std::vector<uint32_t>& MatchSchedule::RowsForTeam(std::string_view team) const
+{
+	static const std::vector<uint32_t> none;
+	const uint32_t s = Lookup(team);
+	if (s == NO_ROW) return none;
+	auto it = rowsByTeam_.find(s);
+	return it == rowsByTeam_.end() ? none : it->second;
+}
+
+std::vector<std::string> MatchSchedule::TeamNames() const
+{
+	std::vector<std::string> names;
+	names.reserve(rowsByTeam_.size());
+	for (const auto& [team, rows] : rowsByTeam_) names.push_back(strings_[team]);
+	std::sort(names.begin(), names.end());
+	return names;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Pre-planned matches for an event day, stored column-wise. Team, map and id
+// strings are interned once, so each row is four 32-bit string references
+// plus the series length, and lookups by match id or team name are single
+// hash probes.
+class MatchSchedule
+{
+public:
+	static constexpr uint32_t NO_ROW = 0xFFFFFFFFu;
+
+	struct LoadResult
+	{
+		size_t rows = 0;
+		size_t skipped = 0;
+		size_t badQuotes = 0;	// Of the skipped lines, those with an unterminated quote or text after a closing quote
+		bool opened = false;
+	};
+
+	// Lines are "id, team A, team B, best of[, map]", comma or tab separated.
+	// Fields may be quoted as in RFC 4180 ("Team, Inc." or "The ""A"" Team")
+	// but cannot span lines. Blank lines, '#' comments, duplicate ids,
+	// malformed quoting and rows whose best-of is not an odd number (such as a
+	// header) are skipped. Replaces the current contents.
+	LoadResult Load(const std::filesystem::path& file);
+	void Clear();
+
+	size_t Size() const { return bestOf_.size(); }
+	const std::string& Id(uint32_t row) const { return strings_[id_[row]]; }
+	const std::string& TeamA(uint32_t row) const { return strings_[teamA_[row]]; }
+	const std::string& TeamB(uint32_t row) const { return strings_[teamB_[row]]; }
+	const std::string& Map(uint32_t row) const { return strings_[map_[row]]; }
+	int BestOf(uint32_t row) const { return bestOf_[row]; }
+
+	uint32_t FindById(std::string_view id) const;
+	// Rows the team plays in, in schedule order.
+	const std::vector<uint32_t>& RowsForTeam(std::string_view team) const;
+	// Every team that appears in the schedule, sorted.
+	std::vector<std::string> TeamNames() const;
+
+private:
+	uint32_t Intern(std::string_view s);
+	uint32_t Lookup(std::string_view s) const;
+	bool AddLine(std::string_view line, bool& badQuotes);
+
+	std::vector<std::string> strings_;
+	std::unordered_map<std::string, uint32_t> interned_;
+
+	std::vector<uint32_t> id_;
+	std::vector<uint32_t> teamA_;
+	std::vector<uint32_t> teamB_;
+	std::vector<uint32_t> map_;
+	std::vector<uint8_t> bestOf_;
+
+	std::unordered_map<uint32_t, uint32_t> rowById_;
+	std::unordered_map<uint32_t, std::vector<uint32_t>> rowsByTeam_;
+};
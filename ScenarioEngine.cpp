@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "ScenarioEngine.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+
+static constexpr int MAX_SCORE = 999;
+static constexpr int MAX_CLOCK_SECONDS = 99 * 60 + 59;
+
+static std::string TrimCopy(const std::string& s)
+{
+	size_t b = s.find_first_not_of(" \t\r\n");
+	if (b == std::string::npos) return {};
+	size_t e = s.find_last_not_of(" \t\r\n");
+	return s.substr(b, e - b + 1);
+}
+
+static bool ParseInt(const std::string& s, int& out)
+{
+	const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+	return ec == std::errc() && ptr == s.data() + s.size();
+}
+
+// "90", "1:30" or "0:05".
+static bool ParseClock(const std::string& s, int& seconds)
+{
+	const size_t colon = s.find(':');
+	if (colon == std::string::npos) return ParseInt(s, seconds) && seconds >= 0 && seconds <= MAX_CLOCK_SECONDS;
+	int m = 0, sec = 0;
+	if (!ParseInt(s.substr(0, colon), m) || !ParseInt(s.substr(colon + 1), sec) || sec < 0 || sec > 59 || m < 0) return false;
+	seconds = m * 60 + sec;
+	return seconds <= MAX_CLOCK_SECONDS;
+}
+
+bool ScenarioBook::Parse(const std::string& text, std::vector<ScenarioOp>& ops, std::string* error)
+{
+	ops.clear();
+	size_t start = 0;
+	while (start <= text.size())
+	{
+		size_t end = text.find(';', start);
+		if (end == std::string::npos) end = text.size();
+		const std::string step = TrimCopy(text.substr(start, end - start));
+		start = end + 1;
+		if (step.empty()) continue;
+
+		const size_t space = step.find_first_of(" \t");
+		std::string word = step.substr(0, space);
+		std::transform(word.begin(), word.end(), word.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		const std::string arg = space == std::string::npos ? std::string() : TrimCopy(step.substr(space));
+
+		ScenarioOp op;
+		int value = 0;
+		if ((word == "blue" || word == "orange") && ParseInt(arg, value) && value >= 0 && value <= MAX_SCORE)
+		{
+			op.kind = ScenarioOpKind::SetScore;
+			op.team = word == "blue" ? 0 : 1;
+			op.value = value;
+		}
+		else if (word == "clock" && ParseClock(arg, value))
+		{
+			op.kind = ScenarioOpKind::SetClock;
+			op.value = value;
+		}
+		else if ((word == "overtime" || word == "regulation") && arg.empty())
+		{
+			op.kind = ScenarioOpKind::SetOvertime;
+			op.value = word == "overtime";
+		}
+		else if (word == "kickoff" && arg.empty())
+		{
+			op.kind = ScenarioOpKind::Kickoff;
+		}
+		else if ((word == "pause" || word == "unpause") && arg.empty())
+		{
+			op.kind = ScenarioOpKind::SetPaused;
+			op.value = word == "pause";
+		}
+		else
+		{
+			if (error) *error = "invalid step '" + step + "'";
+			return false;
+		}
+		ops.push_back(op);
+	}
+	if (ops.empty())
+	{
+		if (error) *error = "no steps";
+		return false;
+	}
+	return true;
+}
+
+bool ScenarioBook::Define(const std::string& name, const std::string& text, std::string* error)
+{
+	if (name.empty())
+	{
+		if (error) *error = "empty name";
+		return false;
+	}
+	Scenario s;
+	if (!Parse(text, s.ops, error)) return false;
+	s.source = text;
+	scenarios_[name] = std::move(s);
+	return true;
+}
+
+bool ScenarioBook::Remove(const std::string& name)
+{
+	return scenarios_.erase(name) > 0;
+}
+
+const Scenario* ScenarioBook::Find(const std::string& name) const
+{
+	auto it = scenarios_.find(name);
+	return it == scenarios_.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> ScenarioBook::Names() const
+{
+	std::vector<std::string> names;
+	names.reserve(scenarios_.size());
+	for (const auto& [name, s] : scenarios_) names.push_back(name);
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+size_t ScenarioBook::LoadFile(const std::string& path, std::vector<std::string>* errors)
+{
+	std::ifstream in(path);
+	if (!in) return 0;
+	size_t defined = 0;
+	std::string line;
+	for (int lineNo = 1; std::getline(in, line); ++lineNo)
+	{
+		const size_t hash = line.find('#');
+		if (hash != std::string::npos) line.resize(hash);
+		line = TrimCopy(line);
+		if (line.empty()) continue;
+		const size_t colon = line.find(':');
+		std::string error = "expected 'name: steps'";
+		// Clock values contain ':' too, so the name must come before the first one.
+		if (colon != std::string::npos && Define(TrimCopy(line.substr(0, colon)), line.substr(colon + 1), &error))
+		{
+			++defined;
+			continue;
+		}
+		if (errors) errors->push_back("line " + std::to_string(lineNo) + ": " + error);
+	}
+	return defined;
+}
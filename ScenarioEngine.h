@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class ScenarioOpKind : uint8_t
+{
+	SetScore,    // team, value
+	SetClock,    // value = seconds remaining
+	SetOvertime, // value = 0/1
+	Kickoff,
+	SetPaused,   // value = 0/1
+};
+
+struct ScenarioOp
+{
+	ScenarioOpKind kind = ScenarioOpKind::SetScore;
+	uint8_t team = 0;
+	int32_t value = 0;
+};
+
+struct Scenario
+{
+	std::string source;
+	std::vector<ScenarioOp> ops;
+};
+
+// Named game-state presets ("blue 2; orange 1; clock 1:30; overtime; kickoff;
+// pause"). Text is parsed once when a preset is defined; applying one walks a
+// flat op list against any target providing SetScore/SetClock/SetOvertime/
+// Kickoff/SetPaused, so the whole preset lands inside a single game-thread
+// callback.
+class ScenarioBook
+{
+public:
+	// Returns false and leaves the book unchanged if any step is invalid.
+	bool Define(const std::string& name, const std::string& text, std::string* error = nullptr);
+	bool Remove(const std::string& name);
+	const Scenario* Find(const std::string& name) const;
+	std::vector<std::string> Names() const;
+
+	// Reads "name: steps" lines; '#' starts a comment. Returns the number defined.
+	size_t LoadFile(const std::string& path, std::vector<std::string>* errors = nullptr);
+
+	static bool Parse(const std::string& text, std::vector<ScenarioOp>& ops, std::string* error = nullptr);
+
+private:
+	std::unordered_map<std::string, Scenario> scenarios_;
+};
+
+template<typename Target>
+void ApplyScenario(const Scenario& scenario, Target& target)
+{
+	for (const ScenarioOp& op : scenario.ops)
+	{
+		switch (op.kind)
+		{
+		case ScenarioOpKind::SetScore: target.SetScore(op.team, op.value); break;
+		case ScenarioOpKind::SetClock: target.SetClock(op.value); break;
+		case ScenarioOpKind::SetOvertime: target.SetOvertime(op.value != 0); break;
+		case ScenarioOpKind::Kickoff: target.Kickoff(); break;
+		case ScenarioOpKind::SetPaused: target.SetPaused(op.value != 0); break;
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "ScoreboardExport.h"
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+static constexpr auto SHM_NAME = L"Local\\MatchAdminHotkeys.Scoreboard";
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+static constexpr auto SHM_NAME = "/mah_scoreboard";
+#endif
+
+ScoreboardExport::~ScoreboardExport()
+{
+	Close();
+}
+
+bool ScoreboardExport::Open()
+{
+	if (block_) return true;
+	void* mem = nullptr;
+#ifdef _WIN32
+	HANDLE h = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(ScoreboardShm::Block), SHM_NAME);
+	if (!h) return false;
+	mem = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(ScoreboardShm::Block));
+	if (!mem)
+	{
+		CloseHandle(h);
+		return false;
+	}
+	handle_ = h;
+#else
+	int fd = shm_open(SHM_NAME, O_CREAT | O_RDWR, 0644);
+	if (fd < 0) return false;
+	if (ftruncate(fd, sizeof(ScoreboardShm::Block)) != 0)
+	{
+		close(fd);
+		return false;
+	}
+	mem = mmap(nullptr, sizeof(ScoreboardShm::Block), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED) return false;
+#endif
+
+	block_ = new (mem) ScoreboardShm::Block{};
+	block_->magic = ScoreboardShm::MAGIC;
+	block_->version = ScoreboardShm::VERSION;
+	return true;
+}
+
+void ScoreboardExport::Close()
+{
+	if (!block_) return;
+#ifdef _WIN32
+	UnmapViewOfFile(block_);
+	CloseHandle(static_cast<HANDLE>(handle_));
+#else
+	munmap(block_, sizeof(ScoreboardShm::Block));
+	shm_unlink(SHM_NAME);
+#endif
+	block_ = nullptr;
+	handle_ = nullptr;
+}
+
+void ScoreboardExport::Write(const ScoreboardShm::Values& values)
+{
+	if (block_) ScoreboardShm::Write(*block_, values);
+}
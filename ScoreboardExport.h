@@ -0,0 +1,20 @@
+#pragma once
+#include "ScoreboardShm.h"
+
+// Owns the named shared-memory mapping that exposes ScoreboardShm::Block to
+// overlay software on the same machine.
+class ScoreboardExport
+{
+public:
+	~ScoreboardExport();
+
+	bool Open();
+	void Close();
+	bool IsOpen() const { return block_ != nullptr; }
+
+	void Write(const ScoreboardShm::Values& values);
+
+private:
+	ScoreboardShm::Block* block_ = nullptr;
+	void* handle_ = nullptr;
+};
@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "ScoreboardOverlay.h"
+#include "IMGUI/imgui_internal.h"
+#include <cstdio>
+
+void CachedDrawList::BeginCapture(ImDrawList* dl)
+{
+	captureVtxStart_ = dl->VtxBuffer.Size;
+	captureIdxStart_ = dl->IdxBuffer.Size;
+	captureCmdCount_ = dl->CmdBuffer.Size;
+	captureVtxIdx_ = dl->_VtxCurrentIdx;
+}
+
+void CachedDrawList::EndCapture(ImDrawList* dl, const ImVec2& origin)
+{
+	// Only geometry that landed in a single draw command (same texture/clip, no
+	// 64K vertex-offset split) can be replayed as one block.
+	valid_ = dl->CmdBuffer.Size == captureCmdCount_;
+	if (!valid_) return;
+
+	const int vtxCount = dl->VtxBuffer.Size - captureVtxStart_;
+	const int idxCount = dl->IdxBuffer.Size - captureIdxStart_;
+	vtx_.resize(vtxCount);
+	idx_.resize(idxCount);
+	for (int i = 0; i < vtxCount; ++i)
+	{
+		vtx_[i] = dl->VtxBuffer[captureVtxStart_ + i];
+		vtx_[i].pos -= origin;
+	}
+	for (int i = 0; i < idxCount; ++i)
+		idx_[i] = static_cast<ImDrawIdx>(dl->IdxBuffer[captureIdxStart_ + i] - captureVtxIdx_);
+}
+
+bool CachedDrawList::Replay(ImDrawList* dl, const ImVec2& origin) const
+{
+	if (!valid_) return false;
+	dl->PrimReserve(idx_.Size, vtx_.Size);
+	const ImDrawIdx base = static_cast<ImDrawIdx>(dl->_VtxCurrentIdx);
+	for (int i = 0; i < vtx_.Size; ++i)
+	{
+		dl->_VtxWritePtr[i] = vtx_[i];
+		dl->_VtxWritePtr[i].pos += origin;
+	}
+	for (int i = 0; i < idx_.Size; ++i)
+		dl->_IdxWritePtr[i] = static_cast<ImDrawIdx>(idx_[i] + base);
+	dl->_VtxWritePtr += vtx_.Size;
+	dl->_IdxWritePtr += idx_.Size;
+	dl->_VtxCurrentIdx += vtx_.Size;
+	return true;
+}
+
+void ScoreboardOverlay::Render(const ScoreboardState& state, const std::string& lastAction)
+{
+	ImDrawList* dl = ImGui::GetWindowDrawList();
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	const float fontSize = ImGui::GetFontSize();
+	const ImFont* font = ImGui::GetFont();
+	const ImTextureID texId = font->ContainerAtlas ? font->ContainerAtlas->TexID : nullptr;
+	const ImVec2 whiteUv = ImGui::GetFontTexUvWhitePixel();
+	const ImVec2 clipMin = dl->GetClipRectMin() - origin;
+	const ImVec2 clipMax = dl->GetClipRectMax() - origin;
+
+	const bool unchanged = cache_.IsValid()
+		&& state == cachedState_
+		&& fontSize == cachedFontSize_
+		&& font == cachedFont_ && font->FontSize == cachedFontBaseSize_ && texId == cachedTexId_
+		&& whiteUv.x == cachedWhiteUv_.x && whiteUv.y == cachedWhiteUv_.y
+		&& clipMin.x == cachedClipMin_.x && clipMin.y == cachedClipMin_.y
+		&& clipMax.x == cachedClipMax_.x && clipMax.y == cachedClipMax_.y;
+
+	if (!unchanged || !cache_.Replay(dl, origin))
+	{
+		cache_.BeginCapture(dl);
+		Build(dl, origin, state, lastAction);
+		cache_.EndCapture(dl, origin);
+		cachedState_ = state;
+		cachedFontSize_ = fontSize;
+		cachedFont_ = font;
+		cachedFontBaseSize_ = font->FontSize;
+		cachedTexId_ = texId;
+		cachedWhiteUv_ = whiteUv;
+		cachedClipMin_ = clipMin;
+		cachedClipMax_ = clipMax;
+	}
+
+	ImGui::Dummy(cachedSize_);
+}
+
+void ScoreboardOverlay::Build(ImDrawList* dl, const ImVec2& origin, const ScoreboardState& state, const std::string& lastAction)
+{
+	ImFont* font = ImGui::GetFont();
+	const float fontSize = ImGui::GetFontSize();
+	const float scoreSize = fontSize * 2.f;
+	const ImU32 white = IM_COL32(255, 255, 255, 255);
+	const ImU32 blue = ImGui::GetColorU32(ImVec4(0.70f, 0.85f, 1.00f, 1.0f));
+	const ImU32 orange = ImGui::GetColorU32(ImVec4(1.00f, 0.72f, 0.60f, 1.0f));
+	const ImU32 grey = IM_COL32(170, 170, 170, 255);
+	const ImU32 red = IM_COL32(255, 110, 110, 255);
+
+	if (!state.inGame)
+	{
+		dl->AddText(font, fontSize, origin, grey, "Not in a match");
+		cachedSize_ = font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, "Not in a match");
+		return;
+	}
+
+	char buf[32];
+	ImVec2 pos = origin;
+
+	snprintf(buf, sizeof(buf), "%d", state.blue);
+	dl->AddText(font, scoreSize, pos, blue, buf);
+	pos.x += font->CalcTextSizeA(scoreSize, FLT_MAX, 0.f, buf).x;
+	dl->AddText(font, scoreSize, pos, white, " - ");
+	pos.x += font->CalcTextSizeA(scoreSize, FLT_MAX, 0.f, " - ").x;
+	snprintf(buf, sizeof(buf), "%d", state.orange);
+	dl->AddText(font, scoreSize, pos, orange, buf);
+	pos.x += font->CalcTextSizeA(scoreSize, FLT_MAX, 0.f, buf).x;
+	float width = pos.x - origin.x;
+
+	pos = ImVec2(origin.x, origin.y + scoreSize + 4.f);
+	const int secs = state.secondsRemaining < 0 ? 0 : state.secondsRemaining;
+	snprintf(buf, sizeof(buf), "%s%d:%02d", state.overtime ? "+" : "", secs / 60, secs % 60);
+	dl->AddText(font, fontSize, pos, white, buf);
+	pos.x += font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, buf).x;
+	if (state.paused)
+	{
+		dl->AddText(font, fontSize, pos, red, "  PAUSED");
+		pos.x += font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, "  PAUSED").x;
+	}
+	width = ImMax(width, pos.x - origin.x);
+
+	pos = ImVec2(origin.x, pos.y + fontSize + 4.f);
+	if (state.seriesBestOf > 0)
+	{
+		snprintf(buf, sizeof(buf), "Bo%d  Game %d  ", state.seriesBestOf, state.seriesGame);
+		dl->AddText(font, fontSize, pos, white, buf);
+		float x = pos.x + font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, buf).x;
+		snprintf(buf, sizeof(buf), "%d", state.seriesBlueWins);
+		dl->AddText(font, fontSize, ImVec2(x, pos.y), blue, buf);
+		x += font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, buf).x;
+		dl->AddText(font, fontSize, ImVec2(x, pos.y), white, " - ");
+		x += font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, " - ").x;
+		snprintf(buf, sizeof(buf), "%d", state.seriesOrangeWins);
+		dl->AddText(font, fontSize, ImVec2(x, pos.y), orange, buf);
+		x += font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, buf).x;
+		width = ImMax(width, x - origin.x);
+		pos.y += fontSize + 4.f;
+	}
+	if (!lastAction.empty())
+	{
+		const char* begin = lastAction.c_str();
+		const char* end = begin + lastAction.size();
+		dl->AddText(font, fontSize, pos, grey, begin, end);
+		width = ImMax(width, font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, begin, end).x);
+	}
+
+	cachedSize_ = ImVec2(width, pos.y + fontSize - origin.y);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "IMGUI/imgui.h"
+
+struct ScoreboardState
+{
+	bool inGame = false;
+	int blue = 0;
+	int orange = 0;
+	int secondsRemaining = 0;
+	bool overtime = false;
+	bool paused = false;
+	uint32_t actionSerial = 0;
+	// Series standing from the current blue/orange point of view; bestOf 0 = no series.
+	int seriesBestOf = 0;
+	int seriesGame = 0;
+	int seriesBlueWins = 0;
+	int seriesOrangeWins = 0;
+
+	bool operator==(const ScoreboardState&) const = default;
+};
+
+// Keeps the vertices/indices emitted between Begin/EndCapture (relative to an
+// origin) and replays them into a later frame's draw list with two memcpy-style
+// loops, skipping text layout and path tessellation entirely.
+class CachedDrawList
+{
+public:
+	void BeginCapture(ImDrawList* dl);
+	void EndCapture(ImDrawList* dl, const ImVec2& origin);
+	bool Replay(ImDrawList* dl, const ImVec2& origin) const;
+	void Invalidate() { valid_ = false; }
+	bool IsValid() const { return valid_; }
+
+private:
+	ImVector<ImDrawVert> vtx_;
+	ImVector<ImDrawIdx> idx_;
+	int captureVtxStart_ = 0;
+	int captureIdxStart_ = 0;
+	int captureCmdCount_ = 0;
+	unsigned int captureVtxIdx_ = 0;
+	bool valid_ = false;
+};
+
+// Score / clock / pause / series / last action panel. Geometry is only rebuilt when the
+// displayed values, font, atlas texture or clip rectangle change.
+class ScoreboardOverlay
+{
+public:
+	void Render(const ScoreboardState& state, const std::string& lastAction);
+
+private:
+	void Build(ImDrawList* dl, const ImVec2& origin, const ScoreboardState& state, const std::string& lastAction);
+
+	CachedDrawList cache_;
+	ScoreboardState cachedState_;
+	float cachedFontSize_ = 0.f;
+	// The cached vertices hold UVs into the font atlas: a rebuild or a font change invalidates them.
+	const ImFont* cachedFont_ = nullptr;
+	float cachedFontBaseSize_ = 0.f;
+	ImTextureID cachedTexId_ = nullptr;
+	ImVec2 cachedWhiteUv_;
+	ImVec2 cachedClipMin_;
+	ImVec2 cachedClipMax_;
+	ImVec2 cachedSize_;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Layout of the shared-memory scoreboard, published under
+//   Windows: "Local\MatchAdminHotkeys.Scoreboard"   POSIX: "/mah_scoreboard"
+// Fields are guarded by a seqlock: the writer makes `seq` odd while it
+// updates and even again when done. Readers never block the writer; a read
+// attempt either returns a consistent copy or fails and is simply retried.
+namespace ScoreboardShm
+{
+	constexpr uint32_t MAGIC = 0x4D414853; // "SHAM"
+	constexpr uint32_t VERSION = 1;
+
+	enum Flag : uint32_t
+	{
+		Flag_InGame = 1 << 0,
+		Flag_Paused = 1 << 1,
+		Flag_Overtime = 1 << 2,
+	};
+
+	struct Values
+	{
+		int32_t blue = 0;
+		int32_t orange = 0;
+		int32_t secondsRemaining = 0;
+		uint32_t flags = 0;
+		uint64_t actionCounter = 0;
+		uint64_t timestampNs = 0;
+	};
+
+	struct Block
+	{
+		uint32_t magic;
+		uint32_t version;
+		alignas(64) std::atomic<uint32_t> seq;
+		std::atomic<int32_t> blue;
+		std::atomic<int32_t> orange;
+		std::atomic<int32_t> secondsRemaining;
+		std::atomic<uint32_t> flags;
+		std::atomic<uint64_t> actionCounter;
+		std::atomic<uint64_t> timestampNs;
+	};
+
+	// Single writer only.
+	inline void Write(Block& b, const Values& v)
+	{
+		const uint32_t s = b.seq.load(std::memory_order_relaxed);
+		b.seq.store(s + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		b.blue.store(v.blue, std::memory_order_relaxed);
+		b.orange.store(v.orange, std::memory_order_relaxed);
+		b.secondsRemaining.store(v.secondsRemaining, std::memory_order_relaxed);
+		b.flags.store(v.flags, std::memory_order_relaxed);
+		b.actionCounter.store(v.actionCounter, std::memory_order_relaxed);
+		b.timestampNs.store(v.timestampNs, std::memory_order_relaxed);
+		b.seq.store(s + 2, std::memory_order_release);
+	}
+
+	// Bounded work, no loops: false means a write was in flight, poll again.
+	inline bool TryRead(const Block& b, Values& out)
+	{
+		const uint32_t s1 = b.seq.load(std::memory_order_acquire);
+		if (s1 & 1) return false;
+		out.blue = b.blue.load(std::memory_order_relaxed);
+		out.orange = b.orange.load(std::memory_order_relaxed);
+		out.secondsRemaining = b.secondsRemaining.load(std::memory_order_relaxed);
+		out.flags = b.flags.load(std::memory_order_relaxed);
+		out.actionCounter = b.actionCounter.load(std::memory_order_relaxed);
+		out.timestampNs = b.timestampNs.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return b.seq.load(std::memory_order_relaxed) == s1;
+	}
+}
@@ -0,0 +1,319 @@
+#include "pch.h"
+#include "SeriesTracker.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+static constexpr char LOG_MAGIC[8] = { 'M', 'A', 'H', 'S', 'E', 'R', '0', '1' };
+static constexpr size_t RECORD_OVERHEAD = 1 + 1 + 4; // type, length, checksum
+static constexpr size_t GAME_PAYLOAD = 4 + 2 + 2 + 1 + 8;
+
+static uint32_t Fnv1a(const uint8_t* data, size_t len, uint32_t h = 2166136261u)
+{
+	for (size_t i = 0; i < len; ++i)
+	{
+		h ^= data[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t v)
+{
+	for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+static uint32_t GetU32(const uint8_t* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void PutString(std::vector<uint8_t>& out, const std::string& s)
+{
+	const size_t n = std::min(s.size(), SeriesTracker::MAX_TEAM_NAME);
+	out.push_back(static_cast<uint8_t>(n));
+	out.insert(out.end(), s.begin(), s.begin() + n);
+}
+
+static SeriesGame DecodeGame(const uint8_t* p)
+{
+	SeriesGame g;
+	g.scoreA = static_cast<int16_t>(p[4] | (p[5] << 8));
+	g.scoreB = static_cast<int16_t>(p[6] | (p[7] << 8));
+	g.overtime = p[8] != 0;
+	uint64_t t = 0;
+	for (int i = 0; i < 8; ++i) t |= static_cast<uint64_t>(p[9 + i]) << (8 * i);
+	g.finishedAt = static_cast<int64_t>(t);
+	return g;
+}
+
+bool SeriesTracker::Open(const std::filesystem::path& file)
+{
+	Close();
+	path_ = file;
+	std::error_code ec;
+	std::filesystem::create_directories(file.parent_path(), ec);
+
+	std::vector<uint8_t> data;
+	{
+		std::ifstream in(file, std::ios::binary);
+		if (in) data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	size_t good = 0;
+	if (data.size() >= sizeof(LOG_MAGIC) && std::memcmp(data.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) == 0)
+	{
+		good = sizeof(LOG_MAGIC);
+		while (good + RECORD_OVERHEAD <= data.size())
+		{
+			const uint8_t* rec = data.data() + good;
+			const size_t len = rec[1];
+			if (good + RECORD_OVERHEAD + len > data.size()) break;
+			if (Fnv1a(rec, 2 + len) != GetU32(rec + 2 + len)) break;
+			Apply(static_cast<RecordType>(rec[0]), rec + 2, len, good);
+			good += RECORD_OVERHEAD + len;
+		}
+	}
+
+	if (good == 0 && !data.empty())
+	{
+		// Not our format; keep it for inspection instead of overwriting it.
+		LOG("MAH: Series log {} is unreadable, moving it aside", file.string());
+		std::filesystem::rename(file, std::filesystem::path(file).concat(".bad"), ec);
+	}
+	if (good == 0)
+	{
+		std::ofstream(file, std::ios::binary | std::ios::trunc).write(LOG_MAGIC, sizeof(LOG_MAGIC));
+		good = sizeof(LOG_MAGIC);
+	}
+	else if (good < data.size())
+	{
+		// Partial record from a crash mid-append; everything before it is intact.
+		LOG("MAH: Series log {}: dropping {} trailing byte(s)", file.string(), data.size() - good);
+		std::filesystem::resize_file(file, good, ec);
+	}
+
+	size_ = good;
+	out_.open(file, std::ios::binary | std::ios::app);
+	return out_.is_open();
+}
+
+void SeriesTracker::Close()
+{
+	if (out_.is_open()) out_.close();
+	series_.clear();
+	byTeams_.clear();
+	nextId_ = 1;
+	activeId_ = 0;
+	size_ = 0;
+}
+
+bool SeriesTracker::Append(RecordType type, const std::vector<uint8_t>& payload)
+{
+	if (!out_.is_open() || payload.size() > 0xFF) return false;
+	std::vector<uint8_t> rec;
+	rec.reserve(RECORD_OVERHEAD + payload.size());
+	rec.push_back(type);
+	rec.push_back(static_cast<uint8_t>(payload.size()));
+	rec.insert(rec.end(), payload.begin(), payload.end());
+	PutU32(rec, Fnv1a(rec.data(), rec.size()));
+	out_.write(reinterpret_cast<const char*>(rec.data()), static_cast<std::streamsize>(rec.size()));
+	out_.flush();
+	if (!out_) return false;
+
+	const uint64_t at = size_;
+	size_ += rec.size();
+	Apply(type, payload.data(), payload.size(), at);
+	return true;
+}
+
+void SeriesTracker::Apply(RecordType type, const uint8_t* payload, size_t len, uint64_t offset)
+{
+	if (len < 4) return;
+	const uint32_t id = GetU32(payload);
+
+	if (type == Rec_Start)
+	{
+		if (len < 7) return;
+		SeriesInfo s;
+		s.id = id;
+		s.bestOf = payload[4];
+		size_t pos = 5;
+		const size_t lenA = payload[pos++];
+		if (pos + lenA + 1 > len) return;
+		s.teamA.assign(reinterpret_cast<const char*>(payload + pos), lenA);
+		pos += lenA;
+		const size_t lenB = payload[pos++];
+		if (pos + lenB > len) return;
+		s.teamB.assign(reinterpret_cast<const char*>(payload + pos), lenB);
+		// Logs written before names were cut on a character boundary may end in half a character.
+		s.teamA = TeamName(std::move(s.teamA), "Blue");
+		s.teamB = TeamName(std::move(s.teamB), "Orange");
+		byTeams_[TeamsKey(s.teamA, s.teamB)] = id;
+		series_[id] = std::move(s);
+		activeId_ = id;
+		if (id >= nextId_) nextId_ = id + 1;
+		return;
+	}
+
+	auto it = series_.find(id);
+	if (it == series_.end()) return;
+	SeriesInfo& s = it->second;
+	switch (type)
+	{
+	case Rec_Game:
+	{
+		if (len < GAME_PAYLOAD) return;
+		const SeriesGame g = DecodeGame(payload);
+		const int8_t winner = g.scoreA > g.scoreB ? 0 : (g.scoreB > g.scoreA ? 1 : -1);
+		s.gameOffsets.push_back(offset);
+		s.gameWinners.push_back(winner);
+		if (winner == 0) ++s.winsA;
+		if (winner == 1) ++s.winsB;
+		break;
+	}
+	case Rec_Undo:
+		if (s.gameOffsets.empty()) return;
+		if (s.gameWinners.back() == 0) --s.winsA;
+		if (s.gameWinners.back() == 1) --s.winsB;
+		s.gameOffsets.pop_back();
+		s.gameWinners.pop_back();
+		break;
+	case Rec_Swap:
+		s.teamAIsOrange = !s.teamAIsOrange;
+		break;
+	case Rec_Activate:
+		activeId_ = id;
+		break;
+	case Rec_Close:
+		s.closed = true;
+		if (activeId_ == id) activeId_ = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+std::string SeriesTracker::TeamName(std::string name, const char* fallback)
+{
+	if (name.empty()) return fallback;
+	if (name.size() > MAX_TEAM_NAME) name.resize(MAX_TEAM_NAME);
+	// Drop a UTF-8 sequence left incomplete by the cut.
+	size_t lead = name.size();
+	while (lead > 0 && name.size() - lead < 3 && (static_cast<uint8_t>(name[lead - 1]) & 0xC0) == 0x80) --lead;
+	if (lead > 0)
+	{
+		const uint8_t c = static_cast<uint8_t>(name[lead - 1]);
+		const size_t need = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+		if (lead - 1 + need > name.size()) name.resize(lead - 1);
+	}
+	return name.empty() ? fallback : name;
+}
+
+std::string SeriesTracker::TeamsKey(const std::string& a, const std::string& b)
+{
+	return a + '\n' + b;
+}
+
+uint32_t SeriesTracker::Start(int bestOf, std::string teamA, std::string teamB)
+{
+	if (bestOf < 1 || bestOf > 99 || bestOf % 2 == 0) return 0;
+	teamA = TeamName(std::move(teamA), "Blue");
+	teamB = TeamName(std::move(teamB), "Orange");
+	const uint32_t id = nextId_;
+	std::vector<uint8_t> p;
+	PutU32(p, id);
+	p.push_back(static_cast<uint8_t>(bestOf));
+	PutString(p, teamA);
+	PutString(p, teamB);
+	return Append(Rec_Start, p) ? id : 0;
+}
+
+bool SeriesTracker::RecordGame(int blue, int orange, bool overtime, int64_t finishedAt)
+{
+	const SeriesInfo* s = Active();
+	if (!s || s->Decided()) return false;
+	const int a = s->teamAIsOrange ? orange : blue;
+	const int b = s->teamAIsOrange ? blue : orange;
+	std::vector<uint8_t> p;
+	PutU32(p, s->id);
+	p.push_back(static_cast<uint8_t>(a));
+	p.push_back(static_cast<uint8_t>(a >> 8));
+	p.push_back(static_cast<uint8_t>(b));
+	p.push_back(static_cast<uint8_t>(b >> 8));
+	p.push_back(overtime ? 1 : 0);
+	for (int i = 0; i < 8; ++i) p.push_back(static_cast<uint8_t>(static_cast<uint64_t>(finishedAt) >> (8 * i)));
+	return Append(Rec_Game, p);
+}
+
+bool SeriesTracker::UndoLastGame()
+{
+	const SeriesInfo* s = Active();
+	if (!s || s->gameOffsets.empty()) return false;
+	std::vector<uint8_t> p;
+	PutU32(p, s->id);
+	return Append(Rec_Undo, p);
+}
+
+bool SeriesTracker::SwapSides()
+{
+	const SeriesInfo* s = Active();
+	if (!s) return false;
+	std::vector<uint8_t> p;
+	PutU32(p, s->id);
+	return Append(Rec_Swap, p);
+}
+
+bool SeriesTracker::Resume(uint32_t id)
+{
+	const SeriesInfo* s = Find(id);
+	if (!s || s->closed) return false;
+	if (activeId_ == id) return true;
+	std::vector<uint8_t> p;
+	PutU32(p, id);
+	return Append(Rec_Activate, p);
+}
+
+bool SeriesTracker::End()
+{
+	const SeriesInfo* s = Active();
+	if (!s) return false;
+	std::vector<uint8_t> p;
+	PutU32(p, s->id);
+	return Append(Rec_Close, p);
+}
+
+const SeriesInfo* SeriesTracker::Active() const
+{
+	return activeId_ == 0 ? nullptr : Find(activeId_);
+}
+
+const SeriesInfo* SeriesTracker::Find(uint32_t id) const
+{
+	auto it = series_.find(id);
+	return it == series_.end() ? nullptr : &it->second;
+}
+
+const SeriesInfo* SeriesTracker::FindByTeams(const std::string& teamA, const std::string& teamB) const
+{
+	auto it = byTeams_.find(TeamsKey(TeamName(teamA, "Blue"), TeamName(teamB, "Orange")));
+	return it == byTeams_.end() ? nullptr : Find(it->second);
+}
+
+std::vector<SeriesGame> SeriesTracker::LoadGames(uint32_t id) const
+{
+	std::vector<SeriesGame> games;
+	const SeriesInfo* s = Find(id);
+	if (!s || s->gameOffsets.empty()) return games;
+	std::ifstream in(path_, std::ios::binary);
+	if (!in) return games;
+	games.reserve(s->gameOffsets.size());
+	uint8_t rec[2 + GAME_PAYLOAD];
+	for (uint64_t offset : s->gameOffsets)
+	{
+		in.seekg(static_cast<std::streamoff>(offset));
+		if (!in.read(reinterpret_cast<char*>(rec), sizeof(rec))) break;
+		games.push_back(DecodeGame(rec + 2));
+	}
+	return games;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SeriesGame
+{
+	int scoreA = 0;
+	int scoreB = 0;
+	bool overtime = false;
+	int64_t finishedAt = 0; // unix seconds
+};
+
+// Index entry; game scores stay on disk and are only read for history views.
+struct SeriesInfo
+{
+	uint32_t id = 0;
+	uint8_t bestOf = 0;
+	std::string teamA;
+	std::string teamB;
+	bool teamAIsOrange = false;
+	bool closed = false;
+	int winsA = 0;
+	int winsB = 0;
+	std::vector<uint64_t> gameOffsets;
+	std::vector<int8_t> gameWinners; // 0 = A, 1 = B, -1 = tie
+
+	int GamesPlayed() const { return static_cast<int>(gameOffsets.size()); }
+	int WinsNeeded() const { return bestOf / 2 + 1; }
+	bool Decided() const { return winsA >= WinsNeeded() || winsB >= WinsNeeded(); }
+};
+
+// Best-of-N series persisted as an append-only log of small checksummed
+// records (start, game result, undo, side swap, activate, close). Load scans
+// the log once into an in-memory index, truncating a torn tail left by a
+// crash; every later lookup is a hash-map hit and every change is one append.
+// Game scores are recorded for team A/B so a side swap between games does not
+// mix up the standing.
+class SeriesTracker
+{
+public:
+	// Team names are stored as at most this many bytes, cut on a UTF-8 character boundary.
+	static constexpr size_t MAX_TEAM_NAME = 32;
+
+	// The name Start() stores for a team: empty becomes 'fallback' ("Blue"/"Orange"), long names are cut to
+	// MAX_TEAM_NAME. FindByTeams() applies the same rule, so it matches whatever was passed to Start().
+	static std::string TeamName(std::string name, const char* fallback);
+
+	bool Open(const std::filesystem::path& file);
+	void Close();
+	bool IsOpen() const { return out_.is_open(); }
+
+	// Returns the new series id, or 0 if bestOf is not a positive odd number.
+	uint32_t Start(int bestOf, std::string teamA, std::string teamB);
+	bool RecordGame(int blue, int orange, bool overtime, int64_t finishedAt);
+	bool UndoLastGame();
+	bool SwapSides();
+	bool Resume(uint32_t id);
+	bool End();
+
+	const SeriesInfo* Active() const;
+	const SeriesInfo* Find(uint32_t id) const;
+	const SeriesInfo* FindByTeams(const std::string& teamA, const std::string& teamB) const;
+	std::vector<SeriesGame> LoadGames(uint32_t id) const;
+	size_t SeriesCount() const { return series_.size(); }
+
+private:
+	enum RecordType : uint8_t
+	{
+		Rec_Start = 1,
+		Rec_Game = 2,
+		Rec_Undo = 3,
+		Rec_Swap = 4,
+		Rec_Activate = 5,
+		Rec_Close = 6,
+	};
+
+	bool Append(RecordType type, const std::vector<uint8_t>& payload);
+	void Apply(RecordType type, const uint8_t* payload, size_t len, uint64_t offset);
+	static std::string TeamsKey(const std::string& a, const std::string& b);
+
+	std::filesystem::path path_;
+	std::ofstream out_;
+	uint64_t size_ = 0;
+	std::unordered_map<uint32_t, SeriesInfo> series_;
+	std::unordered_map<std::string, uint32_t> byTeams_;
+	uint32_t nextId_ = 1;
+	uint32_t activeId_ = 0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer/single-consumer ring buffer. Push is only called
+// from the producer thread and Pop only from the consumer thread; neither
+// blocks or allocates.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	bool Push(const T& value)
+	{
+		const size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == Capacity) return false;
+		items_[head & (Capacity - 1)] = value;
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Pop(T& out)
+	{
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail == head_.load(std::memory_order_acquire)) return false;
+		out = items_[tail & (Capacity - 1)];
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	// Producer and consumer indices on separate cache lines.
+	alignas(64) std::atomic<size_t> head_{ 0 };
+	alignas(64) std::atomic<size_t> tail_{ 0 };
+	alignas(64) T items_[Capacity];
+};
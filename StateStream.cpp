@@ -0,0 +1,276 @@
+#include "pch.h"
+#include "StateStream.h"
+#include "LocalSocket.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace StreamProtocol;
+
+static constexpr size_t RING_SIZE = 64 * 1024;
+static constexpr size_t MAX_SUBSCRIBERS = 16;
+
+static uint8_t DiffMask(const StreamSnapshot& a, const StreamSnapshot& b)
+{
+	uint8_t mask = 0;
+	if (a.blue != b.blue) mask |= Field_Blue;
+	if (a.orange != b.orange) mask |= Field_Orange;
+	if (a.secondsRemaining != b.secondsRemaining) mask |= Field_Clock;
+	if (a.flags != b.flags) mask |= Field_Flags;
+	if (a.actionSerial != b.actionSerial) mask |= Field_Action;
+	return mask;
+}
+
+template <typename T>
+static uint8_t* Put(uint8_t* p, T v)
+{
+	std::memcpy(p, &v, sizeof(v));
+	return p + sizeof(v);
+}
+
+static size_t Encode(uint8_t* out, const StreamSnapshot& s, uint8_t mask)
+{
+	uint8_t* p = out + 2;
+	p = Put(p, mask);
+	p = Put(p, s.timestampNs);
+	if (mask & Field_Blue) p = Put(p, s.blue);
+	if (mask & Field_Orange) p = Put(p, s.orange);
+	if (mask & Field_Clock) p = Put(p, s.secondsRemaining);
+	if (mask & Field_Flags) p = Put(p, s.flags);
+	if (mask & Field_Action)
+	{
+		p = Put(p, s.actionSerial);
+		p = Put(p, s.actionLen);
+		std::memcpy(p, s.action, s.actionLen);
+		p += s.actionLen;
+	}
+	const size_t len = static_cast<size_t>(p - out);
+	Put(out, static_cast<uint16_t>(len - 2));
+	return len;
+}
+
+StateStream::~StateStream()
+{
+	Stop();
+}
+
+bool StateStream::Start(uint16_t port)
+{
+	Stop();
+	if (!LocalSocket::NetStartup()) return false;
+	socket_t s = LocalSocket::ListenLoopback(port);
+	socket_t w = s == INVALID_SOCKET ? INVALID_SOCKET : LocalSocket::OpenWakeup();
+	if (w == INVALID_SOCKET)
+	{
+		if (s != INVALID_SOCKET) LocalSocket::Close(s);
+		LocalSocket::NetCleanup();
+		return false;
+	}
+	listen_ = static_cast<uintptr_t>(s);
+	wake_ = static_cast<uintptr_t>(w);
+	wakePending_ = false;
+	running_ = true;
+	thread_ = std::thread([this]() { Run(); });
+	return true;
+}
+
+void StateStream::Stop()
+{
+	if (!thread_.joinable()) return;
+	running_ = false;
+	LocalSocket::Wake(static_cast<socket_t>(wake_));
+	thread_.join();
+	LocalSocket::Close(static_cast<socket_t>(listen_));
+	LocalSocket::Close(static_cast<socket_t>(wake_));
+	listen_ = ~uintptr_t(0);
+	wake_ = ~uintptr_t(0);
+	LocalSocket::NetCleanup();
+}
+
+void StateStream::Publish(const StreamSnapshot& snapshot)
+{
+	if (!queue_.Push(snapshot))
+	{
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	// One datagram per wakeup, however many snapshots it covers.
+	if (!wakePending_.exchange(true)) LocalSocket::Wake(static_cast<socket_t>(wake_));
+}
+
+StreamStats StateStream::Stats() const
+{
+	StreamStats st;
+	st.subscribers = subscribers_.load(std::memory_order_relaxed);
+	st.frames = frames_.load(std::memory_order_relaxed);
+	st.resyncs = resyncs_.load(std::memory_order_relaxed);
+	st.dropped = dropped_.load(std::memory_order_relaxed);
+	return st;
+}
+
+void StateStream::Run()
+{
+	struct Subscriber
+	{
+		socket_t sock;
+		uint64_t cursor;
+		uint64_t frameEnd;	// First frame boundary at or after cursor
+		// Rest of the frame this subscriber was sending when it was resynced.
+		uint8_t tail[MAX_FRAME];
+		size_t tailOff;
+		size_t tailLen;
+	};
+
+	const socket_t listenSock = static_cast<socket_t>(listen_);
+	const socket_t wakeSock = static_cast<socket_t>(wake_);
+	std::vector<uint8_t> ring(RING_SIZE);
+	uint64_t head = 0;
+	std::vector<Subscriber> subs;
+	StreamSnapshot last;
+	bool haveLast = false;
+	uint8_t frame[MAX_FRAME];
+
+	auto append = [&](const uint8_t* data, size_t n) {
+		for (size_t i = 0; i < n; ++i) ring[(head + i) & (RING_SIZE - 1)] = data[i];
+		head += n;
+		frames_.fetch_add(1, std::memory_order_relaxed);
+	};
+
+	auto frameSize = [&](uint64_t at) {
+		return 2u + (ring[at & (RING_SIZE - 1)] | (ring[(at + 1) & (RING_SIZE - 1)] << 8));
+	};
+
+	// Appends a keyframe and moves every subscriber that would otherwise be
+	// overrun (or is new) onto it. A subscriber stopped mid-frame first
+	// copies the unsent rest of that frame out of the ring.
+	auto resync = [&](const Subscriber* joining) {
+		const uint64_t start = head;
+		std::vector<Subscriber*> moving;
+		for (Subscriber& s : subs)
+		{
+			if (&s != joining && head + MAX_FRAME - s.cursor <= RING_SIZE) continue;
+			moving.push_back(&s);
+			if (s.cursor == s.frameEnd) continue;
+			s.tailOff = 0;
+			s.tailLen = static_cast<size_t>(s.frameEnd - s.cursor);
+			for (size_t i = 0; i < s.tailLen; ++i) s.tail[i] = ring[(s.cursor + i) & (RING_SIZE - 1)];
+		}
+		append(frame, Encode(frame, last, Field_All | Field_Keyframe));
+		for (Subscriber* s : moving)
+		{
+			s->cursor = s->frameEnd = start;
+			if (s != joining) resyncs_.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	auto drop = [&](size_t i) {
+		LocalSocket::Close(subs[i].sock);
+		subs[i] = subs.back();
+		subs.pop_back();
+		subscribers_.store(subs.size(), std::memory_order_relaxed);
+	};
+
+	uint8_t discard[256];
+	while (running_.load(std::memory_order_relaxed))
+	{
+		wakePending_ = false;	// Before popping: a Publish() from here on wakes the next select()
+		StreamSnapshot snap;
+		while (queue_.Pop(snap))
+		{
+			const uint8_t mask = haveLast ? DiffMask(last, snap) : Field_All | Field_Keyframe;
+			if (mask == 0) continue;
+			last = snap;
+			haveLast = true;
+
+			bool lagging = false;
+			for (const Subscriber& s : subs)
+				lagging |= head + MAX_FRAME - s.cursor > RING_SIZE;
+			if (lagging)
+				resync(nullptr);
+			else
+				append(frame, Encode(frame, snap, mask));
+		}
+
+		// Send straight out of the shared ring; partial sends just advance the cursor.
+		for (size_t i = 0; i < subs.size();)
+		{
+			Subscriber& s = subs[i];
+			bool failed = false;
+			while (s.tailLen > 0)
+			{
+				const int sent = send(s.sock, reinterpret_cast<const char*>(s.tail + s.tailOff), static_cast<int>(s.tailLen), 0);
+				if (sent <= 0)
+				{
+					failed = !LocalSocket::WouldBlock();
+					break;
+				}
+				s.tailOff += static_cast<size_t>(sent);
+				s.tailLen -= static_cast<size_t>(sent);
+			}
+			while (!failed && s.tailLen == 0 && s.cursor < head)
+			{
+				const size_t off = static_cast<size_t>(s.cursor & (RING_SIZE - 1));
+				const size_t n = static_cast<size_t>(std::min<uint64_t>(head - s.cursor, RING_SIZE - off));
+				const int sent = send(s.sock, reinterpret_cast<const char*>(ring.data() + off), static_cast<int>(n), 0);
+				if (sent <= 0)
+				{
+					failed = !LocalSocket::WouldBlock();
+					break;
+				}
+				s.cursor += static_cast<uint64_t>(sent);
+			}
+			while (s.frameEnd < s.cursor) s.frameEnd += frameSize(s.frameEnd);
+			if (failed) drop(i);
+			else ++i;
+		}
+
+		fd_set readable, writable;
+		FD_ZERO(&readable);
+		FD_ZERO(&writable);
+		FD_SET(listenSock, &readable);
+		FD_SET(wakeSock, &readable);
+		socket_t maxFd = listenSock > wakeSock ? listenSock : wakeSock;
+		for (const Subscriber& s : subs)
+		{
+			FD_SET(s.sock, &readable);
+			if (s.cursor < head || s.tailLen > 0) FD_SET(s.sock, &writable);
+			if (s.sock > maxFd) maxFd = s.sock;
+		}
+
+		// No timeout: Publish() and Stop() wake the loop through wakeSock.
+		if (select(static_cast<int>(maxFd + 1), &readable, &writable, nullptr, nullptr) <= 0) continue;
+		if (FD_ISSET(wakeSock, &readable)) LocalSocket::DrainWakeup(wakeSock);
+
+		if (FD_ISSET(listenSock, &readable))
+		{
+			socket_t c = accept(listenSock, nullptr, nullptr);
+			if (c != INVALID_SOCKET)
+			{
+				if (subs.size() >= MAX_SUBSCRIBERS)
+				{
+					LocalSocket::Close(c);
+				}
+				else
+				{
+					LocalSocket::SetNoDelay(c);
+					LocalSocket::SetNonBlocking(c);
+					subs.push_back({ c, head, head, {}, 0, 0 });
+					subscribers_.store(subs.size(), std::memory_order_relaxed);
+					if (haveLast) resync(&subs.back());
+				}
+			}
+		}
+
+		// Subscribers never send anything; readability means they hung up.
+		for (size_t i = 0; i < subs.size();)
+		{
+			if (FD_ISSET(subs[i].sock, &readable) && recv(subs[i].sock, reinterpret_cast<char*>(discard), sizeof(discard), 0) <= 0)
+				drop(i);
+			else
+				++i;
+		}
+	}
+
+	for (const Subscriber& s : subs) LocalSocket::Close(s.sock);
+	subscribers_.store(0, std::memory_order_relaxed);
+}
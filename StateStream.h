@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "ControlProtocol.h"
+#include "SpscQueue.h"
+
+struct StreamSnapshot
+{
+	int16_t blue = 0;
+	int16_t orange = 0;
+	int16_t secondsRemaining = 0;
+	uint8_t flags = 0;
+	uint32_t actionSerial = 0;
+	uint8_t actionLen = 0;
+	char action[StreamProtocol::MAX_ACTION_TEXT] = {};
+	uint64_t timestampNs = 0;
+};
+
+struct StreamStats
+{
+	uint64_t subscribers = 0;
+	uint64_t frames = 0;
+	uint64_t resyncs = 0;
+	uint64_t dropped = 0;
+};
+
+// Pushes StreamProtocol frames to any number of loopback subscribers. The
+// game thread publishes snapshots through a lock-free queue; the IO thread
+// delta-encodes each change once into a shared ring buffer and every
+// subscriber sends straight out of it from its own cursor. A subscriber
+// that falls a full ring behind is skipped forward to a fresh keyframe
+// instead of stalling the others; if it was stopped mid-frame, the rest of
+// that frame is kept aside and sent first so the stream stays framed. The
+// IO thread sleeps in select() until Publish() or a socket wakes it.
+class StateStream
+{
+public:
+	~StateStream();
+
+	bool Start(uint16_t port);
+	void Stop();
+	bool IsRunning() const { return thread_.joinable(); }
+
+	// Game thread only.
+	void Publish(const StreamSnapshot& snapshot);
+
+	StreamStats Stats() const;
+
+private:
+	void Run();
+
+	std::thread thread_;
+	std::atomic<bool> running_{ false };
+	uintptr_t listen_ = ~uintptr_t(0);
+	uintptr_t wake_ = ~uintptr_t(0);
+	std::atomic<bool> wakePending_{ false };
+	SpscQueue<StreamSnapshot, 256> queue_;
+	std::atomic<uint64_t> subscribers_{ 0 };
+	std::atomic<uint64_t> frames_{ 0 };
+	std::atomic<uint64_t> resyncs_{ 0 };
+	std::atomic<uint64_t> dropped_{ 0 };
+};
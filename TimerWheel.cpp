@@ -0,0 +1,175 @@
+#include "pch.h"
+#include "TimerWheel.h"
+#include <algorithm>
+
+static constexpr uint64_t MAX_DELAY_TICKS = 0xFFFFFFFFull;
+
+TimerWheel::TimerWheel(uint64_t nowTick)
+	: now_(nowTick)
+{
+	// Slot heads and the firing list are sentinels at the front of the pool.
+	nodes_.resize(FIRST_TIMER);
+	for (uint32_t i = 0; i < FIRST_TIMER; ++i)
+	{
+		nodes_[i].prev = i;
+		nodes_[i].next = i;
+	}
+}
+
+uint32_t TimerWheel::SlotHead(int level, uint64_t tick)
+{
+	return static_cast<uint32_t>(level * SLOTS + ((tick >> (level * SLOT_BITS)) & (SLOTS - 1)));
+}
+
+const TimerWheel::Node* TimerWheel::Resolve(TimerHandle handle) const
+{
+	const uint32_t index = static_cast<uint32_t>(handle);
+	const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+	if (index < FIRST_TIMER || index >= nodes_.size()) return nullptr;
+	const Node& n = nodes_[index];
+	if (!n.active || n.generation != generation) return nullptr;
+	return &n;
+}
+
+void TimerWheel::Link(uint32_t head, uint32_t index)
+{
+	Node& h = nodes_[head];
+	Node& n = nodes_[index];
+	n.prev = h.prev;
+	n.next = head;
+	nodes_[h.prev].next = index;
+	h.prev = index;
+}
+
+void TimerWheel::Unlink(uint32_t index)
+{
+	Node& n = nodes_[index];
+	nodes_[n.prev].next = n.next;
+	nodes_[n.next].prev = n.prev;
+	n.prev = n.next = NIL;
+}
+
+// Lowest level whose higher-order bits already match the current tick, so the
+// slot is reached (and cascaded down) before the timer is due.
+void TimerWheel::Place(uint32_t index)
+{
+	const uint64_t expires = nodes_[index].expires;
+	int level = 0;
+	while (level < LEVELS - 1 && (expires >> ((level + 1) * SLOT_BITS)) != (now_ >> ((level + 1) * SLOT_BITS)))
+		++level;
+	Link(SlotHead(level, expires), index);
+}
+
+void TimerWheel::Cascade(int level)
+{
+	const uint32_t head = SlotHead(level, now_);
+	uint32_t i = nodes_[head].next;
+	nodes_[head].prev = nodes_[head].next = head;
+	while (i != head)
+	{
+		const uint32_t next = nodes_[i].next;
+		Place(i);
+		i = next;
+	}
+}
+
+void TimerWheel::Release(uint32_t index)
+{
+	Node& n = nodes_[index];
+	n.active = false;
+	n.cb = nullptr;
+	++n.generation;
+	if (n.generation == 0) n.generation = 1;
+	free_.push_back(index);
+	--size_;
+}
+
+TimerHandle TimerWheel::Schedule(uint64_t delayTicks, Callback cb, uint32_t group)
+{
+	uint32_t index;
+	if (!free_.empty())
+	{
+		index = free_.back();
+		free_.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(nodes_.size());
+		nodes_.emplace_back();
+	}
+	Node& n = nodes_[index];
+	n.active = true;
+	n.group = group;
+	n.expires = now_ + std::clamp<uint64_t>(delayTicks, 1, MAX_DELAY_TICKS);
+	n.cb = std::move(cb);
+	++size_;
+	Place(index);
+	return (static_cast<uint64_t>(n.generation) << 32) | index;
+}
+
+bool TimerWheel::Cancel(TimerHandle handle)
+{
+	if (!Resolve(handle)) return false;
+	const uint32_t index = static_cast<uint32_t>(handle);
+	Unlink(index);
+	Release(index);
+	return true;
+}
+
+size_t TimerWheel::CancelGroup(uint32_t group)
+{
+	size_t cancelled = 0;
+	for (uint32_t i = FIRST_TIMER; i < nodes_.size(); ++i)
+	{
+		if (!nodes_[i].active || nodes_[i].group != group) continue;
+		Unlink(i);
+		Release(i);
+		++cancelled;
+	}
+	return cancelled;
+}
+
+void TimerWheel::Advance(uint64_t nowTick)
+{
+	while (now_ < nowTick)
+	{
+		++now_;
+		// Higher levels first so their timers can land in the lower slot that is cascaded next.
+		for (int level = LEVELS - 1; level > 0; --level)
+		{
+			if ((now_ & ((1ull << (level * SLOT_BITS)) - 1)) == 0)
+				Cascade(level);
+		}
+
+		// Move the due slot onto the firing list so callbacks may freely schedule or cancel.
+		const uint32_t head = SlotHead(0, now_);
+		if (nodes_[head].next == head) continue;
+		Node& firing = nodes_[FIRING_HEAD];
+		firing.next = nodes_[head].next;
+		firing.prev = nodes_[head].prev;
+		nodes_[firing.next].prev = FIRING_HEAD;
+		nodes_[firing.prev].next = FIRING_HEAD;
+		nodes_[head].prev = nodes_[head].next = head;
+
+		while (nodes_[FIRING_HEAD].next != FIRING_HEAD)
+		{
+			const uint32_t index = nodes_[FIRING_HEAD].next;
+			Unlink(index);
+			Callback cb = std::move(nodes_[index].cb);
+			Release(index);
+			if (cb) cb();
+		}
+	}
+}
+
+bool TimerWheel::IsPending(TimerHandle handle) const
+{
+	return Resolve(handle) != nullptr;
+}
+
+uint64_t TimerWheel::RemainingTicks(TimerHandle handle) const
+{
+	const Node* n = Resolve(handle);
+	if (!n) return 0;
+	return n->expires > now_ ? n->expires - now_ : 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 0 is never handed out, so it can be used as "no timer".
+using TimerHandle = uint64_t;
+
+// Hierarchical timing wheel (4 levels x 256 slots) over an intrusive,
+// index-linked node pool. Schedule and Cancel are O(1); Advance only touches
+// the slot that expires on each tick plus an occasional cascade, so pending
+// timers are never scanned per tick.
+class TimerWheel
+{
+public:
+	using Callback = std::function<void()>;
+
+	static constexpr int LEVELS = 4;
+	static constexpr int SLOT_BITS = 8;
+	static constexpr int SLOTS = 1 << SLOT_BITS;
+
+	explicit TimerWheel(uint64_t nowTick = 0);
+
+	// Delays of 0 fire on the next Advance().
+	TimerHandle Schedule(uint64_t delayTicks, Callback cb, uint32_t group = 0);
+	bool Cancel(TimerHandle handle);
+	// Walks the node pool once; meant for rare events such as match end.
+	size_t CancelGroup(uint32_t group);
+
+	// Runs every timer due up to and including nowTick.
+	void Advance(uint64_t nowTick);
+
+	bool IsPending(TimerHandle handle) const;
+	uint64_t RemainingTicks(TimerHandle handle) const;
+	uint64_t Now() const { return now_; }
+	size_t Size() const { return size_; }
+
+private:
+	static constexpr uint32_t NIL = 0xFFFFFFFFu;
+	static constexpr uint32_t FIRING_HEAD = LEVELS * SLOTS;
+	static constexpr uint32_t FIRST_TIMER = FIRING_HEAD + 1;
+
+	struct Node
+	{
+		uint32_t prev = NIL;
+		uint32_t next = NIL;
+		uint32_t generation = 1;
+		uint32_t group = 0;
+		uint64_t expires = 0;
+		bool active = false;
+		Callback cb;
+	};
+
+	static uint32_t SlotHead(int level, uint64_t tick);
+	const Node* Resolve(TimerHandle handle) const;
+	void Link(uint32_t head, uint32_t index);
+	void Unlink(uint32_t index);
+	void Place(uint32_t index);
+	void Cascade(int level);
+	void Release(uint32_t index);
+
+	std::vector<Node> nodes_;
+	std::vector<uint32_t> free_;
+	uint64_t now_ = 0;
+	size_t size_ = 0;
+};
@@ -2,7 +2,12 @@
 #pragma once
 #include <string>
 #include <source_location>
+#if __has_include(<format>)
 #include <format>
+#else
+// Only tools/ builds get here (GCC 12); the stand-in SDK provides the subset of <format> used by the plugin.
+#include "format_fallback.h"
+#endif
 #include <memory>
 
 #include "bakkesmod/wrappers/cvarmanagerwrapper.h"
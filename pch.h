@@ -2,7 +2,10 @@
 
 #define WIN32_LEAN_AND_MEAN
 #define _CRT_SECURE_NO_WARNINGS
+// Tools in tools/ build plugin sources without the SDK (-DMAH_STANDALONE).
+#ifndef MAH_STANDALONE
 #include "bakkesmod/plugin/bakkesmodplugin.h"
+#endif
 
 #include <string>
 #include <vector>
@@ -14,4 +17,6 @@
 #include "IMGUI/imgui_searchablecombo.h"
 #include "IMGUI/imgui_rangeslider.h"
 
-#include "logging.h"
\ No newline at end of file
+#ifndef MAH_STANDALONE
+#include "logging.h"
+#endif
\ No newline at end of file
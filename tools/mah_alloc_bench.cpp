@@ -0,0 +1,167 @@
+// Stress test and benchmark for ImGuiAllocator (Linux).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp ../IMGUI/imgui_demo.cpp"
+//   g++ -O2 -std=c++17 -DMAH_STANDALONE -I. -I.. -I../IMGUI mah_alloc_bench.cpp ../ImGuiAllocator.cpp $SRC -o mah_alloc_bench
+//   ./mah_alloc_bench [frames]
+//
+// Runs the same work with ImGui's default malloc/free, the Counting mode the
+// plugin installs and the Pooled mode:
+//   churn   random MemAlloc/MemFree of 8 B..8 KB over a live set of 4096 blocks
+//   vectors ImVector growth and clears, as draw lists and storage do
+//   frames  headless frames of the demo window plus windows created and
+//           dropped over time, then DestroyContext
+//   scratch per-frame ImGuiTextBuffer work, inside a TransientScope for Pooled
+// and checks that every mode ends with no live blocks.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+#include "imgui.h"
+#include "ImGuiAllocator.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+enum class Setup { Default, Counting, Pooled };
+static const char* SetupName(Setup s) { return s == Setup::Default ? "malloc" : s == Setup::Counting ? "counting" : "pooled"; }
+
+static double Churn(int ops)
+{
+	std::mt19937 rng(11);
+	std::vector<void*> live(4096, nullptr);
+	const auto t0 = Clock::now();
+	for (int i = 0; i < ops; ++i)
+	{
+		void*& slot = live[rng() % live.size()];
+		if (slot)
+		{
+			ImGui::MemFree(slot);
+			slot = nullptr;
+		}
+		else
+		{
+			// Mostly small, like ImGui's own blocks, with a tail of large buffers.
+			const uint32_t r = rng();
+			const size_t size = (r & 15) == 0 ? 4096 + r % 4096 : 8 + (r >> 4) % 512;
+			slot = ImGui::MemAlloc(size);
+			static_cast<char*>(slot)[0] = 1;
+		}
+	}
+	for (void* p : live) ImGui::MemFree(p);
+	return Ms(t0) * 1e6 / ops;
+}
+
+static double Vectors(int rounds)
+{
+	std::mt19937 rng(5);
+	const auto t0 = Clock::now();
+	for (int r = 0; r < rounds; ++r)
+	{
+		ImVector<ImDrawVert> vtx;
+		ImVector<ImDrawIdx> idx;
+		ImVector<ImGuiStorage::ImGuiStoragePair> pairs;
+		const int n = 64 + static_cast<int>(rng() % 4096);
+		for (int i = 0; i < n; ++i)
+		{
+			vtx.push_back(ImDrawVert());
+			idx.push_back(static_cast<ImDrawIdx>(i));
+			if ((i & 7) == 0) pairs.push_back(ImGuiStorage::ImGuiStoragePair(static_cast<ImGuiID>(i), i));
+		}
+		if (r & 1) vtx.clear();
+	}
+	return Ms(t0) / rounds * 1000.0;
+}
+
+static void DrawFrame(int f)
+{
+	ImGui::GetIO().DeltaTime = 1.f / 60.f;
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(ImVec2(700, 900), ImGuiCond_Always);
+	ImGui::ShowDemoWindow();
+	// A rotating set of short-lived windows: creation and destruction of per-window buffers.
+	char name[32];
+	for (int w = 0; w < 4; ++w)
+	{
+		std::snprintf(name, sizeof(name), "Temp %d", (f / 30 + w) % 12);
+		ImGui::SetNextWindowPos(ImVec2(720.f + w * 280.f, 10), ImGuiCond_Always);
+		ImGui::Begin(name);
+		for (int i = 0; i < 40; ++i) ImGui::Text("row %d of frame %d", i, f);
+		ImGui::End();
+	}
+	ImGui::Render();
+}
+
+static void Scratch(ImGuiAllocator* alloc, int frames)
+{
+	for (int f = 0; f < frames; ++f)
+	{
+		if (alloc) alloc->BeginFrame(f);
+		std::optional<ImGuiAllocator::TransientScope> scope;
+		if (alloc) scope.emplace(*alloc);
+		ImGuiTextBuffer buf;
+		for (int i = 0; i < 200; ++i) buf.appendf("line %d of frame %d: %s\n", i, f, "some text to make the buffer grow");
+		ImVector<int> offsets;
+		for (int i = 0; i < buf.size(); ++i)
+			if (buf.c_str()[i] == '\n') offsets.push_back(i);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const int frames = argc > 1 ? std::atoi(argv[1]) : 600;
+	int failures = 0;
+	std::printf("%-9s %10s %12s %12s %12s %10s %12s %10s\n", "mode", "churn ns", "vectors us", "frames ms", "scratch ms",
+		"allocs/f", "peak KB", "live");
+	for (Setup setup : { Setup::Default, Setup::Counting, Setup::Pooled })
+	{
+		ImGuiAllocator alloc;
+		if (setup != Setup::Default)
+			alloc.Install(setup == Setup::Pooled ? ImGuiAllocator::Mode::Pooled : ImGuiAllocator::Mode::Counting);
+
+		const double churnNs = Churn(4000000);
+		const double vectorsUs = Vectors(2000);
+
+		ImGuiContext* ctx = ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2(1920, 1080);
+		io.IniFilename = nullptr;
+		unsigned char* pixels;
+		int w, h;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+		// Warm-up frames create the demo's state; measure the steady state after them.
+		for (int f = 0; f < 60; ++f) { alloc.BeginFrame(f); DrawFrame(f); }
+		alloc.BeginFrame(60);
+		const uint64_t allocsBefore = alloc.Stats().allocs;
+		auto t0 = Clock::now();
+		for (int f = 60; f < 60 + frames; ++f) { alloc.BeginFrame(f); DrawFrame(f); }
+		const double frameMs = Ms(t0) / frames;
+		alloc.BeginFrame(60 + frames);
+		const uint64_t frameAllocs = alloc.Stats().allocs - allocsBefore;
+		ImGui::DestroyContext(ctx);
+
+		t0 = Clock::now();
+		Scratch(setup == Setup::Pooled ? &alloc : nullptr, frames);
+		const double scratchMs = Ms(t0) / frames;
+
+		alloc.BeginFrame(-1);
+		const ImGuiAllocStats st = alloc.Stats();
+		const double allocsPerFrame = static_cast<double>(frameAllocs) / frames;
+		std::printf("%-9s %10.1f %12.1f %12.3f %12.4f %10.2f %12lld %10lld\n", SetupName(setup), churnNs, vectorsUs, frameMs, scratchMs,
+			allocsPerFrame, static_cast<long long>(st.peakBytes / 1024), static_cast<long long>(st.liveBlocks));
+		if (setup == Setup::Pooled)
+			std::printf("          pooled %llu, large %llu, transient %llu; slabs %zu KB; arena peak %zu B of %zu B\n",
+				static_cast<unsigned long long>(st.pooledAllocs), static_cast<unsigned long long>(st.largeAllocs),
+				static_cast<unsigned long long>(st.transientAllocs), st.slabBytes / 1024, st.arenaPeak, st.arenaCapacity);
+		if (setup != Setup::Default && st.liveBlocks != 0)
+		{
+			std::printf("          FAIL: %lld block(s) still live\n", static_cast<long long>(st.liveBlocks));
+			++failures;
+		}
+		alloc.Uninstall();
+	}
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+// Correctness check and benchmark for the PathArcTo() unit-circle cache (Linux).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   g++ -O2 -std=c++17 -D'ImDrawIdx=unsigned int' -I. -I../IMGUI mah_arc_bench.cpp $SRC -o mah_arc_bench
+//   ./mah_arc_bench [frames]
+//
+// Compares paths and AddCircle()/AddCircleFilled() output, bit for bit, against upstream 1.75's cosf/sinf
+// loop (copied below) for explicit and automatic segment counts and arbitrary arcs. Then draws 10k circles
+// per frame (radii 2..200 px, automatic and fixed segment counts, filled and outlined) and reports the
+// cost of building the paths alone and of the whole AddCircle*() calls. Build with
+// -DIMGUI_DISABLE_ARC_CACHE to time the uncached code against itself.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "imgui.h"
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imgui_internal.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Upstream 1.75 implementations, PathArcTo() renamed so the circle functions use it.
+struct RefDrawList : ImDrawList
+{
+    explicit RefDrawList(const ImDrawListSharedData* data) : ImDrawList(data) {}
+
+    void RefPathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
+    {
+        if (radius == 0.0f)
+        {
+            _Path.push_back(center);
+            return;
+        }
+
+        // Note that we are adding a point at both a_min and a_max.
+        // If you are trying to draw a full closed circle you don't want the overlapping points!
+        _Path.reserve(_Path.Size + (num_segments + 1));
+        for (int i = 0; i <= num_segments; i++)
+        {
+            const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
+            _Path.push_back(ImVec2(center.x + ImCos(a) * radius, center.y + ImSin(a) * radius));
+        }
+    }
+
+    int RefSegments(float radius, int num_segments)
+    {
+        if (num_segments <= 0)
+        {
+            // Automatic segment count
+            const int radius_idx = (int)radius - 1;
+            if (radius_idx < IM_ARRAYSIZE(_Data->CircleSegmentCounts))
+                num_segments = _Data->CircleSegmentCounts[radius_idx]; // Use cached value
+            else
+                num_segments = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC(radius, _Data->CircleSegmentMaxError);
+        }
+        else
+        {
+            // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+            num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        }
+        return num_segments;
+    }
+
+    void RefAddCircle(const ImVec2& center, float radius, ImU32 col, int num_segments, float thickness)
+    {
+        if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
+            return;
+        num_segments = RefSegments(radius, num_segments);
+
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        if (num_segments == 12)
+            PathArcToFast(center, radius - 0.5f, 0, 12);
+        else
+            RefPathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
+        PathStroke(col, true, thickness);
+    }
+
+    void RefAddCircleFilled(const ImVec2& center, float radius, ImU32 col, int num_segments)
+    {
+        if ((col & IM_COL32_A_MASK) == 0 || radius <= 0.0f)
+            return;
+        num_segments = RefSegments(radius, num_segments);
+
+        // Because we are filling a closed shape we remove 1 from the count of segments/points
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        if (num_segments == 12)
+            PathArcToFast(center, radius, 0, 12);
+        else
+            RefPathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
+        PathFillConvex(col);
+    }
+};
+
+struct Circle
+{
+    ImVec2 center;
+    float radius;
+    int segments;       // 0: automatic
+    bool filled;
+};
+
+// UI-like mix: mostly small handles and markers with automatic counts, some fixed counts as widgets pass them.
+static std::vector<Circle> MakeCircles(std::mt19937& rng, int n)
+{
+    static const int fixed[] = { 0, 0, 0, 0, 0, 8, 16, 24, 32 };
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    std::vector<Circle> out((size_t)n);
+    for (Circle& c : out)
+    {
+        c.center = ImVec2(u(rng) * 1920.0f, u(rng) * 1080.0f);
+        const float r = u(rng);
+        c.radius = r < 0.8f ? 2.0f + u(rng) * 14.0f : 16.0f + u(rng) * 184.0f;
+        c.segments = fixed[rng() % IM_ARRAYSIZE(fixed)];
+        c.filled = (rng() & 1) != 0;
+    }
+    return out;
+}
+
+static void Reset(ImDrawList& dl)
+{
+    dl.Clear();
+    dl.PushClipRectFullScreen();
+    dl.Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+}
+
+static bool Same(const ImDrawList& a, const ImDrawList& b)
+{
+    return a.VtxBuffer.Size == b.VtxBuffer.Size && a.IdxBuffer.Size == b.IdxBuffer.Size
+        && memcmp(a.VtxBuffer.Data, b.VtxBuffer.Data, (size_t)a.VtxBuffer.Size * sizeof(ImDrawVert)) == 0
+        && memcmp(a.IdxBuffer.Data, b.IdxBuffer.Data, (size_t)a.IdxBuffer.Size * sizeof(ImDrawIdx)) == 0;
+}
+
+static bool SamePath(const ImDrawList& a, const ImDrawList& b)
+{
+    return a._Path.Size == b._Path.Size && memcmp(a._Path.Data, b._Path.Data, (size_t)a._Path.Size * sizeof(ImVec2)) == 0;
+}
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+    ImDrawListSharedData shared;
+    shared.TexUvWhitePixel = ImVec2(0.25f, 0.75f);
+    shared.ClipRectFullscreen = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f);
+    shared.SetCircleSegmentMaxError(1.60f);
+    RefDrawList mine(&shared), ref(&shared);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+
+    int checks = 0, mismatches = 0;
+    auto check = [&](bool ok, const char* what, int n) {
+        checks++;
+        if (!ok && mismatches++ < 5)
+            std::printf("  MISMATCH %s (%d)\n", what, n);
+    };
+    for (int n = 3; n <= IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX; n++)
+    {
+        for (int rep = 0; rep < 4; rep++)
+        {
+            const ImVec2 c(u(rng) * 1920.0f, u(rng) * 1080.0f);
+            const float r = 1.0f + u(rng) * 300.0f;
+            const float th = 1.0f + (float)(n % 3);
+            Reset(mine); Reset(ref);
+            mine.AddCircle(c, r, IM_COL32_WHITE, n, th);
+            ref.RefAddCircle(c, r, IM_COL32_WHITE, n, th);
+            mine.AddCircleFilled(c, r, IM_COL32_WHITE, n);
+            ref.RefAddCircleFilled(c, r, IM_COL32_WHITE, n);
+            check(Same(mine, ref), "explicit segments", n);
+        }
+    }
+    for (int i = 0; i < 20000; i++)
+    {
+        const ImVec2 c(u(rng) * 1920.0f, u(rng) * 1080.0f);
+        const float r = 1.0f + u(rng) * (i < 10000 ? 64.0f : 2000.0f);
+        Reset(mine); Reset(ref);
+        mine.AddCircleFilled(c, r, IM_COL32_WHITE, 0);
+        ref.RefAddCircleFilled(c, r, IM_COL32_WHITE, 0);
+        check(Same(mine, ref), "automatic segments", (int)r);
+    }
+    for (int i = 0; i < 20000; i++)
+    {
+        const ImVec2 c(u(rng) * 1920.0f, u(rng) * 1080.0f);
+        const float r = u(rng) * 300.0f, a0 = (u(rng) - 0.5f) * 20.0f, a1 = a0 + (u(rng) - 0.5f) * 20.0f;
+        const int n = 1 + (int)(rng() % 1500);
+        mine.PathClear(); ref.PathClear();
+        mine.PathArcTo(c, r, a0, a1, n);
+        ref.RefPathArcTo(c, r, a0, a1, n);
+        check(SamePath(mine, ref), "arc", n);
+    }
+    std::printf("%d comparisons, %d mismatching\n", checks, mismatches);
+
+    // Automatic arcs: segment count follows the span, within the error bound of the full circle.
+    mine.PathClear();
+    mine.PathArcTo(ImVec2(0, 0), 100.0f, 0.0f, IM_PI * 0.5f, 0);
+    const int quarter = mine._Path.Size - 1;
+    mine.PathClear();
+    mine.PathArcTo(ImVec2(0, 0), 100.0f, 0.0f, IM_PI * 2.0f, 0);
+    std::printf("automatic PathArcTo, radius 100: %d segments for a quarter, %d for a full turn\n\n", quarter, mine._Path.Size - 1);
+    mine.PathClear();
+
+    const std::vector<Circle> circles = MakeCircles(rng, 10000);
+    double path_ms[2] = { 0, 0 }, draw_ms[2] = { 0, 0 };
+    for (int f = 0; f < frames; f++)
+    {
+        for (int which = 0; which < 2; which++)
+        {
+            RefDrawList& dl = which ? ref : mine;
+            auto t0 = Clock::now();
+            for (const Circle& c : circles)
+            {
+                const int n = dl.RefSegments(c.radius, c.segments);
+                const float a_max = (IM_PI * 2.0f) * ((float)n - 1.0f) / (float)n;
+                if (which) dl.RefPathArcTo(c.center, c.radius, 0.0f, a_max, n - 1);
+                else       dl.PathArcTo(c.center, c.radius, 0.0f, a_max, n - 1);
+                dl._Path.Size = 0;
+            }
+            path_ms[which] += Ms(t0);
+
+            Reset(dl);
+            t0 = Clock::now();
+            for (const Circle& c : circles)
+            {
+                if (c.filled) which ? dl.RefAddCircleFilled(c.center, c.radius, IM_COL32_WHITE, c.segments) : dl.AddCircleFilled(c.center, c.radius, IM_COL32_WHITE, c.segments);
+                else          which ? dl.RefAddCircle(c.center, c.radius, IM_COL32_WHITE, c.segments, 1.0f) : dl.AddCircle(c.center, c.radius, IM_COL32_WHITE, c.segments, 1.0f);
+            }
+            draw_ms[which] += Ms(t0);
+        }
+    }
+    std::printf("10000 circles per frame, %d frames, %d vertices per frame\n", frames, mine.VtxBuffer.Size);
+    std::printf("%-22s %12s %12s %9s\n", "", "upstream ms", "cached ms", "speedup");
+    std::printf("%-22s %12.3f %12.3f %8.2fx\n", "paths only / frame", path_ms[1] / frames, path_ms[0] / frames, path_ms[1] / path_ms[0]);
+    std::printf("%-22s %12.3f %12.3f %8.2fx\n", "AddCircle* / frame", draw_ms[1] / frames, draw_ms[0] / frames, draw_ms[1] / draw_ms[0]);
+    return mismatches == 0 ? 0 : 1;
+}
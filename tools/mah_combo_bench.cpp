@@ -0,0 +1,146 @@
+// Benchmark for the searchable team/player combo (Linux/POSIX).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp ../IMGUI/imgui_searchablecombo.cpp"
+//   g++ -O2 -std=c++17 -I. -I../IMGUI mah_combo_bench.cpp $SRC -o mah_combo_bench
+//   ./mah_combo_bench [items] [frames]
+//
+// Runs a headless ImGui context with the combo popup open and compares
+// SearchableCombo (filters every item every frame) with
+// IndexedSearchableCombo (prebuilt index, clipped rows), then times
+// SearchableComboIndex::Search alone for typed, narrowed and fresh queries,
+// and the per-keystroke cost of fuzzy ranking over 50k candidates.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "imgui_searchablecombo.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point since)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+static std::vector<std::string> MakeNames(int count)
+{
+	static const char* syllables[] = { "ka", "ro", "vi", "ne", "tor", "ax", "lu", "men", "zo", "qui", "dra", "fel", "on", "is", "bur", "gen" };
+	std::mt19937 rng(1234);
+	std::vector<std::string> names;
+	names.reserve(count);
+	for (int i = 0; i < count; ++i)
+	{
+		std::string n;
+		const int parts = 2 + static_cast<int>(rng() % 3);
+		for (int p = 0; p < parts; ++p) n += syllables[rng() % 16];
+		n[0] = static_cast<char>(n[0] - 32);
+		n += " " + std::to_string(i);
+		names.push_back(std::move(n));
+	}
+	return names;
+}
+
+template<typename Fn>
+static double RunFrames(int frames, Fn&& widget)
+{
+	ImGuiIO& io = ImGui::GetIO();
+	double total = 0.0;
+	for (int f = 0; f < frames + 1; ++f)
+	{
+		const auto t0 = Clock::now();
+		io.DeltaTime = 1.f / 60.f;
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0, 0));
+		ImGui::SetNextWindowSize(ImVec2(600, 400));
+		ImGui::Begin("bench");
+		if (f == 0) ImGui::OpenPopup("Team");
+		widget();
+		ImGui::End();
+		ImGui::Render();
+		if (f > 0) total += Ms(t0); // first frame only opens the popup
+	}
+	return total / frames;
+}
+
+int main(int argc, char** argv)
+{
+	const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+	const int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+	const std::vector<std::string> names = MakeNames(count);
+
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(1280, 720);
+	io.IniFilename = nullptr;
+	unsigned char* pixels;
+	int w, h;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+
+	int current = 42;
+	const double legacy = RunFrames(frames, [&]() { ImGui::SearchableCombo("Team", &current, names, "Pick a team", "Search"); });
+
+	auto t0 = Clock::now();
+	SearchableComboIndex index;
+	index.SetItems(names);
+	const double buildMs = Ms(t0);
+	const double indexed = RunFrames(frames, [&]() { ImGui::IndexedSearchableCombo("Team", &current, index, "Pick a team", "Search"); });
+	std::snprintf(index.Query, sizeof(index.Query), "torax");
+	const double indexedQuery = RunFrames(frames, [&]() { ImGui::IndexedSearchableCombo("Team", &current, index, "Pick a team", "Search"); });
+
+	std::printf("%d items, %d frames with the popup open\n", count, frames);
+	std::printf("  SearchableCombo          %8.3f ms/frame\n", legacy);
+	std::printf("  IndexedSearchableCombo   %8.3f ms/frame (empty query)\n", indexed);
+	std::printf("  IndexedSearchableCombo   %8.3f ms/frame (query \"torax\", %zu matches)\n", indexedQuery, index.Matches.size());
+	std::printf("  index build              %8.3f ms\n", buildMs);
+
+	// Search() alone: typing a query letter by letter narrows, a fresh query uses the trigram index.
+	const char* typed = "vimenzo";
+	t0 = Clock::now();
+	std::string q;
+	for (const char* c = typed; *c; ++c)
+	{
+		q += *c;
+		index.Search(q.c_str());
+	}
+	std::printf("  typing \"%s\"          %8.3f ms total, %zu matches\n", typed, Ms(t0), index.Matches.size());
+
+	const char* fresh[] = { "dragen", "12345", "quiax", "zz" };
+	for (const char* f : fresh)
+	{
+		index.Search("");
+		t0 = Clock::now();
+		index.Search(f);
+		std::printf("  fresh query \"%s\"%*s %8.3f ms, %zu matches\n", f, static_cast<int>(9 - std::strlen(f)), "", Ms(t0), index.Matches.size());
+	}
+
+	// Fuzzy ranking, worst keystroke while typing each query (budget: 1 ms at 50k).
+	SearchableComboIndex fuzzy;
+	fuzzy.SetItems(std::vector<std::string>(names.begin(), names.begin() + std::min(count, 50000)));
+	fuzzy.SetFuzzy(true);
+	const char* fuzzyQueries[] = { "kavi", "trxmen", "drafel 42", "zoquion", "a" };
+	for (const char* f : fuzzyQueries)
+	{
+		fuzzy.Search("");
+		double worst = 0.0, total = 0.0;
+		q.clear();
+		for (const char* c = f; *c; ++c)
+		{
+			q += *c;
+			t0 = Clock::now();
+			fuzzy.Search(q.c_str());
+			const double ms = Ms(t0);
+			worst = std::max(worst, ms);
+			total += ms;
+		}
+		std::printf("  fuzzy \"%s\"%*s worst key %6.3f ms, total %6.3f ms, top: %s\n", f, static_cast<int>(10 - std::strlen(f)), "", worst, total,
+			fuzzy.Matches.empty() ? "-" : fuzzy.Items[fuzzy.Matches[0]].c_str());
+	}
+
+	ImGui::DestroyContext();
+	return 0;
+}
@@ -0,0 +1,445 @@
+// Correctness check and benchmark for the batched AddPolyline()/AddConvexPolyFilled() paths (Linux).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   g++ -O2 -std=c++17 -D'ImDrawIdx=unsigned int' -I. -I../IMGUI mah_draw_bench.cpp $SRC -o mah_draw_bench
+//   ./mah_draw_bench
+//
+// Add -mavx2 for the AVX backend or -DIMGUI_DISABLE_DRAW_SIMD for the scalar one; 32-bit indices keep 100k
+// point shapes addressable. With -march=native or -mfma also pass -ffp-contract=off, or GCC fuses the
+// reference's multiply-adds and the comparison reports it. Compares every vertex and index, bit for bit, against upstream 1.75's functions
+// (copied below) for thin/thick, open/closed strokes and fills, including repeated points and hairpin turns,
+// then times both on polylines of 1k, 10k and 100k points.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "imgui.h"
+#ifndef IMGUI_DEFINE_MATH_OPERATORS
+#define IMGUI_DEFINE_MATH_OPERATORS
+#endif
+#include "imgui_internal.h"
+#include "imgui_draw_simd.h"
+#include <alloca.h>
+
+using Clock = std::chrono::steady_clock;
+
+#define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } }
+#define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; }
+
+// Upstream 1.75 implementations, verbatim.
+struct RefDrawList : ImDrawList
+{
+    explicit RefDrawList(const ImDrawListSharedData* data) : ImDrawList(data) {}
+
+    // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
+    // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+    void RefAddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
+    {
+        if (points_count < 2)
+            return;
+
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+
+        int count = points_count;
+        if (!closed)
+            count = points_count-1;
+
+        const bool thick_line = thickness > 1.0f;
+        if (Flags & ImDrawListFlags_AntiAliasedLines)
+        {
+            // Anti-aliased stroke
+            const float AA_SIZE = 1.0f;
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+
+            const int idx_count = thick_line ? count*18 : count*12;
+            const int vtx_count = thick_line ? points_count*4 : points_count*3;
+            PrimReserve(idx_count, vtx_count);
+
+            // Temporary buffer
+            ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2)); //-V630
+            ImVec2* temp_points = temp_normals + points_count;
+
+            for (int i1 = 0; i1 < count; i1++)
+            {
+                const int i2 = (i1+1) == points_count ? 0 : i1+1;
+                float dx = points[i2].x - points[i1].x;
+                float dy = points[i2].y - points[i1].y;
+                IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+                temp_normals[i1].x = dy;
+                temp_normals[i1].y = -dx;
+            }
+            if (!closed)
+                temp_normals[points_count-1] = temp_normals[points_count-2];
+
+            if (!thick_line)
+            {
+                if (!closed)
+                {
+                    temp_points[0] = points[0] + temp_normals[0] * AA_SIZE;
+                    temp_points[1] = points[0] - temp_normals[0] * AA_SIZE;
+                    temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * AA_SIZE;
+                    temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * AA_SIZE;
+                }
+
+                // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+                unsigned int idx1 = _VtxCurrentIdx;
+                for (int i1 = 0; i1 < count; i1++)
+                {
+                    const int i2 = (i1+1) == points_count ? 0 : i1+1;
+                    unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+3;
+
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y)
+                    dm_x *= AA_SIZE;
+                    dm_y *= AA_SIZE;
+
+                    // Add temporary vertexes
+                    ImVec2* out_vtx = &temp_points[i2*2];
+                    out_vtx[0].x = points[i2].x + dm_x;
+                    out_vtx[0].y = points[i2].y + dm_y;
+                    out_vtx[1].x = points[i2].x - dm_x;
+                    out_vtx[1].y = points[i2].y - dm_y;
+
+                    // Add indexes
+                    _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
+                    _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
+                    _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
+                    _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
+                    _IdxWritePtr += 12;
+
+                    idx1 = idx2;
+                }
+
+                // Add vertexes
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                    _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+                    _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+                    _VtxWritePtr += 3;
+                }
+            }
+            else
+            {
+                const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+                if (!closed)
+                {
+                    temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
+                    temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
+                    temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
+                    temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
+                    temp_points[(points_count-1)*4+0] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
+                    temp_points[(points_count-1)*4+1] = points[points_count-1] + temp_normals[points_count-1] * (half_inner_thickness);
+                    temp_points[(points_count-1)*4+2] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness);
+                    temp_points[(points_count-1)*4+3] = points[points_count-1] - temp_normals[points_count-1] * (half_inner_thickness + AA_SIZE);
+                }
+
+                // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+                unsigned int idx1 = _VtxCurrentIdx;
+                for (int i1 = 0; i1 < count; i1++)
+                {
+                    const int i2 = (i1+1) == points_count ? 0 : i1+1;
+                    unsigned int idx2 = (i1+1) == points_count ? _VtxCurrentIdx : idx1+4;
+
+                    // Average normals
+                    float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
+                    float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+                    float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+                    float dm_in_x = dm_x * half_inner_thickness;
+                    float dm_in_y = dm_y * half_inner_thickness;
+
+                    // Add temporary vertexes
+                    ImVec2* out_vtx = &temp_points[i2*4];
+                    out_vtx[0].x = points[i2].x + dm_out_x;
+                    out_vtx[0].y = points[i2].y + dm_out_y;
+                    out_vtx[1].x = points[i2].x + dm_in_x;
+                    out_vtx[1].y = points[i2].y + dm_in_y;
+                    out_vtx[2].x = points[i2].x - dm_in_x;
+                    out_vtx[2].y = points[i2].y - dm_in_y;
+                    out_vtx[3].x = points[i2].x - dm_out_x;
+                    out_vtx[3].y = points[i2].y - dm_out_y;
+
+                    // Add indexes
+                    _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
+                    _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
+                    _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
+                    _IdxWritePtr[9]  = (ImDrawIdx)(idx1+0); _IdxWritePtr[10] = (ImDrawIdx)(idx2+0); _IdxWritePtr[11] = (ImDrawIdx)(idx2+1);
+                    _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
+                    _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
+                    _IdxWritePtr += 18;
+
+                    idx1 = idx2;
+                }
+
+                // Add vertexes
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos = temp_points[i*4+0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
+                    _VtxWritePtr[1].pos = temp_points[i*4+1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+                    _VtxWritePtr[2].pos = temp_points[i*4+2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+                    _VtxWritePtr[3].pos = temp_points[i*4+3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
+                    _VtxWritePtr += 4;
+                }
+            }
+            _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        }
+        else
+        {
+            // Non Anti-aliased Stroke
+            const int idx_count = count*6;
+            const int vtx_count = count*4;      // FIXME-OPT: Not sharing edges
+            PrimReserve(idx_count, vtx_count);
+
+            for (int i1 = 0; i1 < count; i1++)
+            {
+                const int i2 = (i1+1) == points_count ? 0 : i1+1;
+                const ImVec2& p1 = points[i1];
+                const ImVec2& p2 = points[i2];
+
+                float dx = p2.x - p1.x;
+                float dy = p2.y - p1.y;
+                IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+                dx *= (thickness * 0.5f);
+                dy *= (thickness * 0.5f);
+
+                _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+                _VtxWritePtr += 4;
+
+                _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
+                _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx+2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx+3);
+                _IdxWritePtr += 6;
+                _VtxCurrentIdx += 4;
+            }
+        }
+    }
+
+    // We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
+    void RefAddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+    {
+        if (points_count < 3)
+            return;
+
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+
+        if (Flags & ImDrawListFlags_AntiAliasedFill)
+        {
+            // Anti-aliased Fill
+            const float AA_SIZE = 1.0f;
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+            const int idx_count = (points_count-2)*3 + points_count*6;
+            const int vtx_count = (points_count*2);
+            PrimReserve(idx_count, vtx_count);
+
+            // Add indexes for fill
+            unsigned int vtx_inner_idx = _VtxCurrentIdx;
+            unsigned int vtx_outer_idx = _VtxCurrentIdx+1;
+            for (int i = 2; i < points_count; i++)
+            {
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+((i-1)<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx+(i<<1));
+                _IdxWritePtr += 3;
+            }
+
+            // Compute normals
+            ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+            {
+                const ImVec2& p0 = points[i0];
+                const ImVec2& p1 = points[i1];
+                float dx = p1.x - p0.x;
+                float dy = p1.y - p0.y;
+                IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+                temp_normals[i0].x = dy;
+                temp_normals[i0].y = -dx;
+            }
+
+            for (int i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++)
+            {
+                // Average normals
+                const ImVec2& n0 = temp_normals[i0];
+                const ImVec2& n1 = temp_normals[i1];
+                float dm_x = (n0.x + n1.x) * 0.5f;
+                float dm_y = (n0.y + n1.y) * 0.5f;
+                IM_FIXNORMAL2F(dm_x, dm_y);
+                dm_x *= AA_SIZE * 0.5f;
+                dm_y *= AA_SIZE * 0.5f;
+
+                // Add vertices
+                _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+                _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+                _VtxWritePtr += 2;
+
+                // Add indexes for fringes
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
+                _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
+                _IdxWritePtr += 6;
+            }
+            _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        }
+        else
+        {
+            // Non Anti-aliased Fill
+            const int idx_count = (points_count-2)*3;
+            const int vtx_count = points_count;
+            PrimReserve(idx_count, vtx_count);
+            for (int i = 0; i < vtx_count; i++)
+            {
+                _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr++;
+            }
+            for (int i = 2; i < points_count; i++)
+            {
+                _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+i-1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+i);
+                _IdxWritePtr += 3;
+            }
+            _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        }
+    }
+};
+
+enum ShapeKind { Shape_Stroke, Shape_Fill };
+
+struct Case
+{
+    const char* name;
+    ShapeKind kind;
+    bool closed;
+    float thickness;
+};
+
+static const Case CASES[] = {
+    { "thin open",    Shape_Stroke, false, 1.0f },
+    { "thin closed",  Shape_Stroke, true,  1.0f },
+    { "thick open",   Shape_Stroke, false, 3.5f },
+    { "thick closed", Shape_Stroke, true,  3.5f },
+    { "fill",         Shape_Fill,   true,  0.0f },
+};
+
+// Random walk with occasional repeated points (zero-length segments) and reversals (hairpins, where the
+// averaged normal is short and gets clamped), or a convex polygon for fills.
+static std::vector<ImVec2> MakeShape(std::mt19937& rng, int n, ShapeKind kind)
+{
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    std::vector<ImVec2> pts((size_t)n);
+    if (kind == Shape_Fill)
+    {
+        const ImVec2 c(400.0f + u(rng) * 800.0f, 300.0f + u(rng) * 400.0f);
+        const float r = 5.0f + u(rng) * 300.0f;
+        for (int i = 0; i < n; i++)
+        {
+            const float a = 6.2831853f * (float)i / (float)n;
+            pts[i] = ImVec2(c.x + cosf(a) * r, c.y + sinf(a) * r);
+        }
+        return pts;
+    }
+    ImVec2 p(960.0f, 540.0f);
+    float heading = 0.0f;
+    for (int i = 0; i < n; i++)
+    {
+        const float r = u(rng);
+        if (i > 0 && r < 0.05f) { pts[i] = pts[i - 1]; continue; }
+        heading += r < 0.10f ? 3.14159265f : (u(rng) - 0.5f) * 1.2f;
+        const float step = 0.25f + u(rng) * 12.0f;
+        p.x += cosf(heading) * step;
+        p.y += sinf(heading) * step;
+        pts[i] = p;
+    }
+    return pts;
+}
+
+static void Draw(ImDrawList& dl, const Case& c, const std::vector<ImVec2>& pts, bool ref)
+{
+    RefDrawList& r = static_cast<RefDrawList&>(dl);
+    const ImU32 col = IM_COL32(255, 200, 40, 255);
+    if (c.kind == Shape_Fill)
+        ref ? r.RefAddConvexPolyFilled(pts.data(), (int)pts.size(), col) : dl.AddConvexPolyFilled(pts.data(), (int)pts.size(), col);
+    else
+        ref ? r.RefAddPolyline(pts.data(), (int)pts.size(), col, c.closed, c.thickness) : dl.AddPolyline(pts.data(), (int)pts.size(), col, c.closed, c.thickness);
+}
+
+static void Reset(ImDrawList& dl)
+{
+    dl.Clear();
+    dl.PushClipRectFullScreen();
+    dl.Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+}
+
+static int Compare(const ImDrawList& a, const ImDrawList& b)
+{
+    if (a.VtxBuffer.Size != b.VtxBuffer.Size || a.IdxBuffer.Size != b.IdxBuffer.Size)
+        return 1;
+    int bad = 0;
+    for (int i = 0; i < a.VtxBuffer.Size; i++)
+        bad += memcmp(&a.VtxBuffer[i], &b.VtxBuffer[i], sizeof(ImDrawVert)) != 0;
+    bad += memcmp(a.IdxBuffer.Data, b.IdxBuffer.Data, (size_t)a.IdxBuffer.Size * sizeof(ImDrawIdx)) != 0;
+    return bad;
+}
+
+int main()
+{
+    ImDrawListSharedData shared;
+    shared.TexUvWhitePixel = ImVec2(0.25f, 0.75f);
+    shared.ClipRectFullscreen = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f);
+    RefDrawList mine(&shared), ref(&shared);
+    std::printf("backend: %s, ImDrawIdx %zu bytes\n", ImDrawSimd::BackendName(), sizeof(ImDrawIdx));
+
+    // Every size from 2 to 40 covers each remainder of the vector width, then some larger shapes.
+    std::mt19937 rng(3);
+    int shapes = 0, mismatches = 0;
+    for (const Case& c : CASES)
+    {
+        for (int n = 2; n < 300; n += n < 40 ? 1 : 37)
+        {
+            for (int rep = 0; rep < 20; rep++)
+            {
+                const std::vector<ImVec2> pts = MakeShape(rng, n, c.kind);
+                Reset(mine);
+                Reset(ref);
+                Draw(mine, c, pts, false);
+                Draw(ref, c, pts, true);
+                const int bad = Compare(mine, ref);
+                if (bad && mismatches < 5)
+                    std::printf("  MISMATCH %s n=%d: %d vertices/index runs differ\n", c.name, n, bad);
+                mismatches += bad != 0;
+                shapes++;
+            }
+        }
+    }
+    std::printf("%d shapes compared, %d mismatching\n\n", shapes, mismatches);
+
+    std::printf("%-13s %8s %12s %12s %9s\n", "case", "points", "upstream ns", "batched ns", "speedup");
+    for (const Case& c : CASES)
+    {
+        for (int n : { 1000, 10000, 100000 })
+        {
+            const std::vector<ImVec2> pts = MakeShape(rng, n, c.kind);
+            const int reps = 2000000 / n;
+            double best[2] = { 1e30, 1e30 };
+            for (int round = 0; round < 5; round++)
+            {
+                for (int which = 0; which < 2; which++)
+                {
+                    ImDrawList& dl = which ? (ImDrawList&)ref : (ImDrawList&)mine;
+                    const auto t0 = Clock::now();
+                    for (int r = 0; r < reps; r++)
+                    {
+                        Reset(dl);
+                        Draw(dl, c, pts, which == 1);
+                    }
+                    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / ((double)reps * n);
+                    if (ns < best[which]) best[which] = ns;
+                }
+            }
+            std::printf("%-13s %8d %12.2f %12.2f %8.2fx\n", c.name, n, best[1], best[0], best[1] / best[0]);
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
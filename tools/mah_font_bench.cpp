@@ -0,0 +1,147 @@
+// Font atlas build benchmark for the threaded rasterization in ImFontAtlasBuildWithStbTruetype (Linux).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   g++ -O2 -std=c++17 -pthread -I. -I.. -I../IMGUI mah_font_bench.cpp $SRC -o mah_font_bench
+//   ./mah_font_bench [font.ttf] [cjk_font.ttf] [builds]
+//
+// Builds atlases of three sizes with 1, 2, 4 and 8 threads:
+//   latin     GetGlyphRangesDefault, below the threading threshold (a baseline)
+//   cyrillic  GetGlyphRangesCyrillic
+//   cjk       GetGlyphRangesChineseFull from cjk_font.ttf; without one, every
+//             BMP glyph of font.ttf stands in (a few thousand glyphs)
+// at 18 px and 2x oversampling, and checks that the texture and the glyph
+// tables of every threaded build are identical to the single-threaded one.
+// The speedup can only show on a machine with that many cores.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "imgui.h"
+#include "imgui_internal.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+static std::vector<unsigned char> ReadFile(const char* path)
+{
+	std::vector<unsigned char> data;
+	if (FILE* f = std::fopen(path, "rb"))
+	{
+		std::fseek(f, 0, SEEK_END);
+		data.resize(static_cast<size_t>(std::ftell(f)));
+		std::fseek(f, 0, SEEK_SET);
+		if (std::fread(data.data(), 1, data.size(), f) != data.size()) data.clear();
+		std::fclose(f);
+	}
+	return data;
+}
+
+struct Built
+{
+	std::vector<unsigned char> pixels;
+	std::vector<ImFontGlyph> glyphs;
+	int width = 0, height = 0;
+};
+
+static Built Build(std::vector<unsigned char>& ttf, const ImWchar* ranges, int threads, double* ms)
+{
+	ImFontAtlasBuildSetThreadCount(threads);
+	ImFontAtlas atlas;
+	ImFontConfig cfg;
+	cfg.FontDataOwnedByAtlas = false;
+	cfg.OversampleH = 2;
+	ImFont* font = atlas.AddFontFromMemoryTTF(ttf.data(), static_cast<int>(ttf.size()), 18.f, &cfg, ranges);
+	const auto t0 = Clock::now();
+	atlas.Build();
+	*ms = Ms(t0);
+
+	Built out;
+	out.width = atlas.TexWidth;
+	out.height = atlas.TexHeight;
+	out.pixels.assign(atlas.TexPixelsAlpha8, atlas.TexPixelsAlpha8 + atlas.TexWidth * atlas.TexHeight);
+	out.glyphs.assign(font->Glyphs.begin(), font->Glyphs.end());
+	return out;
+}
+
+// Field by field: ImFontGlyph has padding after Codepoint.
+static bool SameGlyph(const ImFontGlyph& a, const ImFontGlyph& b)
+{
+	return a.Codepoint == b.Codepoint && std::memcmp(&a.AdvanceX, &b.AdvanceX, sizeof(float) * 9) == 0;
+}
+
+static bool Same(const Built& a, const Built& b)
+{
+	if (a.width != b.width || a.height != b.height || a.pixels != b.pixels || a.glyphs.size() != b.glyphs.size()) return false;
+	for (size_t i = 0; i < a.glyphs.size(); ++i)
+		if (!SameGlyph(a.glyphs[i], b.glyphs[i])) return false;
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const char* fontPath = argc > 1 && argv[1][0] ? argv[1] : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+	const char* cjkPath = argc > 2 && argv[2][0] ? argv[2] : nullptr;
+	const int builds = argc > 3 ? std::atoi(argv[3]) : 5;
+
+	std::vector<unsigned char> ttf = ReadFile(fontPath);
+	if (ttf.empty())
+	{
+		std::printf("cannot read %s\n", fontPath);
+		return 2;
+	}
+	std::vector<unsigned char> cjkTtf = cjkPath ? ReadFile(cjkPath) : std::vector<unsigned char>();
+	if (cjkPath && cjkTtf.empty())
+	{
+		std::printf("cannot read %s\n", cjkPath);
+		return 2;
+	}
+	if (!cjkPath)
+		std::printf("no CJK font given: 'cjk' is every BMP glyph of %s\n", fontPath);
+
+	ImFontAtlas ranges;
+	static const ImWchar bmp[] = { 0x0020, 0xFFFF, 0 };
+	struct Case { const char* name; std::vector<unsigned char>* ttf; const ImWchar* ranges; };
+	const Case cases[] = {
+		{ "latin", &ttf, ranges.GetGlyphRangesDefault() },
+		{ "cyrillic", &ttf, ranges.GetGlyphRangesCyrillic() },
+		{ "cjk", cjkPath ? &cjkTtf : &ttf, cjkPath ? ranges.GetGlyphRangesChineseFull() : bmp },
+	};
+
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	std::printf("%-9s %7s %11s %10s %10s %10s %10s\n", "ranges", "glyphs", "texture", "1 thr ms", "2 thr ms", "4 thr ms", "8 thr ms");
+	int failures = 0;
+	for (const Case& c : cases)
+	{
+		const int threadCounts[] = { 1, 2, 4, 8 };
+		double best[4];
+		Built reference;
+		for (int t = 0; t < 4; ++t)
+		{
+			best[t] = 1e30;
+			for (int b = 0; b < builds; ++b)
+			{
+				double ms;
+				Built built = Build(*c.ttf, c.ranges, threadCounts[t], &ms);
+				best[t] = ms < best[t] ? ms : best[t];
+				if (t == 0 && b == 0)
+					reference = std::move(built);
+				else if (!Same(reference, built))
+				{
+					std::printf("FAIL: %s with %d thread(s) differs from the single-threaded build\n", c.name, threadCounts[t]);
+					++failures;
+					break;
+				}
+			}
+		}
+		char tex[32];
+		std::snprintf(tex, sizeof(tex), "%dx%d", reference.width, reference.height);
+		std::printf("%-9s %7zu %11s %10.2f %10.2f %10.2f %10.2f\n", c.name, reference.glyphs.size(), tex,
+			best[0], best[1], best[2], best[3]);
+	}
+	ImFontAtlasBuildSetThreadCount(0);
+	std::printf(failures == 0 ? "all builds identical\n" : "%d mismatching build(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
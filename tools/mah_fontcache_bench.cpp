@@ -0,0 +1,237 @@
+// Startup benchmark for the prebuilt font atlas cache (imgui_font_cache.h, Linux).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp ../IMGUI/imgui_font_cache.cpp"
+//   g++ -O2 -std=c++17 -pthread -I. -I.. -I../IMGUI mah_fontcache_bench.cpp $SRC -o mah_fontcache_bench
+//   ./mah_fontcache_bench [font.ttf] [cjk_font.ttf] [runs]
+//
+// For two atlases (the plugin's default set with a merged icon range and a
+// custom rectangle, and a large one: GetGlyphRangesChineseFull from
+// cjk_font.ttf, or every BMP glyph of font.ttf without one) it times
+//   cold  Build() + ImFontAtlasCacheSave()
+//   warm  ImFontAtlasCacheLoad() from the file written by the cold run
+// each starting from a fresh atlas with the font file already in memory, and
+// checks that the loaded atlas is identical to the built one: pixels, glyphs,
+// lookup tables, metrics and custom rectangle positions. It then checks that
+// stale (other size), corrupted and truncated files are rejected.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_font_cache.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+static std::vector<unsigned char> ReadFile(const char* path)
+{
+	std::vector<unsigned char> data;
+	if (FILE* f = std::fopen(path, "rb"))
+	{
+		std::fseek(f, 0, SEEK_END);
+		data.resize(static_cast<size_t>(std::ftell(f)));
+		std::fseek(f, 0, SEEK_SET);
+		if (std::fread(data.data(), 1, data.size(), f) != data.size()) data.clear();
+		std::fclose(f);
+	}
+	return data;
+}
+
+static void WriteFile(const std::string& path, const std::vector<unsigned char>& data)
+{
+	if (FILE* f = std::fopen(path.c_str(), "wb"))
+	{
+		std::fwrite(data.data(), 1, data.size(), f);
+		std::fclose(f);
+	}
+}
+
+struct Case
+{
+	const char* name;
+	std::vector<unsigned char>* ttf;
+	const ImWchar* ranges;
+	bool merged;	// Merge a second range into the first font and add a custom glyph, as the plugin's icon font does
+};
+
+static void Setup(ImFontAtlas& atlas, const Case& c, float size)
+{
+	ImFontConfig cfg;
+	cfg.FontDataOwnedByAtlas = false;
+	cfg.OversampleH = 2;
+	ImFont* font = atlas.AddFontFromMemoryTTF(c.ttf->data(), static_cast<int>(c.ttf->size()), size, &cfg, c.ranges);
+	if (c.merged)
+	{
+		static const ImWchar arrows[] = { 0x2190, 0x21FF, 0 };
+		cfg.MergeMode = true;
+		cfg.GlyphOffset = ImVec2(0.f, 1.f);
+		atlas.AddFontFromMemoryTTF(c.ttf->data(), static_cast<int>(c.ttf->size()), size, &cfg, arrows);
+		atlas.AddCustomRectFontGlyph(font, 0xE000, 13, 13, 14.f);
+		ImFontConfig large;
+		large.FontDataOwnedByAtlas = false;
+		atlas.AddFontFromMemoryTTF(c.ttf->data(), static_cast<int>(c.ttf->size()), size * 1.5f, &large, atlas.GetGlyphRangesDefault());
+	}
+}
+
+// Field by field: ImFontGlyph has padding after Codepoint.
+static bool SameGlyph(const ImFontGlyph& a, const ImFontGlyph& b)
+{
+	return a.Codepoint == b.Codepoint && std::memcmp(&a.AdvanceX, &b.AdvanceX, sizeof(float) * 9) == 0;
+}
+
+static const char* Compare(const ImFontAtlas& a, const ImFontAtlas& b)
+{
+	if (a.TexWidth != b.TexWidth || a.TexHeight != b.TexHeight) return "texture size";
+	if (std::memcmp(a.TexPixelsAlpha8, b.TexPixelsAlpha8, static_cast<size_t>(a.TexWidth) * a.TexHeight) != 0) return "pixels";
+	if (a.TexUvScale.x != b.TexUvScale.x || a.TexUvScale.y != b.TexUvScale.y) return "TexUvScale";
+	if (a.TexUvWhitePixel.x != b.TexUvWhitePixel.x || a.TexUvWhitePixel.y != b.TexUvWhitePixel.y) return "TexUvWhitePixel";
+	if (a.CustomRects.Size != b.CustomRects.Size) return "custom rect count";
+	for (int i = 0; i < a.CustomRects.Size; ++i)
+		if (a.CustomRects[i].X != b.CustomRects[i].X || a.CustomRects[i].Y != b.CustomRects[i].Y) return "custom rect position";
+	for (int f = 0; f < a.Fonts.Size; ++f)
+	{
+		const ImFont& fa = *a.Fonts[f];
+		const ImFont& fb = *b.Fonts[f];
+		if (fa.FontSize != fb.FontSize || fa.Ascent != fb.Ascent || fa.Descent != fb.Descent) return "font metrics";
+		if (fa.ConfigDataCount != fb.ConfigDataCount || fa.MetricsTotalSurface != fb.MetricsTotalSurface) return "font config";
+		if (fa.EllipsisChar != fb.EllipsisChar || fa.FallbackAdvanceX != fb.FallbackAdvanceX) return "ellipsis/fallback";
+		if ((fa.FallbackGlyph - fa.Glyphs.Data) != (fb.FallbackGlyph - fb.Glyphs.Data)) return "fallback glyph";
+		if (fa.ConfigData - a.ConfigData.Data != fb.ConfigData - b.ConfigData.Data) return "config index";
+		if (fa.Glyphs.Size != fb.Glyphs.Size) return "glyph count";
+		for (int g = 0; g < fa.Glyphs.Size; ++g)
+			if (!SameGlyph(fa.Glyphs[g], fb.Glyphs[g])) return "glyph";
+		if (fa.IndexLookup.Size != fb.IndexLookup.Size || fa.IndexAdvanceX.Size != fb.IndexAdvanceX.Size) return "lookup size";
+		if (std::memcmp(fa.IndexLookup.Data, fb.IndexLookup.Data, fa.IndexLookup.size_in_bytes()) != 0) return "IndexLookup";
+		if (std::memcmp(fa.IndexAdvanceX.Data, fb.IndexAdvanceX.Data, fa.IndexAdvanceX.size_in_bytes()) != 0) return "IndexAdvanceX";
+	}
+	return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+	const char* fontPath = argc > 1 && argv[1][0] ? argv[1] : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+	const char* cjkPath = argc > 2 && argv[2][0] ? argv[2] : nullptr;
+	const int runs = argc > 3 ? std::atoi(argv[3]) : 5;
+
+	std::vector<unsigned char> ttf = ReadFile(fontPath);
+	std::vector<unsigned char> cjkTtf = cjkPath ? ReadFile(cjkPath) : std::vector<unsigned char>();
+	if (ttf.empty() || (cjkPath && cjkTtf.empty()))
+	{
+		std::printf("cannot read %s\n", ttf.empty() ? fontPath : cjkPath);
+		return 2;
+	}
+	if (!cjkPath)
+		std::printf("no CJK font given: 'large' is every BMP glyph of %s\n", fontPath);
+
+	ImGui::CreateContext();
+	ImFontAtlas ranges;
+	static const ImWchar bmp[] = { 0x0020, 0xFFFF, 0 };
+	const Case cases[] = {
+		{ "plugin", &ttf, ranges.GetGlyphRangesDefault(), true },
+		{ "large", cjkPath ? &cjkTtf : &ttf, cjkPath ? ranges.GetGlyphRangesChineseFull() : bmp, false },
+	};
+
+	char dir[] = "/tmp/mah_fontcache_XXXXXX";
+	if (!mkdtemp(dir))
+	{
+		std::printf("cannot create a temporary directory\n");
+		return 2;
+	}
+
+	std::printf("%-7s %7s %11s %10s %10s %10s %10s\n", "atlas", "glyphs", "texture", "file KB", "key ms", "cold ms", "warm ms");
+	int failures = 0;
+	for (const Case& c : cases)
+	{
+		const std::string path = std::string(dir) + "/" + c.name + ".bin";
+		double bestKey = 1e30, bestCold = 1e30, bestWarm = 1e30;
+		for (int r = 0; r < runs && failures == 0; ++r)
+		{
+			std::remove(path.c_str());
+			ImFontAtlas built;
+			Setup(built, c, 18.f);
+			auto t0 = Clock::now();
+			if (!ImFontAtlasBuildCached(&built, path.c_str()))
+			{
+				std::printf("FAIL: %s: build failed\n", c.name);
+				++failures;
+				break;
+			}
+			const double cold = Ms(t0);
+
+			ImFontAtlas loaded;
+			Setup(loaded, c, 18.f);
+			t0 = Clock::now();
+			ImFontAtlasCacheKey(&loaded);
+			const double key = Ms(t0);
+			t0 = Clock::now();
+			const bool hit = ImFontAtlasBuildCached(&loaded, path.c_str());
+			const double warm = Ms(t0);
+			const char* diff = Compare(built, loaded);
+			if (!hit || diff)
+			{
+				std::printf("FAIL: %s: cached atlas differs from Build() (%s)\n", c.name, diff ? diff : "not loaded");
+				++failures;
+				break;
+			}
+			bestKey = key < bestKey ? key : bestKey;
+			bestCold = cold < bestCold ? cold : bestCold;
+			bestWarm = warm < bestWarm ? warm : bestWarm;
+		}
+
+		// Rejections: each must leave the atlas to be built from the fonts
+		std::vector<unsigned char> file = ReadFile(path.c_str());
+		{
+			ImFontAtlas stale;
+			Setup(stale, c, 19.f);
+			if (ImFontAtlasCacheLoad(&stale, path.c_str()))
+			{
+				std::printf("FAIL: %s: stale file accepted\n", c.name);
+				++failures;
+			}
+		}
+		std::vector<unsigned char> corrupt = file;
+		corrupt[corrupt.size() / 2] ^= 0x40;
+		const std::string badPath = path + ".bad";
+		WriteFile(badPath, corrupt);
+		{
+			ImFontAtlas atlas;
+			Setup(atlas, c, 18.f);
+			if (ImFontAtlasCacheLoad(&atlas, badPath.c_str()))
+			{
+				std::printf("FAIL: %s: corrupted file accepted\n", c.name);
+				++failures;
+			}
+		}
+		WriteFile(badPath, std::vector<unsigned char>(file.begin(), file.begin() + file.size() / 3));
+		{
+			ImFontAtlas atlas;
+			Setup(atlas, c, 18.f);
+			if (ImFontAtlasCacheLoad(&atlas, badPath.c_str()) || atlas.TexPixelsAlpha8 != nullptr)
+			{
+				std::printf("FAIL: %s: truncated file accepted\n", c.name);
+				++failures;
+			}
+		}
+		std::remove(badPath.c_str());
+
+		ImFontAtlas info;
+		Setup(info, c, 18.f);
+		ImFontAtlasCacheLoad(&info, path.c_str());
+		int glyphs = 0;
+		for (ImFont* font : info.Fonts)
+			glyphs += font->Glyphs.Size;
+		char tex[32];
+		std::snprintf(tex, sizeof(tex), "%dx%d", info.TexWidth, info.TexHeight);
+		std::printf("%-7s %7d %11s %10zu %10.3f %10.2f %10.2f\n", c.name, glyphs, tex, file.size() / 1024, bestKey, bestCold, bestWarm);
+		std::remove(path.c_str());
+	}
+	rmdir(dir);
+	ImGui::DestroyContext();
+	std::printf(failures == 0 ? "ok\n" : "%d failure(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+// Memory and first-frame benchmark for ImFontGlyphCache against an eager font atlas (Linux, null renderer).
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   g++ -O2 -std=c++17 -pthread -I. -I.. -I../IMGUI mah_glyph_bench.cpp $SRC -o mah_glyph_bench
+//   ./mah_glyph_bench [font.ttf] [frames]
+//
+// eager  every glyph of the range built by ImFontAtlas::Build()
+// lazy   GetGlyphRangesDefault() built, the rest rasterized on first use
+// The range is GetGlyphRangesChineseFull() when the font has CJK glyphs, every
+// BMP codepoint otherwise (DejaVu Sans, the default, has a few thousand).
+// Each frame shows 400 distinct characters of the range as text; a renderer
+// that "uploads" by copying the whole texture once and then the dirty
+// rectangles stands in for the GPU. Checks that every shown glyph has the same
+// quad, advance and bitmap in both atlases, that text sizes match, and that a
+// small cache under eviction pressure stays correct.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_glyph_cache.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+// ImGui heap usage, from the allocator hooks.
+struct HeapCount { long long live = 0, peak = 0; };
+static HeapCount g_heap;
+
+static void* CountAlloc(size_t size, void*)
+{
+	size_t* p = static_cast<size_t*>(std::malloc(size + 16));
+	if (!p) return nullptr;
+	*p = size;
+	g_heap.live += static_cast<long long>(size);
+	if (g_heap.live > g_heap.peak) g_heap.peak = g_heap.live;
+	return reinterpret_cast<char*>(p) + 16;
+}
+
+static void CountFree(void* ptr, void*)
+{
+	if (!ptr) return;
+	size_t* p = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - 16);
+	g_heap.live -= static_cast<long long>(*p);
+	std::free(p);
+}
+
+// Stands in for the GPU texture: a copy of the RGBA32 pixels, refreshed whole or by sub-rectangle.
+struct NullTexture
+{
+	std::vector<unsigned int> pixels;
+	long long uploadedBytes = 0;
+
+	void UploadAll(ImFontAtlas* atlas)
+	{
+		unsigned char* src;
+		int w, h;
+		atlas->GetTexDataAsRGBA32(&src, &w, &h);
+		pixels.assign(reinterpret_cast<unsigned int*>(src), reinterpret_cast<unsigned int*>(src) + static_cast<size_t>(w) * h);
+		uploadedBytes += static_cast<long long>(w) * h * 4;
+	}
+
+	void UploadDirty(ImFontAtlas* atlas, ImFontGlyphCache& cache)
+	{
+		int x, y, w, h;
+		if (!cache.GetDirtyRect(&x, &y, &w, &h)) return;
+		for (int row = y; row < y + h; ++row)
+			std::memcpy(&pixels[static_cast<size_t>(row) * atlas->TexWidth + x], &atlas->TexPixelsRGBA32[static_cast<size_t>(row) * atlas->TexWidth + x], static_cast<size_t>(w) * 4);
+		uploadedBytes += static_cast<long long>(w) * h * 4;
+		cache.ClearDirtyRect();
+	}
+};
+
+static std::vector<std::string> MakeLines(const std::vector<ImWchar>& chars, size_t first, size_t count, size_t perLine)
+{
+	std::vector<std::string> lines;
+	std::string line;
+	for (size_t i = 0; i < count; ++i)
+	{
+		char utf8[8];
+		ImTextStrToUtf8(utf8, sizeof(utf8), &chars[(first + i) % chars.size()], &chars[(first + i) % chars.size()] + 1);
+		line += utf8;
+		if ((i + 1) % perLine == 0 || i + 1 == count)
+		{
+			lines.push_back(line);
+			line.clear();
+		}
+	}
+	return lines;
+}
+
+static void DrawFrame(const std::vector<std::string>& lines)
+{
+	ImGui::GetIO().DeltaTime = 1.f / 60.f;
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(ImVec2(1920, 1080), ImGuiCond_Always);
+	ImGui::Begin("Broadcast");
+	for (const std::string& l : lines) ImGui::TextUnformatted(l.c_str(), l.c_str() + l.size());
+	ImGui::End();
+	ImGui::Render();
+}
+
+// Pixels of a glyph's rectangle, read back through its UVs.
+static std::vector<unsigned char> GlyphPixels(const ImFontAtlas* atlas, const ImFontGlyph* g)
+{
+	const int x0 = static_cast<int>(g->U0 * atlas->TexWidth + 0.5f), x1 = static_cast<int>(g->U1 * atlas->TexWidth + 0.5f);
+	const int y0 = static_cast<int>(g->V0 * atlas->TexHeight + 0.5f), y1 = static_cast<int>(g->V1 * atlas->TexHeight + 0.5f);
+	std::vector<unsigned char> out;
+	for (int y = y0; y < y1; ++y)
+		out.insert(out.end(), atlas->TexPixelsAlpha8 + y * atlas->TexWidth + x0, atlas->TexPixelsAlpha8 + y * atlas->TexWidth + x1);
+	return out;
+}
+
+// After an eviction the uploaded texture keeps stale texels where nothing is resident. What must match is every
+// texel a resident glyph can sample with bilinear filtering: its rectangle plus one texel around it.
+static bool UploadedMatches(const std::vector<unsigned int>& uploaded, const ImFontAtlas* atlas, const ImFontGlyph* g)
+{
+	const int x0 = ImMax(static_cast<int>(g->U0 * atlas->TexWidth + 0.5f) - 1, 0), x1 = ImMin(static_cast<int>(g->U1 * atlas->TexWidth + 0.5f) + 1, atlas->TexWidth);
+	const int y0 = ImMax(static_cast<int>(g->V0 * atlas->TexHeight + 0.5f) - 1, 0), y1 = ImMin(static_cast<int>(g->V1 * atlas->TexHeight + 0.5f) + 1, atlas->TexHeight);
+	for (int y = y0; y < y1; ++y)
+		if (std::memcmp(&uploaded[static_cast<size_t>(y) * atlas->TexWidth + x0], &atlas->TexPixelsRGBA32[static_cast<size_t>(y) * atlas->TexWidth + x0], static_cast<size_t>(x1 - x0) * 4) != 0)
+			return false;
+	return true;
+}
+
+static bool SameGlyph(const ImFontAtlas* ea, const ImFontGlyph* e, const ImFontAtlas* la, const ImFontGlyph* l)
+{
+	return e && l && e->Codepoint == l->Codepoint && e->AdvanceX == l->AdvanceX && e->X0 == l->X0 && e->Y0 == l->Y0
+		&& e->X1 == l->X1 && e->Y1 == l->Y1 && GlyphPixels(ea, e) == GlyphPixels(la, l);
+}
+
+int main(int argc, char** argv)
+{
+	const char* fontPath = argc > 1 && argv[1][0] ? argv[1] : "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+	const int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+	ImGui::SetAllocatorFunctions(CountAlloc, CountFree, nullptr);
+
+	ImFontConfig cfg;
+	cfg.OversampleH = 2;
+	static const ImWchar bmp[] = { 0x0020, 0xFFFF, 0 };
+	ImFontAtlas probe;
+	ImFont* probeFont = probe.AddFontFromFileTTF(fontPath, 18.f, &cfg, probe.GetGlyphRangesDefault());
+	if (!probeFont)
+	{
+		std::printf("cannot read %s\n", fontPath);
+		return 2;
+	}
+	probe.Build();
+	ImFontAtlas rangesOwner;
+	const bool cjk = probeFont->FindGlyphNoFallback(0x4E2D) != nullptr;
+	const ImWchar* ranges = cjk ? rangesOwner.GetGlyphRangesChineseFull() : bmp;
+	std::printf("font %s, range %s\n", fontPath, cjk ? "GetGlyphRangesChineseFull" : "0x0020-0xFFFF (no CJK glyphs in this font)");
+
+	int failures = 0;
+
+	// Eager
+	g_heap = HeapCount();
+	auto t0 = Clock::now();
+	ImFontAtlas* eager = IM_NEW(ImFontAtlas)();
+	ImFont* eagerFont = eager->AddFontFromFileTTF(fontPath, 18.f, &cfg, ranges);
+	eager->Build();
+	NullTexture eagerTex;
+	eagerTex.UploadAll(eager);
+	const double eagerBuildMs = Ms(t0);
+	const long long eagerBuildPeak = g_heap.peak;
+
+	// Characters to show: the range's glyphs that are not in the default range, spread out.
+	std::vector<ImWchar> lazyChars;
+	for (const ImFontGlyph& g : eagerFont->Glyphs)
+		if (g.Codepoint > 0x00FF) lazyChars.push_back(g.Codepoint);
+	std::vector<ImWchar> shown;
+	for (size_t i = 0; i < 400 && !lazyChars.empty(); ++i) shown.push_back(lazyChars[i * lazyChars.size() / 400]);
+	const std::vector<std::string> lines = MakeLines(shown, 0, shown.size(), 40);
+
+	ImGuiContext* ctx = ImGui::CreateContext(eager);
+	ImGui::GetIO().DisplaySize = ImVec2(1920, 1080);
+	ImGui::GetIO().IniFilename = nullptr;
+	t0 = Clock::now();
+	DrawFrame(lines);
+	const double eagerFirstMs = Ms(t0);
+	t0 = Clock::now();
+	for (int f = 0; f < frames; ++f) DrawFrame(lines);
+	const double eagerFrameMs = Ms(t0) / frames;
+	std::vector<ImVec2> eagerSizes;
+	for (const std::string& l : lines) eagerSizes.push_back(eagerFont->CalcTextSizeA(eagerFont->FontSize, FLT_MAX, 0.f, l.c_str()));
+	ImGui::DestroyContext(ctx);
+	const long long eagerLive = g_heap.live;
+
+	// Lazy
+	g_heap = HeapCount();
+	t0 = Clock::now();
+	ImFontAtlas* lazy = IM_NEW(ImFontAtlas)();
+	ImFont* lazyFont = lazy->AddFontFromFileTTF(fontPath, 18.f, &cfg, lazy->GetGlyphRangesDefault());
+	lazy->Build();
+	ImFontGlyphCache cache;
+	if (!cache.Attach(lazy, lazyFont, ranges))
+	{
+		std::printf("FAIL: Attach\n");
+		return 1;
+	}
+	NullTexture lazyTex;
+	lazyTex.UploadAll(lazy);
+	const double lazyBuildMs = Ms(t0);
+	const long long lazyBuildPeak = g_heap.peak;
+
+	ctx = ImGui::CreateContext(lazy);
+	ImGui::GetIO().DisplaySize = ImVec2(1920, 1080);
+	ImGui::GetIO().IniFilename = nullptr;
+	std::vector<ImVec2> lazySizes;
+	for (const std::string& l : lines) lazySizes.push_back(lazyFont->CalcTextSizeA(lazyFont->FontSize, FLT_MAX, 0.f, l.c_str()));
+	t0 = Clock::now();
+	cache.NewFrame();
+	DrawFrame(lines);
+	lazyTex.UploadDirty(lazy, cache);
+	const double lazyFirstMs = Ms(t0);
+	const long long firstUpload = lazyTex.uploadedBytes;
+	t0 = Clock::now();
+	for (int f = 0; f < frames; ++f)
+	{
+		cache.NewFrame();
+		DrawFrame(lines);
+		lazyTex.UploadDirty(lazy, cache);
+	}
+	const double lazyFrameMs = Ms(t0) / frames;
+	const long long steadyUpload = lazyTex.uploadedBytes - firstUpload;
+	const ImFontGlyphCacheStats stats = cache.GetStats();
+
+	int glyphMismatches = 0;
+	for (ImWchar c : shown)
+		if (!SameGlyph(eager, eagerFont->FindGlyph(c), lazy, lazyFont->FindGlyph(c))) ++glyphMismatches;
+	for (size_t i = 0; i < lines.size(); ++i)
+		if (eagerSizes[i].x != lazySizes[i].x || eagerSizes[i].y != lazySizes[i].y) ++glyphMismatches;
+	if (std::memcmp(lazyTex.pixels.data(), lazy->TexPixelsRGBA32, lazyTex.pixels.size() * 4) != 0)
+	{
+		std::printf("FAIL: uploaded texture differs from the atlas\n");
+		++failures;
+	}
+	ImGui::DestroyContext(ctx);
+	const long long lazyLive = g_heap.live;
+
+	std::printf("%-6s %9s %11s %13s %11s %11s %12s %12s\n", "mode", "build ms", "texture", "tex MB (A+C)", "peak MB", "live MB", "1st frame ms", "frame ms");
+	std::printf("%-6s %9.1f %5dx%-5d %13.2f %11.2f %11.2f %12.2f %12.3f\n", "eager", eagerBuildMs, eager->TexWidth, eager->TexHeight,
+		eager->TexWidth * eager->TexHeight * 5 / 1048576.0, eagerBuildPeak / 1048576.0, eagerLive / 1048576.0, eagerFirstMs, eagerFrameMs);
+	std::printf("%-6s %9.1f %5dx%-5d %13.2f %11.2f %11.2f %12.2f %12.3f\n", "lazy", lazyBuildMs, lazy->TexWidth, lazy->TexHeight,
+		lazy->TexWidth * lazy->TexHeight * 5 / 1048576.0, lazyBuildPeak / 1048576.0, lazyLive / 1048576.0, lazyFirstMs, lazyFrameMs);
+	std::printf("lazy: %d glyphs rasterized, %d resident; first frame uploaded %.1f KB after the initial texture, later frames %lld B\n",
+		stats.GlyphsRasterized, stats.GlyphsResident, (firstUpload - static_cast<long long>(lazy->TexWidth) * lazy->TexHeight * 4) / 1024.0, steadyUpload);
+	if (glyphMismatches)
+	{
+		std::printf("FAIL: %d glyph or text size mismatch(es) between eager and lazy\n", glyphMismatches);
+		++failures;
+	}
+
+	// Eviction: a cache of 64 rows in 4 pages, 200 fresh characters per frame cycling through the range.
+	ImFontAtlas* small = IM_NEW(ImFontAtlas)();
+	ImFont* smallFont = small->AddFontFromFileTTF(fontPath, 18.f, &cfg, small->GetGlyphRangesDefault());
+	small->Build();
+	ImFontGlyphCache smallCache;
+	smallCache.Attach(small, smallFont, ranges, 64, 4, 256);
+	NullTexture smallTex;
+	smallTex.UploadAll(small);
+	ctx = ImGui::CreateContext(small);
+	ImGui::GetIO().DisplaySize = ImVec2(1920, 1080);
+	ImGui::GetIO().IniFilename = nullptr;
+	int evictMismatches = 0;
+	for (int f = 0; f < 60; ++f)
+	{
+		const std::vector<std::string> batch = MakeLines(lazyChars, static_cast<size_t>(f) * 97, 200, 40);
+		smallCache.NewFrame();
+		DrawFrame(batch);
+		smallTex.UploadDirty(small, smallCache);
+		for (int i = 0; i < 200; ++i)
+		{
+			const ImWchar c = lazyChars[(static_cast<size_t>(f) * 97 + i) % lazyChars.size()];
+			const ImFontGlyph* g = smallFont->FindGlyphNoFallback(c);
+			if (g && (!SameGlyph(eager, eagerFont->FindGlyph(c), small, g) || !UploadedMatches(smallTex.pixels, small, g))) ++evictMismatches;
+		}
+	}
+	const ImFontGlyphCacheStats es = smallCache.GetStats();
+	std::printf("eviction: %d rasterized, %d evicted in %d page evictions, %d deferred to the next frame, %d resident\n",
+		es.GlyphsRasterized, es.GlyphsEvicted, es.PagesEvicted, es.GlyphsDeferred, es.GlyphsResident);
+	if (evictMismatches || es.PagesEvicted == 0)
+	{
+		std::printf("FAIL: eviction (%d mismatch(es), %d page evictions)\n", evictMismatches, es.PagesEvicted);
+		++failures;
+	}
+	ImGui::DestroyContext(ctx);
+	smallCache.Detach();
+	cache.Detach();
+	IM_DELETE(small);
+	IM_DELETE(lazy);
+	IM_DELETE(eager);
+	probe.Clear();
+	rangesOwner.Clear();
+	std::printf(failures == 0 ? "ok\n" : "%d failure(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+// Micro-benchmark and collision test for the ImHashStr/ImHashData backends (Linux).
+//
+//   g++ -O2 -std=c++17 -I. -I../IMGUI mah_hash_bench.cpp -o mah_hash_bench
+//   ./mah_hash_bench [source files to take labels from...]
+//
+// Labels are the string literals of the given sources (by default the plugin
+// and the vendored ImGui widgets/demo), hashed the way ImGui does: each one
+// seeded with a window ID, plus PushID(int) chains. Checks first that the
+// default backend matches upstream's byte-wise CRC32 exactly, including the
+// "###" rule, then reports ns/hash and collision counts per backend.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "imgui_hash.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Upstream 1.75 ImHashStr, table generated instead of spelled out.
+static ImU32 ReferenceHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    const ImU32* lut = ImHashImpl::Crc32Table.T[0];
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    if (data_size != 0)
+    {
+        while (data_size-- != 0)
+        {
+            unsigned char c = *data++;
+            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ lut[(crc & 0xFF) ^ c];
+        }
+    }
+    else
+    {
+        while (unsigned char c = *data++)
+        {
+            if (c == '#' && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ lut[(crc & 0xFF) ^ c];
+        }
+    }
+    return ~crc;
+}
+
+static ImU32 ReferenceHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    const ImU32* lut = ImHashImpl::Crc32Table.T[0];
+    ImU32 crc = ~seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ lut[(crc & 0xFF) ^ *data++];
+    return ~crc;
+}
+
+static std::vector<std::string> ExtractLiterals(const char* path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string src = ss.str();
+    std::vector<std::string> out;
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        if (src[i] == '\'' && i + 2 < src.size()) { i += src[i + 1] == '\\' ? 3 : 2; continue; }
+        if (src[i] != '"') continue;
+        std::string lit;
+        size_t j = i + 1;
+        for (; j < src.size() && src[j] != '"' && src[j] != '\n'; ++j)
+        {
+            if (src[j] == '\\' && j + 1 < src.size()) ++j;
+            lit.push_back(src[j]);
+        }
+        if (!lit.empty() && lit.size() < 128) out.push_back(lit);
+        i = j;
+    }
+    return out;
+}
+
+struct BackendInfo
+{
+    const char* name;
+    ImU32 (*str)(const char*, size_t, ImU32);
+    ImU32 (*data)(const void*, size_t, ImU32);
+};
+
+static const BackendInfo BACKENDS[] = {
+    { "crc32 bytewise", ReferenceHashStr, ReferenceHashData },
+    { "crc32 sliced", ImHashImpl::HashStr<ImHashBackend_Crc32>, ImHashImpl::HashData<ImHashBackend_Crc32> },
+    { "crc32c", ImHashImpl::HashStr<ImHashBackend_Crc32c>, ImHashImpl::HashData<ImHashBackend_Crc32c> },
+    { "words", ImHashImpl::HashStr<ImHashBackend_Words>, ImHashImpl::HashData<ImHashBackend_Words> },
+};
+
+static volatile ImU32 g_sink;
+
+template<typename Fn>
+static double NsPerCall(size_t calls, Fn&& fn)
+{
+    double best = 1e30;
+    for (int rep = 0; rep < 5; ++rep)
+    {
+        const auto t0 = Clock::now();
+        ImU32 acc = fn();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        g_sink = acc;
+        if (ns < best) best = ns;
+    }
+    return best / (double)calls;
+}
+
+static int VerifyDefault()
+{
+    std::mt19937 rng(7);
+    const char alphabet[] = "ab#######cdXYZ 0123 _-%/";
+    int mismatches = 0;
+    for (int n = 0; n < 200000; ++n)
+    {
+        std::string s(rng() % 40, 'x');
+        for (char& c : s) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        const ImU32 seed = (n & 1) ? (ImU32)rng() : 0;
+        if (ImHashImpl::HashStr<ImHashBackend_Crc32>(s.c_str(), 0, seed) != ReferenceHashStr(s.c_str(), 0, seed)) ++mismatches;
+        if (!s.empty() && ImHashImpl::HashStr<ImHashBackend_Crc32>(s.data(), s.size(), seed) != ReferenceHashStr(s.data(), s.size(), seed)) ++mismatches;
+        if (ImHashImpl::HashData<ImHashBackend_Crc32>(s.data(), s.size(), seed) != ReferenceHashData(s.data(), s.size(), seed)) ++mismatches;
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i) files.push_back(argv[i]);
+    if (files.empty())
+        files = { "../MatchAdminHotkeys.cpp", "../GuiBase.cpp", "../IMGUI/imgui_demo.cpp", "../IMGUI/imgui_widgets.cpp", "../IMGUI/imgui.cpp" };
+
+    std::unordered_set<std::string> unique;
+    for (const char* f : files)
+        for (std::string& s : ExtractLiterals(f))
+            unique.insert(std::move(s));
+    std::vector<std::string> labels(unique.begin(), unique.end());
+    size_t totalLen = 0;
+    for (const std::string& s : labels) totalLen += s.size();
+    std::printf("%zu distinct labels, mean length %.1f\n", labels.size(), labels.empty() ? 0.0 : (double)totalLen / labels.size());
+
+    const int mismatches = VerifyDefault();
+    std::printf("default backend vs upstream CRC32: %d mismatches in 600000 checks\n", mismatches);
+#if IMGUI_HASH_HAS_X86
+    std::printf("SSE4.2 crc32: %s\n", ImHashImpl::HasSse42 ? "yes" : "no (table fallback)");
+#endif
+
+    const char* windows[] = { "Debug##Default", "MatchAdminHotkeys", "Match Admin Scoreboard", "Dear ImGui Demo" };
+    std::string long64(64, 'a'), long256(256, 'b');
+    std::printf("\n%-16s %9s %9s %9s %9s %11s %11s %11s\n", "backend", "label ns", "int ns", "64B ns", "256B ns",
+        "label coll", "int coll", "row coll");
+    for (const BackendInfo& b : BACKENDS)
+    {
+        const ImU32 winSeed = b.str(windows[0], 0, 0);
+        const double labelNs = NsPerCall(labels.size() * 20, [&] {
+            ImU32 acc = 0;
+            for (int r = 0; r < 20; ++r)
+                for (const std::string& s : labels) acc += b.str(s.c_str(), 0, winSeed);
+            return acc;
+        });
+        const size_t ints = 1000000;
+        const double intNs = NsPerCall(ints, [&] {
+            ImU32 acc = 0;
+            for (size_t i = 0; i < ints; ++i) { int v = (int)i; acc += b.data(&v, sizeof(v), winSeed); }
+            return acc;
+        });
+        const double l64 = NsPerCall(200000, [&] { ImU32 acc = 0; for (int i = 0; i < 200000; ++i) acc += b.str(long64.c_str(), 0, (ImU32)i); return acc; });
+        const double l256 = NsPerCall(50000, [&] { ImU32 acc = 0; for (int i = 0; i < 50000; ++i) acc += b.str(long256.c_str(), 0, (ImU32)i); return acc; });
+
+        // Collisions among IDs that can coexist: every label in each window, PushID(0..N) in each window, and
+        // "Row" labels under PushID(i) as in a clipped table.
+        std::unordered_map<ImU32, int> seen;
+        size_t labelColl = 0, intColl = 0, rowColl = 0;
+        for (const char* w : windows)
+        {
+            const ImU32 seed = b.str(w, 0, 0);
+            std::unordered_set<ImU32> ids;
+            std::unordered_set<std::string> hashed;
+            for (const std::string& s : labels)
+            {
+                const char* id = s.c_str();
+                const char* triple = strstr(id, "###");
+                std::string key = triple ? std::string(triple) : s;
+                if (!hashed.insert(key).second) continue;
+                if (!ids.insert(b.str(id, 0, seed)).second) ++labelColl;
+            }
+            std::unordered_set<ImU32> intIds;
+            for (int i = 0; i < 1000000; ++i)
+                if (!intIds.insert(b.data(&i, sizeof(i), seed)).second) ++intColl;
+            std::unordered_set<ImU32> rowIds;
+            for (int i = 0; i < 20000; ++i)
+            {
+                const ImU32 rowSeed = b.data(&i, sizeof(i), seed);
+                for (const char* col : { "##name", "##score", "Start", "Edit", "X" })
+                    if (!rowIds.insert(b.str(col, 0, rowSeed)).second) ++rowColl;
+            }
+        }
+        std::printf("%-16s %9.2f %9.2f %9.2f %9.2f %11zu %11zu %11zu\n", b.name, labelNs, intNs, l64, l256, labelColl, intColl, rowColl);
+    }
+    std::printf("\nexpected collisions for n random 32-bit ids ~ n^2/2^33: 1M ids -> ~116, 100k -> ~1.2\n");
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// Load generator for the MatchAdminHotkeys control socket (Linux/POSIX).
+//
+//   g++ -O2 -std=c++17 -I.. mah_loadgen.cpp -o mah_loadgen
+//   ./mah_loadgen [port] [commands] [batch]
+//
+// Streams alternating Blue +1 / Blue -1 opcodes across the whole run (an odd
+// command count is rounded up, so the net score change is zero) and reports
+// throughput and per-send latency. The plugin's received/dropped counters are
+// read before and after the run with Op_QueryStats; any drop means the queue
+// filled up and the Blue score may no longer be back where it started.
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "ControlProtocol.h"
+
+struct ServerCounters
+{
+	uint64_t received = 0;
+	uint64_t dropped = 0;
+	uint64_t invalid = 0;
+};
+
+static bool QueryStats(int s, ServerCounters& out)
+{
+	const uint8_t op = ControlProtocol::Op_QueryStats;
+	if (send(s, &op, 1, 0) != 1) return false;
+	uint8_t reply[ControlProtocol::STATS_REPLY];
+	size_t got = 0;
+	while (got < sizeof(reply))
+	{
+		const ssize_t n = recv(s, reply + got, sizeof(reply) - got, 0);
+		if (n <= 0) return false;
+		got += static_cast<size_t>(n);
+	}
+	std::memcpy(&out.received, reply, 8);
+	std::memcpy(&out.dropped, reply + 8, 8);
+	std::memcpy(&out.invalid, reply + 16, 8);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const int port = argc > 1 ? std::atoi(argv[1]) : ControlProtocol::DEFAULT_PORT;
+	long total = argc > 2 ? std::atol(argv[2]) : 100000;
+	const int batch = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+	total += total & 1;
+
+	int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (s < 0 || connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		std::perror("connect");
+		return 1;
+	}
+	int yes = 1;
+	setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+	ServerCounters before;
+	if (!QueryStats(s, before))
+	{
+		std::printf("stats query failed (plugin older than Op_QueryStats?)\n");
+		return 1;
+	}
+
+	std::vector<uint8_t> buf(batch);
+	std::vector<double> sendUs;
+	sendUs.reserve(total / batch + 1);
+	const auto start = std::chrono::steady_clock::now();
+	long sent = 0;
+	long net = 0;
+	while (sent < total)
+	{
+		const int n = static_cast<int>(std::min<long>(batch, total - sent));
+		// Alternation follows the global command index, not the batch index.
+		for (int i = 0; i < n; ++i)
+		{
+			const bool plus = ((sent + i) & 1) == 0;
+			buf[i] = plus ? ControlProtocol::Op_BluePlus : ControlProtocol::Op_BlueMinus;
+			net += plus ? 1 : -1;
+		}
+		const auto t0 = std::chrono::steady_clock::now();
+		if (send(s, buf.data(), n, 0) != n)
+		{
+			std::perror("send");
+			break;
+		}
+		sendUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+		sent += n;
+	}
+	const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	ServerCounters after;
+	const bool haveAfter = QueryStats(s, after);
+	close(s);
+
+	if (sendUs.empty()) return 1;
+	std::sort(sendUs.begin(), sendUs.end());
+	std::printf("sent %ld commands in %.3fs (%.0f cmd/s), batch %d, net Blue change %+ld\n", sent, secs, sent / secs, batch, net);
+	std::printf("send latency us: p50 %.1f  p99 %.1f  max %.1f\n",
+		sendUs[sendUs.size() / 2], sendUs[sendUs.size() * 99 / 100], sendUs.back());
+	if (!haveAfter)
+	{
+		std::printf("stats query after the run failed\n");
+		return 1;
+	}
+	// Deltas include commands from any other client connected meanwhile.
+	const uint64_t dropped = after.dropped - before.dropped;
+	std::printf("plugin: received %llu, dropped %llu, invalid %llu\n",
+		static_cast<unsigned long long>(after.received - before.received),
+		static_cast<unsigned long long>(dropped),
+		static_cast<unsigned long long>(after.invalid - before.invalid));
+	if (net != 0 || sent != total)
+	{
+		std::printf("FAIL: run incomplete or unbalanced, Blue score changed by %+ld\n", net);
+		return 1;
+	}
+	if (dropped != 0)
+	{
+		std::printf("FAIL: %llu command(s) dropped, Blue score may be off by up to that much\n", static_cast<unsigned long long>(dropped));
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,221 @@
+// Scenario apply latency against a stand-in server (Linux).
+//
+//   g++ -O2 -std=c++17 -pthread -DMAH_STANDALONE -I.. mah_scenario_bench.cpp ../ScenarioEngine.cpp -o mah_scenario_bench
+//   ./mah_scenario_bench [applies] [tick hz]
+//
+// A "game thread" ticks at the given rate and drains a callback queue, the
+// way gameWrapper->Execute does. A second thread requests a preset at random
+// points between ticks. Two paths are timed for the same preset:
+//   compiled  one callback walking the op list from ScenarioBook
+//   strings   one callback per console command, each split and dispatched by
+//             name at apply time, as a mah_reset_cmd chain would be
+// Reported per path: request -> last op applied latency, time spent inside
+// callbacks, and how many applies were observed half-done by a tick reader.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ScenarioEngine.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct FakeServer
+{
+	int score[2] = {};
+	int seconds = 300;
+	bool overtime = false;
+	bool paused = false;
+	int rounds = 0;
+};
+
+struct FakeTarget
+{
+	FakeServer& s;
+	void SetScore(int team, int value) { s.score[team] = value; }
+	void SetClock(int seconds) { s.seconds = seconds; }
+	void SetOvertime(bool on) { s.overtime = on; }
+	void Kickoff() { ++s.rounds; }
+	void SetPaused(bool on) { s.paused = on; }
+};
+
+class GameThread
+{
+public:
+	explicit GameThread(int hz) : period_(std::chrono::nanoseconds(1000000000LL / hz)), thread_([this] { Run(); }) {}
+	~GameThread()
+	{
+		stop_ = true;
+		thread_.join();
+	}
+
+	void Execute(std::function<void()> fn)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		queue_.push_back(std::move(fn));
+	}
+
+	// Called once per tick after the queue is drained.
+	std::function<void()> onTick;
+
+private:
+	void Run()
+	{
+		auto next = Clock::now();
+		while (!stop_)
+		{
+			next += period_;
+			std::this_thread::sleep_until(next);
+			std::deque<std::function<void()>> batch;
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				// Bounded per tick, like a console that runs a few commands per frame.
+				const size_t n = std::min<size_t>(queue_.size(), MAX_PER_TICK);
+				batch.assign(queue_.begin(), queue_.begin() + n);
+				queue_.erase(queue_.begin(), queue_.begin() + n);
+			}
+			for (auto& fn : batch) fn();
+			if (onTick) onTick();
+		}
+	}
+
+	static constexpr size_t MAX_PER_TICK = 2;
+	std::chrono::nanoseconds period_;
+	std::mutex mutex_;
+	std::deque<std::function<void()>> queue_;
+	std::atomic<bool> stop_{ false };
+	std::thread thread_;
+};
+
+static void RunCommand(FakeServer& s, const std::string& line)
+{
+	static const std::unordered_map<std::string, std::function<void(FakeServer&, const std::vector<std::string>&)>> commands = {
+		{ "mah_set_blue", [](FakeServer& s, const std::vector<std::string>& a) { s.score[0] = std::atoi(a.at(1).c_str()); } },
+		{ "mah_set_orange", [](FakeServer& s, const std::vector<std::string>& a) { s.score[1] = std::atoi(a.at(1).c_str()); } },
+		{ "mah_set_clock", [](FakeServer& s, const std::vector<std::string>& a) { s.seconds = std::atoi(a.at(1).c_str()); } },
+		{ "mah_overtime", [](FakeServer& s, const std::vector<std::string>& a) { s.overtime = a.at(1) == "1"; } },
+		{ "mah_kickoff", [](FakeServer& s, const std::vector<std::string>&) { ++s.rounds; } },
+		{ "mah_pause", [](FakeServer& s, const std::vector<std::string>& a) { s.paused = a.at(1) == "1"; } },
+	};
+	std::istringstream in(line);
+	std::vector<std::string> args;
+	for (std::string tok; in >> tok;) args.push_back(tok);
+	auto it = commands.find(args.at(0));
+	if (it != commands.end()) it->second(s, args);
+}
+
+struct Stats
+{
+	std::vector<double> latencyUs;
+	double callbackUs = 0;
+	int torn = 0;
+};
+
+static double Percentile(std::vector<double> v, double p)
+{
+	if (v.empty()) return 0;
+	std::sort(v.begin(), v.end());
+	return v[std::min(v.size() - 1, static_cast<size_t>(p * v.size()))];
+}
+
+static void Report(const char* name, const Stats& st)
+{
+	std::printf("%-9s p50 %8.0fus  p99 %8.0fus  max %8.0fus  in-callback %6.2fus/apply  torn %d\n", name,
+		Percentile(st.latencyUs, 0.5), Percentile(st.latencyUs, 0.99), Percentile(st.latencyUs, 1.0),
+		st.callbackUs / std::max<size_t>(1, st.latencyUs.size()), st.torn);
+}
+
+int main(int argc, char** argv)
+{
+	const int applies = argc > 1 ? std::atoi(argv[1]) : 200;
+	const int hz = argc > 2 ? std::atoi(argv[2]) : 120;
+
+	const std::string preset = "blue 3; orange 2; clock 1:30; overtime; kickoff; pause";
+	const std::vector<std::string> chain = {
+		"mah_set_blue 3", "mah_set_orange 2", "mah_set_clock 90", "mah_overtime 1", "mah_kickoff", "mah_pause 1",
+	};
+	ScenarioBook book;
+	std::string error;
+	if (!book.Define("bench", preset, &error))
+	{
+		std::fprintf(stderr, "preset: %s\n", error.c_str());
+		return 1;
+	}
+	const Scenario& scenario = *book.Find("bench");
+
+	std::mt19937 rng(12345);
+	std::uniform_int_distribution<int> jitterUs(0, 1000000 / hz);
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		const bool compiled = pass == 0;
+		FakeServer server;
+		Stats st;
+		std::mutex m;
+		std::condition_variable cv;
+		bool done = false;
+		Clock::time_point requested;
+
+		GameThread game(hz);
+		// A tick that sees some but not all of the preset would broadcast a torn state.
+		game.onTick = [&] {
+			const bool any = server.score[0] == 3 || server.seconds == 90 || server.paused;
+			const bool all = server.score[0] == 3 && server.score[1] == 2 && server.seconds == 90 && server.overtime && server.paused;
+			if (any && !all) ++st.torn;
+		};
+
+		for (int i = 0; i < applies; ++i)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(jitterUs(rng)));
+			{
+				std::lock_guard<std::mutex> lock(m);
+				done = false;
+			}
+			game.Execute([&] { server = FakeServer{}; });
+			std::this_thread::sleep_for(std::chrono::microseconds(3000000 / hz));
+			requested = Clock::now();
+			auto finish = [&] {
+				std::lock_guard<std::mutex> lock(m);
+				st.latencyUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - requested).count());
+				done = true;
+				cv.notify_one();
+			};
+			if (compiled)
+			{
+				game.Execute([&] {
+					const auto t0 = Clock::now();
+					FakeTarget target{ server };
+					ApplyScenario(scenario, target);
+					st.callbackUs += std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+					finish();
+				});
+			}
+			else
+			{
+				for (size_t c = 0; c < chain.size(); ++c)
+				{
+					game.Execute([&, c] {
+						const auto t0 = Clock::now();
+						RunCommand(server, chain[c]);
+						st.callbackUs += std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+						if (c + 1 == chain.size()) finish();
+					});
+				}
+			}
+			std::unique_lock<std::mutex> lock(m);
+			cv.wait(lock, [&] { return done; });
+		}
+		Report(compiled ? "compiled" : "strings", st);
+	}
+	return 0;
+}
@@ -0,0 +1,325 @@
+// Multi-seat test for sequenced control commands (Linux/POSIX).
+//
+//   g++ -O2 -std=c++17 -pthread -DMAH_STANDALONE -I.. mah_seat_sim.cpp ../ActionSequencer.cpp ../ControlServer.cpp ../LocalSocket.cpp -o mah_seat_sim
+//   ./mah_seat_sim [port] [seats] [commands per seat] [retry %] [final blue set]
+//
+// First checks ActionSequencer verdicts and merge rules on fixed cases:
+// seats with unrelated seq counters, seq 0 from seat 0, keys reused by other
+// seats, per-seat staleness and last-arrival wins within a tick.
+//
+// Then runs a ControlServer on the given port, drained by a "game thread"
+// into an ActionSequencer at 120 Hz, as the plugin does. Every seat opens its
+// own connection and sends Blue +1 / Orange +1 deltas, resending a share of
+// them with the same idempotency key and splitting frames across writes to
+// exercise reassembly. After all seats finish, seat 0 optionally sends an
+// absolute Blue score (twice, same key). The resolved scores and the
+// duplicate/stale counts must match what was sent. Meanwhile another client
+// floods stats queries and never reads the replies, which must not stall the
+// server for the seats.
+#include <arpa/inet.h>
+#include <csignal>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <thread>
+#include <vector>
+#include "ActionSequencer.h"
+#include "ControlServer.h"
+
+using Frame = std::vector<uint8_t>;
+using Verdict = ActionSequencer::Verdict;
+
+static int failures = 0;
+
+static void Expect(bool ok, const char* what)
+{
+	if (ok) return;
+	std::printf("FAIL: %s\n", what);
+	++failures;
+}
+
+static Frame Encode(uint8_t seat, uint32_t seq, uint64_t key, uint8_t kind, uint8_t team, int16_t value)
+{
+	Frame f;
+	f.push_back(ControlProtocol::Op_Sequenced);
+	f.push_back(seat);
+	for (int i = 0; i < 4; ++i) f.push_back(static_cast<uint8_t>(seq >> (8 * i)));
+	for (int i = 0; i < 8; ++i) f.push_back(static_cast<uint8_t>(key >> (8 * i)));
+	f.push_back(kind);
+	f.push_back(team);
+	const uint16_t v = static_cast<uint16_t>(value);
+	f.push_back(static_cast<uint8_t>(v));
+	f.push_back(static_cast<uint8_t>(v >> 8));
+	return f;
+}
+
+static AdminCommand Cmd(uint8_t seat, uint32_t seq, uint64_t key, AdminOpKind kind, uint8_t team = 0, int32_t value = 0)
+{
+	AdminCommand c;
+	c.seat = seat;
+	c.seq = seq;
+	c.key = key;
+	c.kind = kind;
+	c.team = team;
+	c.value = value;
+	return c;
+}
+
+static void CheckRules()
+{
+	using K = AdminOpKind;
+	ActionSequencer sq;
+
+	Expect(sq.Submit(Cmd(0, 0, 1, K::ScoreDelta, 0, 1)) == Verdict::Accepted, "seq 0 from seat 0 accepted");
+	ResolvedActions r = sq.Resolve();
+	Expect(!r.setScore[0] && r.scoreDelta[0] == 1, "seq 0 from seat 0 applied");
+
+	// Seat 1's counter is far ahead of seat 0's; that must not make seat 0 stale.
+	Expect(sq.Submit(Cmd(1, 1000, 2, K::ScoreSet, 0, 5)) == Verdict::Accepted, "set from seat 1");
+	r = sq.Resolve();
+	Expect(r.setScore[0] == 5, "set from seat 1 applied");
+	Expect(sq.Submit(Cmd(0, 1, 3, K::ScoreDelta, 0, 1)) == Verdict::Accepted, "later delta from a seat with a lower seq accepted");
+	r = sq.Resolve();
+	Expect(r.scoreDelta[0] == 1, "later delta from a seat with a lower seq applied");
+
+	// Within a tick the set that arrived last wins, whatever the seqs.
+	Expect(sq.Submit(Cmd(1, 1001, 4, K::ScoreSet, 0, 9)) == Verdict::Accepted, "set from seat 1 (same tick)");
+	Expect(sq.Submit(Cmd(0, 2, 5, K::ScoreSet, 0, 3)) == Verdict::Accepted, "set from seat 0 (same tick)");
+	r = sq.Resolve();
+	Expect(r.setScore[0] == 3, "last arriving set wins");
+
+	// Deltas before the winning set are overwritten, deltas after it add up.
+	sq.Submit(Cmd(3, 1, 6, K::ScoreDelta, 0, 2));
+	sq.Submit(Cmd(4, 1, 7, K::ScoreSet, 0, 7));
+	sq.Submit(Cmd(3, 2, 8, K::ScoreDelta, 0, 1));
+	sq.Submit(Cmd(3, 3, 9, K::ScoreDelta, 1, 4));
+	r = sq.Resolve();
+	Expect(r.setScore[0] == 7 && r.scoreDelta[0] == 1, "delta before the set dropped, delta after it kept");
+	Expect(!r.setScore[1] && r.scoreDelta[1] == 4, "other team unaffected");
+
+	// Keys are per seat.
+	Expect(sq.Submit(Cmd(2, 1, 100, K::ScoreDelta, 1, 1)) == Verdict::Accepted, "key 100 from seat 2");
+	Expect(sq.Submit(Cmd(5, 1, 100, K::ScoreDelta, 1, 1)) == Verdict::Accepted, "same key from seat 5 accepted");
+	Expect(sq.Submit(Cmd(2, 1, 100, K::ScoreDelta, 1, 1)) == Verdict::Duplicate, "retry from seat 2 is a duplicate");
+	r = sq.Resolve();
+	Expect(r.scoreDelta[1] == 2, "both seats' commands applied once");
+
+	// Staleness follows the seat's own seq, per team.
+	Expect(sq.Submit(Cmd(2, 10, 101, K::ScoreSet, 1, 2)) == Verdict::Accepted, "set from seat 2");
+	Expect(sq.Submit(Cmd(2, 9, 102, K::ScoreDelta, 1, 1)) == Verdict::Stale, "older delta from the same seat is stale");
+	Expect(sq.Submit(Cmd(2, 10, 103, K::ScoreSet, 1, 6)) == Verdict::Stale, "same-seq set from the same seat is stale");
+	Expect(sq.Submit(Cmd(2, 9, 104, K::ScoreDelta, 0, 1)) == Verdict::Accepted, "older delta for the other team accepted");
+	Expect(sq.Submit(Cmd(6, 9, 105, K::ScoreDelta, 1, 1)) == Verdict::Accepted, "same seq from another seat accepted");
+	Expect(sq.Submit(Cmd(2, 11, 106, K::ScoreDelta, 1, 1)) == Verdict::Accepted, "newer delta from the same seat accepted");
+	r = sq.Resolve();
+	Expect(r.setScore[1] == 2 && r.scoreDelta[1] == 2 && r.scoreDelta[0] == 1, "stale commands not applied");
+
+	Expect(sq.Submit(Cmd(0, 0, 200, K::ScoreDelta, 2, 1)) == Verdict::Invalid, "team 2 invalid");
+	sq.Submit(Cmd(0, 3, 201, K::PauseToggle));
+	sq.Submit(Cmd(1, 1002, 202, K::PauseToggle));
+	sq.Submit(Cmd(1, 1003, 203, K::ResetKickoff));
+	r = sq.Resolve();
+	Expect(r.pauseToggle && r.resetKickoff && r.scoreDelta[0] == 0, "pause/reset collapse");
+	Expect(sq.Resolve().Empty(), "batch cleared");
+
+	// Key history is bounded per seat.
+	for (uint64_t k = 1; k <= 4097; ++k) sq.Submit(Cmd(7, static_cast<uint32_t>(k), k, K::ScoreDelta, 0, 1));
+	Expect(sq.Submit(Cmd(7, 5000, 4097, K::ScoreDelta, 0, 1)) == Verdict::Duplicate, "recent key remembered");
+	Expect(sq.Submit(Cmd(7, 5001, 1, K::ScoreDelta, 0, 1)) == Verdict::Accepted, "oldest key forgotten");
+	sq.Resolve();
+
+	sq.Reset();
+	Expect(sq.Submit(Cmd(2, 9, 101, K::ScoreDelta, 1, 1)) == Verdict::Accepted, "Reset() forgets keys and sets");
+}
+
+static int Connect(int port)
+{
+	int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (s < 0 || connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		if (s >= 0) close(s);
+		return -1;
+	}
+	int yes = 1;
+	setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+	return s;
+}
+
+static bool SendAll(int s, const uint8_t* data, size_t len)
+{
+	while (len > 0)
+	{
+		const ssize_t n = send(s, data, len, 0);
+		if (n <= 0) return false;
+		data += n;
+		len -= static_cast<size_t>(n);
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const int port = argc > 1 ? std::atoi(argv[1]) : ControlProtocol::DEFAULT_PORT + 100;
+	const int seats = argc > 2 ? std::atoi(argv[2]) : 4;
+	const int perSeat = argc > 3 ? std::atoi(argv[3]) : 50;
+	const int retryPct = argc > 4 ? std::atoi(argv[4]) : 20;
+	const int finalSet = argc > 5 ? std::atoi(argv[5]) : 3;
+	if (seats < 1 || seats > 255 || perSeat < 0)
+	{
+		std::fprintf(stderr, "seats must be 1..255\n");
+		return 1;
+	}
+
+	CheckRules();
+
+	std::signal(SIGPIPE, SIG_IGN);	// Replies to the stalled client below may hit a closed socket
+	ControlServer server;
+	if (!server.Start(static_cast<uint16_t>(port)))
+	{
+		std::printf("cannot listen on %d\n", port);
+		return 2;
+	}
+
+	// Game thread: drain, sequence and apply once per tick.
+	ActionSequencer sequencer;
+	long blueScore = 0, orangeScore = 0, accepted = 0, duplicates = 0, stale = 0, invalid = 0;
+	std::atomic<bool> stop{ false };
+	std::thread game([&]() {
+		auto tick = [&]() {
+			server.Drain([&](const ControlCommand& cmd) {
+				if (cmd.op != ControlProtocol::Op_Sequenced) { ++invalid; return; }
+				AdminCommand ac;
+				ac.seat = cmd.seat;
+				ac.seq = cmd.seq;
+				ac.key = cmd.key;
+				ac.team = cmd.team;
+				ac.value = cmd.value;
+				ac.kind = cmd.kind == ControlProtocol::Seq_ScoreSet ? AdminOpKind::ScoreSet : AdminOpKind::ScoreDelta;
+				switch (sequencer.Submit(ac))
+				{
+				case Verdict::Accepted: ++accepted; break;
+				case Verdict::Duplicate: ++duplicates; break;
+				case Verdict::Stale: ++stale; break;
+				case Verdict::Invalid: ++invalid; break;
+				}
+			});
+			const ResolvedActions r = sequencer.Resolve();
+			if (r.setScore[0]) blueScore = *r.setScore[0];
+			if (r.setScore[1]) orangeScore = *r.setScore[1];
+			blueScore += r.scoreDelta[0];
+			orangeScore += r.scoreDelta[1];
+		};
+		while (!stop.load())
+		{
+			tick();
+			std::this_thread::sleep_for(std::chrono::microseconds(1000000 / 120));
+		}
+		tick();
+	});
+
+	// Stalled client: 1M stats queries whose replies it never reads. Its own sends give up once the server stops reading.
+	const int stalled = Connect(port);
+	if (stalled < 0) { std::perror("connect"); return 1; }
+	{
+		timeval tv{ 1, 0 };
+		setsockopt(stalled, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+		const std::vector<uint8_t> queries(1 << 20, ControlProtocol::Op_QueryStats);
+		SendAll(stalled, queries.data(), queries.size());
+		std::this_thread::sleep_for(std::chrono::milliseconds(300));	// Long enough to fill its receive buffer with replies
+	}
+
+	// Fresh keys and a wall-clock seq base, as a real controller would use.
+	const uint64_t keyBase = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+	const uint32_t seqBase = static_cast<uint32_t>(std::time(nullptr));
+
+	std::vector<long> blue(seats, 0), orange(seats, 0), retries(seats, 0);
+	std::vector<bool> ok(seats, true);
+	std::vector<std::thread> threads;
+	for (int seat = 0; seat < seats; ++seat)
+	{
+		threads.emplace_back([&, seat]()
+		{
+			const int s = Connect(port);
+			if (s < 0) { ok[seat] = false; return; }
+			std::mt19937 rng(static_cast<unsigned>(seat) * 7919u + 1u);
+			for (uint32_t i = 1; i <= static_cast<uint32_t>(perSeat); ++i)
+			{
+				const uint8_t team = static_cast<uint8_t>(rng() & 1);
+				// Seats count from unrelated bases, as independent controllers would.
+				const uint32_t seq = seqBase * static_cast<uint32_t>(seat) + i;
+				const uint64_t key = keyBase + static_cast<uint64_t>(seat) * (perSeat + 1) + i;
+				const Frame f = Encode(static_cast<uint8_t>(seat), seq, key, ControlProtocol::Seq_ScoreDelta, team, 1);
+				const int sends = static_cast<int>(rng() % 100) < retryPct ? 2 : 1;
+				for (int n = 0; n < sends; ++n)
+				{
+					// Split the frame at a random point so the server sees partial reads.
+					const size_t cut = rng() % f.size();
+					if (!SendAll(s, f.data(), cut) || !SendAll(s, f.data() + cut, f.size() - cut)) { ok[seat] = false; break; }
+					if (cut > 0) usleep(200);
+				}
+				(team == 0 ? blue : orange)[seat] += 1;
+				retries[seat] += sends - 1;
+			}
+			close(s);
+		});
+	}
+	for (auto& t : threads) t.join();
+
+	long blueDelta = 0, orangeDelta = 0, totalRetries = 0;
+	for (int seat = 0; seat < seats; ++seat)
+	{
+		if (!ok[seat])
+		{
+			std::fprintf(stderr, "seat %d: connection failed\n", seat);
+			return 1;
+		}
+		blueDelta += blue[seat];
+		orangeDelta += orange[seat];
+		totalRetries += retries[seat];
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	if (finalSet >= 0)
+	{
+		// Seat 0's own seq is the lowest of all seats here; it must still win by arriving last.
+		const int s = Connect(port);
+		if (s < 0) { std::perror("connect"); return 1; }
+		const uint32_t seq = static_cast<uint32_t>(perSeat) + 1;
+		const Frame f = Encode(0, seq, keyBase - 1, ControlProtocol::Seq_ScoreSet, 0, static_cast<int16_t>(finalSet));
+		SendAll(s, f.data(), f.size());
+		SendAll(s, f.data(), f.size());
+		close(s);
+		totalRetries += 1;
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	close(stalled);
+	stop = true;
+	game.join();
+	server.Stop();
+
+	const long expectBlue = finalSet >= 0 ? finalSet : blueDelta;
+	const long commands = static_cast<long>(seats) * perSeat + (finalSet >= 0 ? 1 : 0);
+	std::printf("seats=%d commands=%ld retries=%ld\n", seats, commands, totalRetries);
+	std::printf("blue %ld (expected %ld), orange %ld (expected %ld)\n", blueScore, expectBlue, orangeScore, orangeDelta);
+	std::printf("accepted %ld, duplicates %ld, stale %ld, invalid %ld\n", accepted, duplicates, stale, invalid);
+	Expect(blueScore == expectBlue, "blue score");
+	Expect(orangeScore == orangeDelta, "orange score");
+	Expect(accepted == commands, "every command accepted once");
+	Expect(duplicates == totalRetries, "every retry reported as duplicate");
+	Expect(stale == 0 && invalid == 0, "no stale or invalid commands");
+
+	std::printf(failures == 0 ? "ok\n" : "%d failure(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// SeriesTracker test without the game (Linux).
+//
+//   g++ -O2 -std=c++20 -I. -Isdk_standin -I.. mah_series_test.cpp ../SeriesTracker.cpp -o mah_series_test
+//   ./mah_series_test [dir]
+//
+// Works on a fresh series.log in 'dir' (default: a directory under /tmp):
+//   names     TeamName() defaults and MAX_TEAM_NAME cuts, on UTF-8 boundaries.
+//   resume    a series started with a 40-byte name, with a name cut inside a
+//             multi-byte character and with empty names is found again by
+//             FindByTeams() with the names it was started with, both before
+//             and after the log is closed and reopened, and Resume() picks it
+//             back up with its games intact.
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include "SeriesTracker.h"
+#include "bakkesmod/wrappers/cvarmanagerwrapper.h"
+
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager = std::make_shared<CVarManagerWrapper>();
+
+static int failures = 0;
+
+static void Check(bool ok, const char* what, const std::string& detail = "")
+{
+	if (ok) return;
+	std::printf("FAIL: %s%s%s\n", what, detail.empty() ? "" : ": ", detail.c_str());
+	++failures;
+}
+
+static void CheckNames()
+{
+	const std::string long40(40, 'x');
+	Check(SeriesTracker::TeamName("", "Blue") == "Blue", "empty name gets the default");
+	Check(SeriesTracker::TeamName("NRG", "Blue") == "NRG", "short name kept");
+	Check(SeriesTracker::TeamName(long40, "Blue") == std::string(SeriesTracker::MAX_TEAM_NAME, 'x'), "long name cut to MAX_TEAM_NAME");
+	// 31 ASCII bytes then a 2-byte character straddling the limit.
+	const std::string split = std::string(31, 'a') + "\xC3\xA9" + "b";
+	Check(SeriesTracker::TeamName(split, "Blue") == std::string(31, 'a'), "cut inside a 2-byte character", SeriesTracker::TeamName(split, "Blue"));
+	// 30 ASCII bytes then a 3-byte character ending exactly at the limit.
+	const std::string fits = std::string(29, 'a') + "\xE2\x82\xAC" + "b";
+	Check(SeriesTracker::TeamName(fits, "Blue") == std::string(29, 'a') + "\xE2\x82\xAC", "character ending at the limit kept");
+	// A name that is only a partial character falls back to the default.
+	Check(SeriesTracker::TeamName("\xF0\x9F", "Orange") == "Orange", "lone partial character");
+}
+
+static void CheckResume(const std::filesystem::path& file)
+{
+	struct Case
+	{
+		const char* what;
+		std::string a, b;
+	};
+	const Case cases[] = {
+		{ "40-byte name", std::string("Team Liquid Academy Rocket League Squad!"), std::string("G2") },
+		{ "name cut inside a character", std::string(31, 'a') + "\xC3\xA9" + "quipe", std::string("Orange side") },
+		{ "empty names", std::string(), std::string() },
+	};
+	Check(cases[0].a.size() == 40, "fixture");
+
+	SeriesTracker t;
+	Check(t.Open(file), "open", file.string());
+	uint32_t ids[3] = {};
+	for (int i = 0; i < 3; ++i)
+	{
+		const std::string& a = cases[i].a;
+		ids[i] = t.Start(5, a, cases[i].b);
+		Check(ids[i] != 0, "start", cases[i].what);
+		Check(t.RecordGame(3, 1, false, 1000 + i), "record game", cases[i].what);
+		const SeriesInfo* s = t.FindByTeams(a, cases[i].b);
+		Check(s && s->id == ids[i], "found before reopen", cases[i].what);
+	}
+	Check(t.Active() && t.Active()->id == ids[2], "last started series is active");
+	t.Close();
+
+	SeriesTracker r;
+	Check(r.Open(file), "reopen", file.string());
+	Check(r.SeriesCount() == 3, "series count after reopen", std::to_string(r.SeriesCount()));
+	for (int i = 0; i < 3; ++i)
+	{
+		const std::string& a = cases[i].a;
+		const SeriesInfo* s = r.FindByTeams(a, cases[i].b);
+		Check(s && s->id == ids[i], "found after reopen", cases[i].what);
+		if (!s) continue;
+		Check(r.Resume(s->id), "resume", cases[i].what);
+		Check(r.Active() && r.Active()->id == ids[i], "resumed series is active", cases[i].what);
+		Check(s->GamesPlayed() == 1 && s->winsA == 1, "games kept", cases[i].what);
+		const std::vector<SeriesGame> games = r.LoadGames(s->id);
+		Check(games.size() == 1 && games[0].scoreA == 3 && games[0].scoreB == 1 && games[0].finishedAt == 1000 + i, "game scores kept", cases[i].what);
+	}
+	const SeriesInfo* empty = r.FindByTeams("Blue", "Orange");
+	Check(empty && empty->id == ids[2], "empty names stored as Blue/Orange");
+}
+
+int main(int argc, char** argv)
+{
+	const std::filesystem::path dir = argc > 1 ? std::filesystem::path(argv[1])
+		: std::filesystem::temp_directory_path() / ("mah_series_test." + std::to_string(getpid()));
+	const std::filesystem::path file = dir / "series.log";
+	std::error_code ec;
+	std::filesystem::remove(file, ec);
+
+	CheckNames();
+	CheckResume(file);
+
+	if (argc <= 1) std::filesystem::remove_all(dir, ec);
+	std::printf(failures == 0 ? "ok\n" : "%d failure(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
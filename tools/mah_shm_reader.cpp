@@ -0,0 +1,195 @@
+// Reader, stand-in writer and seqlock stress test for the MatchAdminHotkeys
+// shared-memory scoreboard (Linux/POSIX).
+//
+//   g++ -O2 -std=c++17 -pthread -DMAH_STANDALONE -I.. mah_shm_reader.cpp ../ScoreboardExport.cpp -o mah_shm_reader -lrt
+//   ./mah_shm_reader                         poll "/mah_scoreboard"
+//   ./mah_shm_reader writer [secs]           publish a simulated match there
+//   ./mah_shm_reader stress [readers] [secs] writer + readers on a private segment
+//
+// The plugin runs on Windows and exports "Local\MatchAdminHotkeys.Scoreboard",
+// which a Linux process cannot open. The watch mode reads the POSIX name
+// that ScoreboardExport uses off Windows, so on Linux it needs the writer
+// mode running alongside: it drives the plugin's own ScoreboardExport with
+// a scripted match (goals, clock, pauses, overtime) until stopped.
+//
+// The stress mode writes values that satisfy a fixed relation and counts any
+// read that returns a combination the writer never produced (torn reads).
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+#include "ScoreboardExport.h"
+#include "ScoreboardShm.h"
+
+using namespace ScoreboardShm;
+
+static Block* Map(const char* name, bool create)
+{
+	int fd = shm_open(name, create ? (O_CREAT | O_RDWR) : O_RDONLY, 0644);
+	if (fd < 0) return nullptr;
+	if (create && ftruncate(fd, sizeof(Block)) != 0) return nullptr;
+	void* mem = mmap(nullptr, sizeof(Block), create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	return mem == MAP_FAILED ? nullptr : static_cast<Block*>(mem);
+}
+
+static int Watch()
+{
+	Block* b = Map("/mah_scoreboard", false);
+	if (!b || b->magic != MAGIC)
+	{
+		std::fprintf(stderr, "scoreboard export not found (run '%s writer' first; see the header comment)\n", "mah_shm_reader");
+		return 1;
+	}
+	std::setvbuf(stdout, nullptr, _IOLBF, 0);	// Usually piped or tailed
+	Values v;
+	uint64_t lastCounter = ~0ull, reads = 0, retries = 0;
+	auto lastReport = std::chrono::steady_clock::now();
+	for (;;)
+	{
+		if (!TryRead(*b, v)) { ++retries; continue; }
+		++reads;
+		if (v.actionCounter != lastCounter)
+		{
+			lastCounter = v.actionCounter;
+			std::printf("#%llu  %d-%d  %d:%02d%s%s\n", static_cast<unsigned long long>(v.actionCounter), v.blue, v.orange,
+				v.secondsRemaining / 60, v.secondsRemaining % 60,
+				(v.flags & Flag_Overtime) ? " OT" : "", (v.flags & Flag_Paused) ? " PAUSED" : "");
+		}
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastReport > std::chrono::seconds(5))
+		{
+			std::printf("  %.1fM reads/s, %llu retries\n", reads / 5e6, static_cast<unsigned long long>(retries));
+			reads = retries = 0;
+			lastReport = now;
+		}
+	}
+}
+
+static std::atomic<bool> interrupted{ false };
+
+// Stand-in for the plugin on POSIX: the same ScoreboardExport, fed a scripted
+// match at 10 updates per second. Removes the segment on exit or Ctrl-C.
+static int Writer(int secs)
+{
+	ScoreboardExport shm;
+	if (!shm.Open()) { std::perror("shm"); return 1; }
+	std::signal(SIGINT, [](int) { interrupted = true; });
+	std::signal(SIGTERM, [](int) { interrupted = true; });
+	std::printf("writing /mah_scoreboard%s\n", secs > 0 ? "" : " until interrupted");
+
+	Values v;
+	v.flags = Flag_InGame;
+	v.secondsRemaining = 300;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t tick = 1; !interrupted.load(); ++tick)
+	{
+		const auto now = std::chrono::steady_clock::now();
+		if (secs > 0 && now - start >= std::chrono::seconds(secs)) break;
+		// One match second per tick; a goal every 37 s, a 5 s pause every 60 s.
+		if (tick % 37 == 0)
+		{
+			(tick % 2 ? v.blue : v.orange) += 1;
+			++v.actionCounter;
+		}
+		if (tick % 60 == 0 || (tick % 60 == 5 && (v.flags & Flag_Paused)))
+		{
+			v.flags ^= Flag_Paused;
+			++v.actionCounter;
+		}
+		if (!(v.flags & Flag_Paused))
+		{
+			if (v.secondsRemaining > 0) --v.secondsRemaining;
+			else if (!(v.flags & Flag_Overtime)) v.flags |= Flag_Overtime;
+		}
+		if ((v.flags & Flag_Overtime) && v.blue != v.orange)
+		{
+			v = Values{};
+			v.flags = Flag_InGame;
+			v.secondsRemaining = 300;
+		}
+		v.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+		shm.Write(v);
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	shm.Close();
+	return 0;
+}
+
+static int Stress(int readers, int secs)
+{
+	const char* name = "/mah_scoreboard_stress";
+	Block* b = Map(name, true);
+	if (!b) { std::perror("shm"); return 1; }
+	new (b) Block{};
+
+	std::atomic<bool> stop{ false };
+	std::atomic<uint64_t> reads{ 0 }, retries{ 0 }, torn{ 0 }, writes{ 0 };
+
+	std::thread writer([&]() {
+		Values v;
+		uint64_t i = 0;
+		while (!stop.load(std::memory_order_relaxed))
+		{
+			++i;
+			v.actionCounter = i;
+			v.blue = static_cast<int32_t>(i);
+			v.orange = static_cast<int32_t>(i * 3);
+			v.secondsRemaining = static_cast<int32_t>(i % 300);
+			v.flags = static_cast<uint32_t>(i & 7);
+			v.timestampNs = i * 7;
+			Write(*b, v);
+		}
+		writes = i;
+	});
+
+	std::vector<std::thread> pool;
+	for (int r = 0; r < readers; ++r)
+	{
+		pool.emplace_back([&]() {
+			Values v;
+			uint64_t localReads = 0, localRetries = 0, localTorn = 0;
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				if (!TryRead(*b, v)) { ++localRetries; continue; }
+				++localReads;
+				const uint64_t i = v.actionCounter;
+				if (v.blue != static_cast<int32_t>(i) || v.orange != static_cast<int32_t>(i * 3)
+					|| v.secondsRemaining != static_cast<int32_t>(i % 300) || v.flags != (i & 7) || v.timestampNs != i * 7)
+					++localTorn;
+			}
+			reads += localReads;
+			retries += localRetries;
+			torn += localTorn;
+		});
+	}
+
+	std::this_thread::sleep_for(std::chrono::seconds(secs));
+	stop = true;
+	writer.join();
+	for (auto& t : pool) t.join();
+	munmap(b, sizeof(Block));
+	shm_unlink(name);
+
+	std::printf("%d readers, %ds: %.1fM writes/s, %.1fM reads/s, %.2f%% retried, %llu torn\n", readers, secs,
+		writes / 1e6 / secs, reads / 1e6 / secs, 100.0 * retries / (reads + retries + 1),
+		static_cast<unsigned long long>(torn.load()));
+	return torn == 0 ? 0 : 2;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && std::strcmp(argv[1], "stress") == 0)
+		return Stress(argc > 2 ? std::atoi(argv[2]) : 4, argc > 3 ? std::atoi(argv[3]) : 3);
+	if (argc > 1 && std::strcmp(argv[1], "writer") == 0)
+		return Writer(argc > 2 ? std::atoi(argv[2]) : 0);
+	return Watch();
+}
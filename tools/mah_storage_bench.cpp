@@ -0,0 +1,85 @@
+// ImGuiStorage insert/lookup benchmark (Linux). Build once per backend:
+//
+//   SRC="../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   g++ -O2 -std=c++17 -I. -I../IMGUI mah_storage_bench.cpp $SRC -o mah_storage_sorted
+//   g++ -O2 -std=c++17 -I. -I../IMGUI -DIMGUI_STORAGE_OPEN_ADDRESSING mah_storage_bench.cpp $SRC -o mah_storage_hash
+//   ./mah_storage_sorted && ./mah_storage_hash
+//
+// Keys are ImHashStr IDs of "item N" under a window seed, like widget state.
+// Per size: inserting every key one by one through SetInt (the path that is
+// O(n) per new key when sorted), bulk filling Data then BuildSortByKey,
+// lookups that hit and lookups that miss. Also checks that both paths give
+// the same values and that BuildSortByKey leaves Data sorted.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "imgui.h"
+#include "imgui_internal.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double Ms(Clock::time_point t0) { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+static int Run(int n)
+{
+    std::vector<ImGuiID> keys(n), misses(n);
+    const ImGuiID seed = ImHashStr("Match Admin Scoreboard");
+    char buf[32];
+    for (int i = 0; i < n; ++i)
+    {
+        snprintf(buf, sizeof(buf), "item %d", i);
+        keys[i] = ImHashStr(buf, 0, seed);
+        snprintf(buf, sizeof(buf), "absent %d", i);
+        misses[i] = ImHashStr(buf, 0, seed);
+    }
+    std::vector<ImGuiID> order = keys;
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+
+    ImGuiStorage incremental;
+    auto t0 = Clock::now();
+    for (int i = 0; i < n; ++i) incremental.SetInt(keys[i], i);
+    const double insertMs = Ms(t0);
+
+    ImGuiStorage bulk;
+    t0 = Clock::now();
+    for (int i = 0; i < n; ++i) bulk.Data.push_back(ImGuiStorage::ImGuiStoragePair(keys[i], i));
+    bulk.BuildSortByKey();
+    bulk.GetInt(keys[0]); // The hash index is built lazily on first use
+    const double bulkMs = Ms(t0);
+
+    const int rounds = std::max(1, 2000000 / n);
+    long long sum = 0;
+    t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (ImGuiID k : order) sum += incremental.GetInt(k, -1);
+    const double hitNs = Ms(t0) * 1e6 / ((double)rounds * n);
+    t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (ImGuiID k : misses) sum += incremental.GetInt(k, -1);
+    const double missNs = Ms(t0) * 1e6 / ((double)rounds * n);
+
+    int errors = 0;
+    for (int i = 0; i < n; ++i)
+        if (incremental.GetInt(keys[i], -1) != i || bulk.GetInt(keys[i], -1) != i) ++errors;
+    for (int i = 1; i < bulk.Data.Size; ++i)
+        if (bulk.Data[i - 1].key > bulk.Data[i].key) ++errors;
+
+    std::printf("%7d keys  SetInt x n %9.2f ms  bulk+sort %7.2f ms  hit %6.2f ns  miss %6.2f ns  errors %d  (%lld)\n",
+        n, insertMs, bulkMs, hitNs, missNs, errors, sum & 1);
+    return errors;
+}
+
+int main()
+{
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    std::printf("ImGuiStorage: open addressing\n");
+#else
+    std::printf("ImGuiStorage: sorted array\n");
+#endif
+    int errors = 0;
+    for (int n : { 1000, 10000, 100000 })
+        errors += Run(n);
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+// StateStream test without the game (Linux).
+//
+//   g++ -O2 -std=c++17 -pthread -DMAH_STANDALONE -I.. mah_stream_test.cpp ../StateStream.cpp ../LocalSocket.cpp -o mah_stream_test
+//   ./mah_stream_test [port] [snapshots]
+//
+// Plays the game thread against the real StateStream:
+//   overrun  a subscriber with a small receive buffer stops reading while
+//            snapshots with long action texts are published, so the IO thread
+//            gets stuck mid-frame and the ring overtakes it. Once it reads
+//            again, every byte must parse as whole frames, the stream must
+//            resume with a keyframe, and the last state must match the last
+//            snapshot published.
+//   idle     with nothing published the IO thread must stay asleep (CPU time),
+//            and a single snapshot must still arrive promptly.
+// A second subscriber that keeps reading checks that each frame it gets
+// decodes to a state that was actually published.
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StateStream.h"
+
+using namespace StreamProtocol;
+using Clock = std::chrono::steady_clock;
+
+static int failures = 0;
+
+static void Fail(const char* what, long detail)
+{
+	std::printf("FAIL: %s (%ld)\n", what, detail);
+	++failures;
+}
+
+static int Connect(int port, int rcvbuf)
+{
+	int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (rcvbuf > 0) setsockopt(s, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (s < 0 || connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		std::perror("connect");
+		std::exit(2);
+	}
+	return s;
+}
+
+// Decodes a subscriber's byte stream the way a client would, validating each frame.
+struct Decoder
+{
+	std::vector<uint8_t> buf;
+	StreamSnapshot state;
+	long frames = 0;
+	long keyframes = 0;
+	bool haveKey = false;
+	bool broken = false;
+
+	template <typename T>
+	static const uint8_t* Get(const uint8_t* p, T& v)
+	{
+		std::memcpy(&v, p, sizeof(v));
+		return p + sizeof(v);
+	}
+
+	void Feed(const uint8_t* data, size_t n)
+	{
+		buf.insert(buf.end(), data, data + n);
+		size_t off = 0;
+		while (!broken && buf.size() - off >= 2)
+		{
+			uint16_t len;
+			Get(buf.data() + off, len);
+			if (len < 1 + 8 || len > MAX_FRAME - 2) { broken = true; break; }
+			if (buf.size() - off < 2u + len) break;
+			const uint8_t* p = buf.data() + off + 2;
+			const uint8_t* end = p + len;
+			uint8_t mask;
+			p = Get(p, mask);
+			p = Get(p, state.timestampNs);
+			if ((mask & ~(Field_All | Field_Keyframe)) || ((mask & Field_Keyframe) && (mask & Field_All) != Field_All))
+			{
+				broken = true;
+				break;
+			}
+			if (mask & Field_Blue) p = Get(p, state.blue);
+			if (mask & Field_Orange) p = Get(p, state.orange);
+			if (mask & Field_Clock) p = Get(p, state.secondsRemaining);
+			if (mask & Field_Flags) p = Get(p, state.flags);
+			if (mask & Field_Action)
+			{
+				p = Get(p, state.actionSerial);
+				p = Get(p, state.actionLen);
+				if (state.actionLen > MAX_ACTION_TEXT) { broken = true; break; }
+				std::memcpy(state.action, p, state.actionLen);
+				p += state.actionLen;
+			}
+			if (p != end || (!haveKey && !(mask & Field_Keyframe))) { broken = true; break; }
+			haveKey = true;
+			keyframes += (mask & Field_Keyframe) ? 1 : 0;
+			++frames;
+			off += 2u + len;
+		}
+		buf.erase(buf.begin(), buf.begin() + off);
+	}
+
+	// Reads until nothing arrives for quietMs.
+	void Drain(int s, int quietMs)
+	{
+		uint8_t chunk[4096];
+		for (;;)
+		{
+			timeval tv{ 0, quietMs * 1000 };
+			setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+			const ssize_t n = recv(s, chunk, sizeof(chunk), 0);
+			if (n <= 0) return;
+			Feed(chunk, static_cast<size_t>(n));
+		}
+	}
+};
+
+// Every field is derived from i, so a decoded state can be checked against it.
+static StreamSnapshot Make(uint32_t i)
+{
+	StreamSnapshot s;
+	s.blue = static_cast<int16_t>(i % 97);
+	s.orange = static_cast<int16_t>(i % 89);
+	s.secondsRemaining = static_cast<int16_t>(i % 300);
+	s.flags = Flag_InGame | ((i & 1) ? Flag_Paused : 0);
+	s.actionSerial = i;
+	const std::string text = "action " + std::to_string(i) + std::string(MAX_ACTION_TEXT, '.');
+	s.actionLen = static_cast<uint8_t>(MAX_ACTION_TEXT - i % 7);
+	std::memcpy(s.action, text.data(), s.actionLen);
+	s.timestampNs = 1 + i;
+	return s;
+}
+
+static bool Matches(const StreamSnapshot& s)
+{
+	const StreamSnapshot e = Make(s.actionSerial);
+	return s.blue == e.blue && s.orange == e.orange && s.secondsRemaining == e.secondsRemaining && s.flags == e.flags
+		&& s.actionLen == e.actionLen && std::memcmp(s.action, e.action, s.actionLen) == 0;
+}
+
+static double ThreadCpuMs()
+{
+	timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+	const int port = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PORT + 100;
+	const uint32_t count = argc > 2 ? static_cast<uint32_t>(std::atol(argv[2])) : 200000;
+
+	StateStream stream;
+	if (!stream.Start(static_cast<uint16_t>(port)))
+	{
+		std::printf("cannot listen on %d\n", port);
+		return 2;
+	}
+	uint32_t serial = 1;
+	stream.Publish(Make(serial));
+
+	const int slow = Connect(port, 4096);
+	const int fast = Connect(port, 0);
+	Decoder slowDec, fastDec;
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	// overrun: the fast subscriber reads on another thread, the slow one not at all.
+	long fastMismatches = 0;
+	std::thread reader([&]() {
+		uint8_t chunk[4096];
+		timeval tv{ 0, 300 * 1000 };
+		setsockopt(fast, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		for (;;)
+		{
+			const ssize_t n = recv(fast, chunk, sizeof(chunk), 0);
+			if (n <= 0) return;
+			const long before = fastDec.frames;
+			fastDec.Feed(chunk, static_cast<size_t>(n));
+			if (fastDec.frames != before && !Matches(fastDec.state)) ++fastMismatches;
+			if (fastDec.broken) return;
+		}
+	});
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		stream.Publish(Make(++serial));
+		if ((i & 127) == 127) std::this_thread::sleep_for(std::chrono::microseconds(200));	// Stay within the 256-entry queue
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	const StreamSnapshot last = Make(++serial);
+	stream.Publish(last);
+	slowDec.Drain(slow, 300);
+	reader.join();
+
+	const StreamStats st = stream.Stats();
+	std::printf("overrun: %u published (%llu dropped by the queue), %llu resync(s)\n", count + 2,
+		static_cast<unsigned long long>(st.dropped), static_cast<unsigned long long>(st.resyncs));
+	std::printf("  slow subscriber  %ld frames, %ld keyframes\n", slowDec.frames, slowDec.keyframes);
+	std::printf("  fast subscriber  %ld frames, %ld keyframes\n", fastDec.frames, fastDec.keyframes);
+	if (st.resyncs == 0) Fail("slow subscriber was never overrun", 0);
+	if (slowDec.broken) Fail("slow subscriber: stream lost its framing", slowDec.frames);
+	if (fastDec.broken) Fail("fast subscriber: stream lost its framing", fastDec.frames);
+	if (slowDec.keyframes < 2) Fail("slow subscriber: no keyframe after the overrun", slowDec.keyframes);
+	if (fastMismatches) Fail("fast subscriber: decoded states that were never published", fastMismatches);
+	if (!Matches(slowDec.state) || slowDec.state.actionSerial != last.actionSerial)
+		Fail("slow subscriber: final state differs from the last snapshot", static_cast<long>(slowDec.state.actionSerial));
+	if (!Matches(fastDec.state) || fastDec.state.actionSerial != last.actionSerial)
+		Fail("fast subscriber: final state differs from the last snapshot", static_cast<long>(fastDec.state.actionSerial));
+
+	// idle: nothing published for 500 ms, then one snapshot.
+	const double cpu0 = ThreadCpuMs();
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+	const double idleCpu = ThreadCpuMs() - cpu0;
+	const auto t0 = Clock::now();
+	stream.Publish(Make(++serial));
+	uint8_t chunk[256];
+	const ssize_t n = recv(fast, chunk, sizeof(chunk), 0);
+	const double wakeUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+	std::printf("idle: %.2f ms CPU over 500 ms, publish -> receive %.1f us\n", idleCpu, wakeUs);
+	if (idleCpu > 2.0) Fail("IO thread busy while idle (ms CPU)", static_cast<long>(idleCpu));
+	if (n <= 0) Fail("snapshot after idle never arrived", static_cast<long>(n));
+
+	close(slow);
+	close(fast);
+	stream.Stop();
+	std::printf(failures == 0 ? "ok\n" : "%d failure(s)\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// Subscriber for the MatchAdminHotkeys state stream (Linux/POSIX).
+//
+//   g++ -O2 -std=c++17 -I.. mah_stream_watch.cpp -o mah_stream_watch
+//   ./mah_stream_watch [port] [frames]
+//
+// Prints every decoded update and, after the given number of frames (or
+// when the plugin disconnects), the end-to-end latency from the game-thread
+// timestamp in each frame to its arrival here. Both ends read the same
+// monotonic clock, so this only works on the machine running the game.
+// Without the game, mah_stream_test.cpp exercises the same stream.
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ControlProtocol.h"
+
+using namespace StreamProtocol;
+
+template <typename T>
+static const uint8_t* Get(const uint8_t* p, T& v)
+{
+	std::memcpy(&v, p, sizeof(v));
+	return p + sizeof(v);
+}
+
+int main(int argc, char** argv)
+{
+	const int port = argc > 1 ? std::atoi(argv[1]) : DEFAULT_PORT;
+	const long limit = argc > 2 ? std::atol(argv[2]) : 0;
+
+	int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(static_cast<uint16_t>(port));
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (s < 0 || connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		std::perror("connect");
+		return 1;
+	}
+
+	int16_t blue = 0, orange = 0, secs = 0;
+	uint8_t flags = 0;
+	uint32_t serial = 0;
+	std::string action;
+	std::vector<double> latencyUs;
+	std::vector<uint8_t> buf;
+	uint8_t chunk[4096];
+
+	while (limit == 0 || static_cast<long>(latencyUs.size()) < limit)
+	{
+		const ssize_t n = recv(s, chunk, sizeof(chunk), 0);
+		if (n <= 0) break;
+		const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+		buf.insert(buf.end(), chunk, chunk + n);
+
+		size_t off = 0;
+		while (buf.size() - off >= 2)
+		{
+			uint16_t len;
+			Get(buf.data() + off, len);
+			if (buf.size() - off < 2u + len) break;
+			const uint8_t* p = buf.data() + off + 2;
+			uint8_t mask;
+			uint64_t ts;
+			p = Get(p, mask);
+			p = Get(p, ts);
+			if (mask & Field_Blue) p = Get(p, blue);
+			if (mask & Field_Orange) p = Get(p, orange);
+			if (mask & Field_Clock) p = Get(p, secs);
+			if (mask & Field_Flags) p = Get(p, flags);
+			if (mask & Field_Action)
+			{
+				uint8_t alen;
+				p = Get(p, serial);
+				p = Get(p, alen);
+				action.assign(reinterpret_cast<const char*>(p), alen);
+			}
+			off += 2u + len;
+
+			const double us = (now - ts) / 1000.0;
+			latencyUs.push_back(us);
+			std::printf("%s%d-%d  %d:%02d%s%s  #%u %s  (%.1fus)\n", (mask & Field_Keyframe) ? "[key] " : "",
+				blue, orange, secs / 60, secs % 60, (flags & Flag_Overtime) ? " OT" : "",
+				(flags & Flag_Paused) ? " PAUSED" : "", serial, action.c_str(), us);
+		}
+		buf.erase(buf.begin(), buf.begin() + off);
+	}
+	close(s);
+
+	if (latencyUs.empty()) return 0;
+	std::sort(latencyUs.begin(), latencyUs.end());
+	std::printf("%zu frames, latency us: p50 %.1f  p99 %.1f  max %.1f\n", latencyUs.size(),
+		latencyUs[latencyUs.size() / 2], latencyUs[latencyUs.size() * 99 / 100], latencyUs.back());
+	return 0;
+}
@@ -0,0 +1,340 @@
+// Headless frame benchmark for the plugin's ImGui code (Linux), usable as a
+// regression gate.
+//
+//   SRC="$(ls ../*.cpp | grep -v pch.cpp) ../IMGUI/imgui.cpp ../IMGUI/imgui_draw.cpp ../IMGUI/imgui_widgets.cpp"
+//   EXT="../IMGUI/imgui_stdlib.cpp ../IMGUI/imgui_searchablecombo.cpp ../IMGUI/imgui_rangeslider.cpp"
+//   g++ -O2 -std=c++20 -I. -Isdk_standin -I.. -I../IMGUI mah_ui_bench.cpp $SRC $EXT ../IMGUI/imguivariouscontrols.cpp -o mah_ui_bench
+//   ./mah_ui_bench [--frames N] [--warmup N] [--rows N] [--baseline FILE [--update]] [--time-tolerance PCT]
+//
+// Builds with GCC 12 and later: without <format> in the standard library,
+// logging.h falls back to sdk_standin/format_fallback.h.
+// The plugin is built unmodified against sdk_standin/, a small in-process
+// stand-in for the BakkesMod SDK with working cvars and no game. Each frame
+// draws the settings page (RenderSettings, with the schedule and scenario
+// panels open over a generated schedule), the scoreboard overlay window and
+// a window of the vendored custom widgets, with a null renderer: the frame
+// ends at ImGui::Render(). Reported per frame after warm-up: thread CPU time
+// from NewFrame to Render, vertex and index counts, ImGui allocations (through
+// SetAllocatorFunctions) and all heap allocations (operator new).
+//
+// With --baseline, the p50 CPU time and the counts are compared against the
+// file and the exit code is 1 on a regression; --update writes the file
+// instead. CPU time is machine dependent: keep one baseline per machine.
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "imgui_rangeslider.h"
+#include "imgui_searchablecombo.h"
+#include "imguivariouscontrols.h"
+#include "MatchAdminHotkeys.h"
+
+static size_t g_heapAllocs = 0;
+
+void* operator new(size_t size)
+{
+	++g_heapAllocs;
+	if (void* p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static size_t g_imguiAllocs = 0;
+static size_t g_imguiLive = 0;
+
+static void* CountingAlloc(size_t size, void*)
+{
+	++g_imguiAllocs;
+	++g_imguiLive;
+	return std::malloc(size);
+}
+
+static void CountingFree(void* p, void*)
+{
+	if (p) --g_imguiLive;
+	std::free(p);
+}
+
+static double ThreadCpuUs()
+{
+	timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct FrameSample
+{
+	double cpuUs = 0;
+	int vtx = 0;
+	int idx = 0;
+	size_t imguiAllocs = 0;
+	size_t heapAllocs = 0;
+};
+
+// Same shape as a real event day: ids, two teams, best-of, optional map.
+static void WriteSchedule(const std::filesystem::path& file, int rows)
+{
+	static const char* syllables[] = { "ka", "ro", "vi", "ne", "tor", "ax", "lu", "men", "zo", "qui", "dra", "fel" };
+	static const char* maps[] = { "DFH Stadium", "Mannfield", "Champions Field", "Urban Central", "" };
+	std::vector<std::string> teams;
+	for (int i = 0; i < std::max(2, rows / 4); ++i)
+	{
+		std::string t = syllables[i % 12];
+		t += syllables[(i / 12) % 12];
+		t[0] = static_cast<char>(t[0] - 32);
+		teams.push_back(t + " " + std::to_string(i));
+	}
+	std::ofstream out(file, std::ios::trunc);
+	out << "id,team a,team b,best of,map\n";
+	for (int r = 0; r < rows; ++r)
+	{
+		const size_t a = (r * 7) % teams.size(), b = (r * 13 + 1) % teams.size();
+		out << "M" << r + 1 << "," << teams[a] << "," << teams[b == a ? (b + 1) % teams.size() : b] << ","
+			<< (r % 3 == 0 ? 5 : 3) << "," << maps[r % 5] << "\n";
+	}
+}
+
+static void WriteScenarios(const std::filesystem::path& file)
+{
+	std::ofstream out(file, std::ios::trunc);
+	out << "# generated by mah_ui_bench\n";
+	for (int i = 0; i < 12; ++i)
+		out << "preset_" << i << ": blue " << i % 4 << "; orange " << (i + 1) % 3 << "; clock " << i % 5 << ":30; kickoff\n";
+	out << "overtime_start: blue 2; orange 2; clock 0:00; overtime; kickoff\n";
+}
+
+// Stands in for the widgets the plugin may pick up from IMGUI/ next.
+struct WidgetState
+{
+	float rangeLo = 20.f, rangeHi = 80.f;
+	int intLo = 1, intHi = 7;
+	float events[6][2] = { { 0, 30 }, { 20, 90 }, { 60, 120 }, { 100, 200 }, { 150, 260 }, { 240, 300 } };
+	bool check = true;
+	int combo = 3;
+	SearchableComboIndex index;
+	std::vector<float> series[3];
+};
+
+static float CurveValue(void*, float x, int curve)
+{
+	return std::sin(x * 0.05f + curve) * (1.f + 0.3f * curve);
+}
+
+static float SeriesValue(const void* data, int idx)
+{
+	return static_cast<const float*>(data)[idx];
+}
+
+static void RenderCustomWidgets(WidgetState& w, int frame)
+{
+	ImGui::SetNextWindowPos(ImVec2(980, 20), ImGuiCond_Always);
+	ImGui::SetNextWindowSize(ImVec2(900, 1000), ImGuiCond_Always);
+	ImGui::Begin("Custom widgets");
+	ImGui::RangeSliderFloat("Range", &w.rangeLo, &w.rangeHi, 0.f, 100.f, "(%.1f, %.1f)");
+	ImGui::RangeSliderInt("Games", &w.intLo, &w.intHi, 1, 9);
+	ImGui::CheckButton("Check", &w.check);
+	ImGui::IndexedSearchableCombo("Team", &w.combo, w.index, "Pick a team", "Search");
+	ImGui::ProgressBar("Series", static_cast<float>(frame % 100), 0.f, 100.f);
+	// The imguivariouscontrols timeline; imgui_timeline.h has a simpler one with the same names.
+	if (ImGui::BeginTimeline("Timeline", 300.f, 6, 6, nullptr))
+	{
+		char label[16];
+		for (int i = 0; i < 6; ++i)
+		{
+			std::snprintf(label, sizeof(label), "Event %d", i);
+			ImGui::TimelineEvent(label, w.events[i], false);
+		}
+	}
+	ImGui::EndTimeline(5, static_cast<float>(frame % 300));
+	ImGui::BeginChild("Plots", ImVec2(0, 0));
+	ImGui::PlotCurve("Curves", CurveValue, nullptr, 3, "sin", ImVec2(-1.5f, 1.5f), ImVec2(0.f, 200.f), ImVec2(0, 150));
+	const char* names[] = { "Blue", "Orange", "Total" };
+	const ImColor colors[] = { ImColor(80, 140, 255), ImColor(255, 150, 60), ImColor(200, 200, 200) };
+	const void* datas[] = { w.series[0].data(), w.series[1].data(), w.series[2].data() };
+	ImGui::PlotMultiLines("Goals", 3, names, colors, SeriesValue, datas, static_cast<int>(w.series[0].size()), 0.f, 12.f, ImVec2(0, 150));
+	ImGui::EndChild();
+	ImGui::End();
+}
+
+static double Percentile(std::vector<double> v, double p)
+{
+	if (v.empty()) return 0;
+	std::sort(v.begin(), v.end());
+	return v[static_cast<size_t>(p * (v.size() - 1) + 0.5)];
+}
+
+static std::map<std::string, double> ReadBaseline(const std::string& path)
+{
+	std::map<std::string, double> values;
+	std::ifstream in(path);
+	std::string key;
+	double value;
+	while (in >> key >> value) values[key] = value;
+	return values;
+}
+
+int main(int argc, char** argv)
+{
+	int frames = 600, warmup = 60, rows = 2000;
+	double timeTolerance = 25.0;
+	std::string baseline;
+	bool update = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string a = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (a == "--frames" && hasValue) frames = std::max(1, std::atoi(argv[++i]));
+		else if (a == "--warmup" && hasValue) warmup = std::max(0, std::atoi(argv[++i]));
+		else if (a == "--rows" && hasValue) rows = std::max(1, std::atoi(argv[++i]));
+		else if (a == "--baseline" && hasValue) baseline = argv[++i];
+		else if (a == "--time-tolerance" && hasValue) timeTolerance = std::atof(argv[++i]);
+		else if (a == "--update") update = true;
+		else { std::fprintf(stderr, "unknown or incomplete argument: %s\n", argv[i]); return 2; }
+	}
+
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "mah_ui_bench";
+	std::filesystem::create_directories(root / "data" / "matchadminhotkeys");
+	std::filesystem::create_directories(root / "cfg");
+	WriteSchedule(root / "data" / "matchadminhotkeys" / "schedule.csv", rows);
+	WriteScenarios(root / "data" / "matchadminhotkeys" / "scenarios.txt");
+
+	ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+	ImGuiContext* ctx = ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(1920, 1080);
+	io.IniFilename = nullptr;
+	io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
+	unsigned char* pixels;
+	int texW, texH;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &texW, &texH);
+
+	auto plugin = std::make_unique<MatchAdminHotkeys>();
+	BakkesMod::Plugin::BakkesModPlugin* asPlugin = plugin.get();
+	BakkesMod::Plugin::PluginSettingsWindow* asSettings = plugin.get();
+	BakkesMod::Plugin::PluginWindow* asWindow = plugin.get();
+	asPlugin->cvarManager = std::make_shared<CVarManagerWrapper>();
+	asPlugin->gameWrapper = std::make_shared<GameWrapper>(root);
+	asPlugin->onLoad();
+	// onLoad installs the plugin's own ImGui allocator counters (mah_imgui_mem); the bench keeps counting itself.
+	ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+	asSettings->SetImGuiContext(reinterpret_cast<uintptr_t>(ctx));
+	asWindow->SetImGuiContext(reinterpret_cast<uintptr_t>(ctx));
+	plugin->isWindowOpen_ = true;
+
+	WidgetState widgets;
+	std::vector<std::string> teamNames;
+	for (int i = 0; i < 500; ++i) teamNames.push_back("Team " + std::to_string(i));
+	widgets.index.SetItems(teamNames);
+	for (int i = 0; i < 120; ++i)
+	{
+		widgets.series[0].push_back(static_cast<float>(i % 7));
+		widgets.series[1].push_back(static_cast<float>((i * 3) % 5));
+		widgets.series[2].push_back(widgets.series[0].back() + widgets.series[1].back());
+	}
+
+	std::vector<FrameSample> samples;
+	samples.reserve(frames);
+	for (int f = 0; f < warmup + frames; ++f)
+	{
+		const size_t imguiBefore = g_imguiAllocs, heapBefore = g_heapAllocs;
+		const double t0 = ThreadCpuUs();
+		io.DeltaTime = 1.f / 60.f;
+		ImGui::NewFrame();
+
+		// BakkesMod hosts RenderSettings inside its own settings window.
+		ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2(940, 1040), ImGuiCond_Always);
+		ImGui::Begin("MatchAdminHotkeys settings");
+		if (f == 0)
+		{
+			ImGui::GetStateStorage()->SetInt(ImGui::GetID("Match schedule"), 1);
+			ImGui::GetStateStorage()->SetInt(ImGui::GetID("Scenarios"), 1);
+		}
+		asSettings->RenderSettings();
+		ImGui::End();
+
+		asWindow->Render();
+		RenderCustomWidgets(widgets, f);
+
+		ImGui::Render();
+		const double cpu = ThreadCpuUs() - t0;
+		if (f < warmup) continue;
+		const ImDrawData* dd = ImGui::GetDrawData();
+		samples.push_back({ cpu, dd->TotalVtxCount, dd->TotalIdxCount, g_imguiAllocs - imguiBefore, g_heapAllocs - heapBefore });
+	}
+
+	asPlugin->onUnload();
+	ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree);
+	plugin.reset();
+	ImGui::DestroyContext(ctx);
+
+	std::vector<double> cpu;
+	double cpuSum = 0, vtxSum = 0, idxSum = 0, imguiSum = 0, heapSum = 0;
+	int vtxMax = 0, idxMax = 0;
+	size_t imguiMax = 0, heapMax = 0;
+	for (const FrameSample& s : samples)
+	{
+		cpu.push_back(s.cpuUs);
+		cpuSum += s.cpuUs;
+		vtxSum += s.vtx;
+		idxSum += s.idx;
+		imguiSum += static_cast<double>(s.imguiAllocs);
+		heapSum += static_cast<double>(s.heapAllocs);
+		vtxMax = std::max(vtxMax, s.vtx);
+		idxMax = std::max(idxMax, s.idx);
+		imguiMax = std::max(imguiMax, s.imguiAllocs);
+		heapMax = std::max(heapMax, s.heapAllocs);
+	}
+	const double n = static_cast<double>(samples.size());
+	std::map<std::string, double> result = {
+		{ "cpu_us_p50", Percentile(cpu, 0.50) },
+		{ "vtx_max", static_cast<double>(vtxMax) },
+		{ "idx_max", static_cast<double>(idxMax) },
+		{ "imgui_allocs_per_frame", imguiSum / n },
+		{ "heap_allocs_per_frame", heapSum / n },
+	};
+
+	std::printf("%d frames after %d warm-up, schedule of %d rows, font atlas %dx%d\n", frames, warmup, rows, texW, texH);
+	std::printf("  cpu/frame        mean %8.1f us  p50 %8.1f  p95 %8.1f  max %8.1f\n",
+		cpuSum / n, Percentile(cpu, 0.50), Percentile(cpu, 0.95), Percentile(cpu, 1.0));
+	std::printf("  vertices         mean %8.0f     max %8d\n", vtxSum / n, vtxMax);
+	std::printf("  indices          mean %8.0f     max %8d\n", idxSum / n, idxMax);
+	std::printf("  imgui allocs     mean %8.2f     max %8zu  (live after shutdown %zu)\n", imguiSum / n, imguiMax, g_imguiLive);
+	std::printf("  heap allocs      mean %8.2f     max %8zu\n", heapSum / n, heapMax);
+
+	if (baseline.empty()) return 0;
+	if (update)
+	{
+		std::ofstream out(baseline, std::ios::trunc);
+		for (const auto& [key, value] : result) out << key << " " << value << "\n";
+		std::printf("baseline written to %s\n", baseline.c_str());
+		return out ? 0 : 2;
+	}
+
+	const std::map<std::string, double> base = ReadBaseline(baseline);
+	if (base.empty()) { std::fprintf(stderr, "could not read baseline %s\n", baseline.c_str()); return 2; }
+	int regressions = 0;
+	for (const auto& [key, value] : result)
+	{
+		auto it = base.find(key);
+		if (it == base.end()) continue;
+		// Time is noisy; geometry and allocation counts are deterministic and only get a small margin.
+		const bool isTime = key.rfind("cpu_", 0) == 0;
+		const double limit = isTime ? it->second * (1.0 + timeTolerance / 100.0) : it->second * 1.10 + 1.0;
+		const bool bad = value > limit;
+		regressions += bad;
+		std::printf("  %-24s %12.2f  baseline %12.2f  limit %12.2f  %s\n", key.c_str(), value, it->second, limit, bad ? "REGRESSION" : "ok");
+	}
+	return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,3 @@
+#pragma once
+// Stand-in for the plugin's precompiled header so tools can build plugin and
+// IMGUI sources on their own (put this directory first on the include path).
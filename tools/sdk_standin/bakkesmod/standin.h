@@ -0,0 +1,226 @@
+#pragma once
+// Minimal in-process stand-in for the BakkesMod SDK, enough to construct the
+// plugin and drive its ImGui code on Linux (tools/mah_ui_bench). Cvars and
+// notifiers are real (stored, callbacks fire); there is never a game, so
+// every wrapper is null and console commands are only counted.
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define PERMISSION_ALL 0
+#define PLUGINTYPE_FREEPLAY 1
+#define BAKKESMOD_PLUGIN(cls, name, ver, type)
+#ifndef stringify
+#define stringify(a) stringify_(a)
+#define stringify_(a) #a
+#endif
+
+struct Vector2 { int X = 0, Y = 0; };
+struct Vector2F { float X = 0, Y = 0; };
+struct LinearColor { float R = 0, G = 0, B = 0, A = 0; };
+
+class CVarWrapper
+{
+public:
+	struct State
+	{
+		std::string value;
+		std::vector<std::function<void(std::string, CVarWrapper)>> callbacks;
+	};
+
+	CVarWrapper() = default;
+	explicit CVarWrapper(std::shared_ptr<State> s) : s_(std::move(s)) {}
+
+	bool IsNull() const { return !s_; }
+	explicit operator bool() const { return s_ != nullptr; }
+	std::string getStringValue() const { return s_ ? s_->value : std::string(); }
+	int getIntValue() const { return s_ ? std::atoi(s_->value.c_str()) : 0; }
+	float getFloatValue() const { return s_ ? static_cast<float>(std::atof(s_->value.c_str())) : 0.f; }
+	bool getBoolValue() const { return getFloatValue() != 0.f; }
+
+	void setValue(std::string v)
+	{
+		if (!s_ || s_->value == v) return;
+		std::string old = s_->value;
+		s_->value = std::move(v);
+		for (auto& cb : s_->callbacks) cb(old, *this);
+	}
+	void setValue(int v) { setValue(std::to_string(v)); }
+	void setValue(float v) { setValue(std::to_string(v)); }
+	void setValue(bool v) { setValue(std::string(v ? "1" : "0")); }
+	void addOnValueChanged(std::function<void(std::string, CVarWrapper)> cb) { if (s_) s_->callbacks.push_back(std::move(cb)); }
+
+private:
+	std::shared_ptr<State> s_;
+};
+
+class CVarManagerWrapper
+{
+public:
+	CVarWrapper registerCvar(std::string name, std::string defaultValue, std::string = "", bool = true, bool = false, float = 0, bool = false, float = 0, bool = true)
+	{
+		auto& s = cvars_[name];
+		if (!s)
+		{
+			s = std::make_shared<CVarWrapper::State>();
+			s->value = std::move(defaultValue);
+		}
+		return CVarWrapper(s);
+	}
+	CVarWrapper getCvar(const std::string& name)
+	{
+		auto it = cvars_.find(name);
+		return it == cvars_.end() ? CVarWrapper() : CVarWrapper(it->second);
+	}
+	void registerNotifier(std::string name, std::function<void(std::vector<std::string>)> fn, std::string, unsigned char) { notifiers_[name] = std::move(fn); }
+	void removeNotifier(std::string name) { notifiers_.erase(name); }
+	void removeCvar(std::string name) { cvars_.erase(name); }
+	void executeCommand(std::string, bool = true) { ++commands; }
+	void log(std::string) { ++logs; }
+	void log(std::wstring) { ++logs; }
+
+	uint64_t commands = 0;
+	uint64_t logs = 0;
+
+private:
+	std::map<std::string, std::shared_ptr<CVarWrapper::State>> cvars_;
+	std::map<std::string, std::function<void(std::vector<std::string>)>> notifiers_;
+};
+
+// Every game object is null: the bench measures the UI with no match running.
+class ObjectWrapper
+{
+public:
+	ObjectWrapper() = default;
+	explicit ObjectWrapper(std::uintptr_t mem) : memory_address(mem) {}
+	bool IsNull() const { return memory_address == 0; }
+	explicit operator bool() const { return memory_address != 0; }
+	std::uintptr_t memory_address = 0;
+};
+
+template<class T>
+class ArrayWrapper
+{
+public:
+	bool IsNull() const { return true; }
+	int Count() const { return 0; }
+	T Get(int) const { return T(0); }
+};
+
+class PlayerControllerWrapper : public ObjectWrapper
+{
+public:
+	using ObjectWrapper::ObjectWrapper;
+};
+
+class TeamWrapper : public ObjectWrapper
+{
+public:
+	using ObjectWrapper::ObjectWrapper;
+	int GetScore() { return 0; }
+	void SetScore(int) {}
+	int GetTeamNum2() { return 0; }
+	std::wstring GetCustomTeamName() { return {}; }
+};
+
+class ServerWrapper : public ObjectWrapper
+{
+public:
+	using ObjectWrapper::ObjectWrapper;
+	ArrayWrapper<TeamWrapper> GetTeams() { return {}; }
+	ArrayWrapper<PlayerControllerWrapper> GetLocalPlayers() { return {}; }
+	PlayerControllerWrapper GetPauser() { return PlayerControllerWrapper(0); }
+	void SetPaused(PlayerControllerWrapper, unsigned long) {}
+	void StartNewRound() {}
+	unsigned long GetbOverTime() { return 0; }
+	void SetbOverTime(unsigned long) {}
+	int GetSecondsRemaining() { return 0; }
+	void SetSecondsRemaining(int) {}
+	int GetGameTimeRemaining() { return 0; }
+	void SetGameTimeRemaining(float) {}
+	float GetGameTime() { return 0; }
+	unsigned long GetbUnlimitedTime() { return 0; }
+	void SetbUnlimitedTime(unsigned long) {}
+};
+
+class CanvasWrapper
+{
+public:
+	Vector2 GetSize() { return { 1920, 1080 }; }
+	void SetColor(char, char, char, char) {}
+	void SetColor(LinearColor) {}
+	void SetPosition(Vector2) {}
+	void SetPosition(Vector2F) {}
+	void DrawString(std::string) {}
+	void DrawString(std::string, float, float, bool = false, bool = false) {}
+	Vector2F GetStringSize(std::string, float = 1, float = 1) { return {}; }
+	void FillBox(Vector2) {}
+	void DrawBox(Vector2) {}
+};
+
+class GameWrapper
+{
+public:
+	explicit GameWrapper(std::filesystem::path root) : root_(std::move(root)) {}
+
+	bool IsInGame() { return false; }
+	bool IsInOnlineGame() { return false; }
+	ServerWrapper GetCurrentGameState() { return ServerWrapper(0); }
+	ServerWrapper GetGameEventAsServer() { return ServerWrapper(0); }
+	PlayerControllerWrapper GetPlayerController() { return PlayerControllerWrapper(0); }
+	std::filesystem::path GetBakkesModPath() { return root_; }
+	std::filesystem::path GetDataFolder() { return root_ / "data"; }
+	void Toast(std::string, std::string, std::string = "default", float = 3.5f, unsigned char = 0, float = 290, float = 60) {}
+	void SetTimeout(std::function<void(GameWrapper*)>, float) {}
+	void Execute(std::function<void(GameWrapper*)> fn) { fn(this); }
+	void HookEvent(std::string, std::function<void(std::string)>) {}
+	void HookEventPost(std::string, std::function<void(std::string)>) {}
+	void UnhookEvent(std::string) {}
+	void UnhookEventPost(std::string) {}
+	void RegisterDrawable(std::function<void(CanvasWrapper)>) {}
+	void UnregisterDrawables() {}
+
+private:
+	std::filesystem::path root_;
+};
+
+namespace BakkesMod::Plugin
+{
+	class BakkesModPlugin
+	{
+	public:
+		virtual ~BakkesModPlugin() = default;
+		virtual void onLoad() {}
+		virtual void onUnload() {}
+		std::shared_ptr<CVarManagerWrapper> cvarManager;
+		std::shared_ptr<GameWrapper> gameWrapper;
+	};
+
+	class PluginSettingsWindow
+	{
+	public:
+		virtual ~PluginSettingsWindow() = default;
+		virtual void RenderSettings() = 0;
+		virtual std::string GetPluginName() = 0;
+		virtual void SetImGuiContext(uintptr_t ctx) = 0;
+	};
+
+	class PluginWindow
+	{
+	public:
+		virtual ~PluginWindow() = default;
+		virtual void Render() = 0;
+		virtual std::string GetMenuName() = 0;
+		virtual std::string GetMenuTitle() = 0;
+		virtual void SetImGuiContext(uintptr_t ctx) = 0;
+		virtual bool ShouldBlockInput() = 0;
+		virtual bool IsActiveOverlay() = 0;
+		virtual void OnOpen() = 0;
+		virtual void OnClose() = 0;
+	};
+}
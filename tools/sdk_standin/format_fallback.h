@@ -0,0 +1,127 @@
+#pragma once
+// Subset of C++20 <format> for building plugin sources in tools/ against a
+// standard library that lacks it (GCC 12's libstdc++). logging.h includes it
+// only when <format> is missing, so the plugin build never sees it.
+//
+// Covers what the plugin uses: "{}", "{:.Nf}" and the "{{" / "}}" escapes,
+// for narrow and wide strings. Values are written with operator<<, except
+// bool ("true"/"false") and 8-bit integers (as numbers), as std::format does.
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace mah_format
+{
+	template <typename C>
+	struct Arg
+	{
+		const void* value;
+		void (*put)(std::basic_ostream<C>&, const void*);
+	};
+
+	template <typename C>
+	struct Args
+	{
+		const Arg<C>* data;
+		size_t size;
+	};
+
+	template <typename C, size_t N>
+	struct ArgStore
+	{
+		Arg<C> args[N ? N : 1];
+		operator Args<C>() const { return { args, N }; }
+	};
+
+	template <typename C, typename T>
+	void Put(std::basic_ostream<C>& out, const void* p)
+	{
+		const T& v = *static_cast<const T*>(p);
+		if constexpr (std::is_same_v<T, bool>)
+			out << (v ? "true" : "false");
+		else if constexpr (std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+			out << static_cast<int>(v);
+		else if constexpr (std::is_same_v<C, wchar_t> && std::is_convertible_v<const T&, std::string_view>)
+		{
+			const std::string_view s = v;
+			out << std::wstring(s.begin(), s.end());
+		}
+		else
+			out << v;
+	}
+
+	template <typename C>
+	std::basic_string<C> Format(std::basic_string_view<C> fmt, Args<C> args)
+	{
+		std::basic_ostringstream<C> out;
+		size_t next = 0;
+		for (size_t i = 0; i < fmt.size(); ++i)
+		{
+			const C c = fmt[i];
+			if ((c == C('{') || c == C('}')) && i + 1 < fmt.size() && fmt[i + 1] == c)
+			{
+				out << c;
+				++i;
+				continue;
+			}
+			if (c != C('{'))
+			{
+				out << c;
+				continue;
+			}
+			const size_t close = fmt.find(C('}'), i);
+			if (close == fmt.npos) break;
+			const std::basic_string_view<C> spec = fmt.substr(i + 1, close - i - 1);
+			const auto flags = out.flags();
+			const auto precision = out.precision();
+			if (spec.size() >= 3 && spec[0] == C(':') && spec[1] == C('.'))
+			{
+				int digits = 0;
+				for (size_t d = 2; d < spec.size() && spec[d] >= C('0') && spec[d] <= C('9'); ++d)
+					digits = digits * 10 + static_cast<int>(spec[d] - C('0'));
+				out << std::fixed << std::setprecision(digits);
+			}
+			if (next < args.size)
+			{
+				args.data[next].put(out, args.data[next].value);
+				++next;
+			}
+			out.flags(flags);
+			out.precision(precision);
+			i = close;
+		}
+		return out.str();
+	}
+
+	template <typename... A>
+	ArgStore<char, sizeof...(A)> make_format_args(A&... a)
+	{
+		return { { Arg<char>{ &a, &Put<char, std::remove_cv_t<A>> }... } };
+	}
+
+	template <typename... A>
+	ArgStore<wchar_t, sizeof...(A)> make_wformat_args(A&... a)
+	{
+		return { { Arg<wchar_t>{ &a, &Put<wchar_t, std::remove_cv_t<A>> }... } };
+	}
+
+	inline std::string vformat(std::string_view fmt, Args<char> args) { return Format<char>(fmt, args); }
+	inline std::wstring vformat(std::wstring_view fmt, Args<wchar_t> args) { return Format<wchar_t>(fmt, args); }
+
+	template <typename... A>
+	std::string format(std::string_view fmt, A&&... a) { return vformat(fmt, make_format_args(a...)); }
+
+	template <typename... A>
+	std::wstring format(std::wstring_view fmt, A&&... a) { return vformat(fmt, make_wformat_args(a...)); }
+}
+
+namespace std
+{
+	using mah_format::format;
+	using mah_format::make_format_args;
+	using mah_format::make_wformat_args;
+	using mah_format::vformat;
+}
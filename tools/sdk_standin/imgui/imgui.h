@@ -0,0 +1,3 @@
+#pragma once
+// MatchAdminHotkeys.cpp includes "imgui/imgui.h"; the directory is IMGUI on case-sensitive file systems.
+#include "../../../IMGUI/imgui.h"